@@ -17,6 +17,7 @@
 #ifndef IGNITION_GUI_APPLICATION_HH_
 #define IGNITION_GUI_APPLICATION_HH_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -34,6 +35,7 @@
 
 namespace tinyxml2
 {
+  class XMLDocument;
   class XMLElement;
 }
 
@@ -54,7 +56,23 @@ namespace ignition
       kMainWindow = 0,
 
       /// \brief One independent dialog per plugin
-      kDialog = 1
+      kDialog = 1,
+
+      /// \brief A main window which isn't displayed, for benchmarks and
+      /// continuous integration on machines without a display or GPU.
+      ///
+      /// Unless they're already set, this sets these environment variables
+      /// before Qt is initialized:
+      /// * QT_QPA_PLATFORM=offscreen, so no display is needed.
+      /// * LIBGL_ALWAYS_SOFTWARE=1, so Mesa's llvmpipe renders OpenGL for
+      ///   the render plugins without a GPU.
+      /// * QSG_RENDER_LOOP=basic, so frames are rendered on the GUI thread
+      ///   and can be driven with Application::RenderFrame.
+      /// * QT_QUICK_BACKEND=software, only if there's no X display. The
+      ///   offscreen platform can only create OpenGL contexts through an X
+      ///   server, so in that case QML is rasterized without OpenGL, and
+      ///   render plugins need a virtual X server such as Xvfb.
+      kHeadless = 2
     };
 
     /// \brief An Ignition GUI application loads a QML engine and
@@ -79,6 +97,24 @@ namespace ignition
       /// \return Pointer to QML engine
       public: QQmlApplicationEngine *Engine() const;
 
+      /// \brief Get the component for a QML file. Components are compiled
+      /// once and cached by the application, so plugins with many instances,
+      /// or which are loaded again by a new config, don't compile their QML
+      /// again.
+      ///
+      /// Components are compiled asynchronously by the QML engine.
+      /// \param[in] _file QML file, such as ":/Publisher/Publisher.qml".
+      /// \param[in] _wait True to block until the component is loaded,
+      /// without processing events. A component which is still loading is
+      /// replaced by one compiled synchronously, so don't keep components
+      /// returned while loading. Otherwise, this returns right away, which
+      /// can be used to start compiling components which will be needed
+      /// later.
+      /// \return The component, which may have errors. Null if _file is
+      /// empty.
+      public: QQmlComponent *QmlComponent(const std::string &_file,
+          bool _wait = true);
+
       /// \brief Load a plugin from a file name. The plugin file must be in the
       /// path.
       /// If a window has been initialized, the plugin is added to the window.
@@ -96,12 +132,35 @@ namespace ignition
       /// and plugins. This function doesn't instantiate the plugins, it just
       /// keeps them in memory and they can be applied later by either
       /// instantiating a window or several dialogs.
+      ///
+      /// If the main window already has plugins, those loaded with the same
+      /// filename and configuration as a plugin in the new config are kept,
+      /// and the others are removed. All cards are then laid out in config
+      /// order.
       /// \param[in] _path Full path to configuration file.
       /// \return True if successful
       /// \sa InitializeMainWindow
       /// \sa InitializeDialogs
       public: bool LoadConfig(const std::string &_path);
 
+      /// \brief Load a configuration file like LoadConfig, but read and
+      /// parse it on a worker thread, so the GUI thread isn't blocked by
+      /// file I/O. The configuration is applied on this application's
+      /// thread, one plugin each time events are processed, so cards appear
+      /// progressively. ConfigLoaded is emitted once it's fully applied.
+      /// Configurations requested while another one is being loaded are
+      /// applied after it, in order.
+      /// \param[in] _path Full path to configuration file.
+      /// \sa LoadConfig
+      /// \sa ConfigLoaded
+      /// \sa LoadingConfig
+      public: void LoadConfigAsync(const std::string &_path);
+
+      /// \brief Get whether a configuration requested with LoadConfigAsync
+      /// is being applied. LoadConfig fails meanwhile.
+      /// \return True if a configuration is being applied.
+      public: bool LoadingConfig() const;
+
       /// \brief Load the configuration from the default config file.
       /// \return True if successful
       /// \sa SetDefaultConfigPath
@@ -141,15 +200,26 @@ namespace ignition
       /// 3. Path ~/.ignition/gui/plugins
       /// 4. The path where Ignition GUI plugins are installed
       ///
+      /// Directories are only scanned again when they change, so this is
+      /// cheap to call repeatedly.
+      ///
       /// \return A vector of pairs, where each pair contains:
       /// * A path
       /// * A vector of plugins in that path
       public: std::vector<std::pair<std::string, std::vector<std::string>>>
           PluginList();
 
+      /// \brief Get the display names of the available plugins, such as
+      /// "World Stats" for "libWorldStats.so". Plugins which are also found
+      /// on earlier paths are only listed once.
+      /// \return Display names, in the order given by PluginList.
+      /// \sa PluginList
+      public: std::vector<std::string> PluginDisplayNames();
+
       /// \brief Remove plugin by name. The plugin is removed from the
-      /// application and its shared library unloaded if this was its last
-      /// instance.
+      /// application. Its shared library stays loaded, because its QML
+      /// component is cached.
+      /// \sa QmlComponent
       /// \param[in] _pluginName Plugn instance's unique name. This is the
       /// plugin card's object name.
       /// \return True if successful
@@ -162,10 +232,39 @@ namespace ignition
       public: std::shared_ptr<Plugin> PluginByName(
           const std::string &_pluginName) const;
 
+      /// \brief Get whether the application was created with
+      /// WindowType::kHeadless.
+      /// \return True if headless.
+      public: bool Headless() const;
+
+      /// \brief Process pending events, then render one frame of the main
+      /// window and block until it's done. This drives frames
+      /// deterministically, so that performance tests measure the same work
+      /// on every run regardless of vsync or timers. It's meant for
+      /// headless applications, but works with any main window.
+      /// \param[in] _timeout Maximum time to wait for the frame, in
+      /// milliseconds.
+      /// \return True if a frame was rendered. False if there's no main
+      /// window, or if it isn't exposed and can't render.
+      /// \sa FrameCount
+      public: bool RenderFrame(int _timeout = 1000);
+
+      /// \brief Get the number of frames rendered by the main window since
+      /// it was created, whether they were driven by RenderFrame or by the
+      /// render loop.
+      /// \return Frame count.
+      public: uint64_t FrameCount() const;
+
       /// \brief Notify that a plugin has been added.
       /// \param[in] _objectName Plugin's object name.
       signals: void PluginAdded(const QString &_objectName);
 
+      /// \brief Notify that a configuration requested with LoadConfigAsync
+      /// has been applied.
+      /// \param[in] _path Path to the configuration file.
+      /// \param[in] _success True if the configuration was loaded.
+      signals: void ConfigLoaded(const QString &_path, bool _success);
+
       /// \brief Callback when user requests to close a plugin
       public slots: void OnPluginClose();
 
@@ -199,6 +298,36 @@ namespace ignition
       /// initialized.
       private: bool ApplyConfig();
 
+      /// \brief Start loading a parsed configuration file. Plugins which
+      /// aren't in the new configuration are removed right away.
+      /// \param[in] _path Path to the configuration file.
+      /// \param[in] _doc Parsed file, which may have failed to load. It's
+      /// kept until the configuration is loaded.
+      /// \param[in] _progressive True to load one plugin each time events
+      /// are processed, then emit ConfigLoaded. False to load all plugins
+      /// before returning.
+      /// \return True if successful, or if the progressive load started.
+      /// \sa LoadConfig
+      /// \sa LoadConfigAsync
+      private: bool LoadConfigDocument(const std::string &_path,
+          std::shared_ptr<const tinyxml2::XMLDocument> _doc,
+          const bool _progressive);
+
+      /// \brief Load the next plugin of the configuration being loaded, or
+      /// apply its window properties once all plugins are loaded.
+      /// \param[out] _success Set once the configuration is loaded, to true
+      /// if successful.
+      /// \return True if there's more to load.
+      private: bool LoadConfigStep(bool &_success);
+
+      /// \brief Take one step of a progressive load, and queue the next one
+      /// or emit ConfigLoaded.
+      private: void ContinueConfigLoad();
+
+      /// \brief Start loading the configurations read by LoadConfigAsync,
+      /// unless one is being loaded.
+      private: void LoadPendingConfigs();
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<ApplicationPrivate> dataPtr;
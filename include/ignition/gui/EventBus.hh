@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_EVENTBUS_HH_
+#define IGNITION_GUI_EVENTBUS_HH_
+
+#include <cstdint>
+#include <functional>
+
+#include "ignition/gui/qt.h"
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+  namespace gui
+  {
+    /// \brief How events are delivered to a subscriber.
+    enum class EventDelivery : int
+    {
+      /// \brief Synchronously, from the thread which publishes the event.
+      /// Scene events are published from the render thread, so it's safe to
+      /// make rendering calls from these subscribers.
+      kDirect = 0,
+
+      /// \brief Queued to the thread of the subscription's context object,
+      /// which is the GUI thread for plugins.
+      kQueued = 1,
+
+      /// \brief Queued to the event bus's worker thread, for handlers which
+      /// shouldn't block the publisher nor the GUI thread.
+      kWorker = 2
+    };
+
+    /// \brief Unique ID of an event subscription, 0 is never used.
+    using EventSubscriptionId = uint64_t;
+
+    /// \internal
+    /// \brief Subscribe to an event type. Use the typed overload instead.
+    /// \param[in] _type Event type.
+    /// \param[in] _callback Function to call with each event.
+    /// \param[in] _copy Function which copies an event of this type, used
+    /// to queue events.
+    /// \param[in] _delivery How events are delivered.
+    /// \param[in] _coalesce True to only deliver the latest event.
+    /// \param[in] _context Object which receives queued events.
+    /// \return ID used to unsubscribe.
+    IGNITION_GUI_VISIBLE
+    EventSubscriptionId subscribeEvent(const QEvent::Type _type,
+        std::function<void(const QEvent &)> _callback,
+        std::function<QEvent *(const QEvent &)> _copy,
+        const EventDelivery _delivery, const bool _coalesce,
+        QObject *_context);
+
+    /// \brief Subscribe to events of type T, such as
+    /// events::HoverOnScene, instead of filtering all events sent to the
+    /// main window. Events are delivered to subscribers of their type only,
+    /// so the cost of publishing an event doesn't grow with the number of
+    /// plugins.
+    ///
+    /// Events sent to the main window are published on the bus, so
+    /// existing publishers don't need to change.
+    ///
+    /// This is thread safe.
+    /// \param[in] _callback Function to call with each event.
+    /// \param[in] _delivery How events are delivered.
+    /// \param[in] _coalesce True to only deliver the latest of the events
+    /// published while a delivery is pending, such as the latest hover of a
+    /// frame. Only used with queued and worker delivery.
+    /// \param[in] _context Object which receives queued events. Delivery
+    /// stops once it's destroyed. Defaults to the application.
+    /// \return ID used to unsubscribe, 0 on failure.
+    /// \sa Plugin::SubscribeEvent
+    template <typename T>
+    EventSubscriptionId subscribeEvent(
+        std::function<void(const T &)> _callback,
+        const EventDelivery _delivery = EventDelivery::kDirect,
+        const bool _coalesce = false, QObject *_context = nullptr)
+    {
+      if (!_callback)
+        return subscribeEvent(T::kType, nullptr, nullptr, _delivery,
+            _coalesce, _context);
+
+      return subscribeEvent(T::kType,
+          [_callback](const QEvent &_event)
+          {
+            _callback(static_cast<const T &>(_event));
+          },
+          [](const QEvent &_event) -> QEvent *
+          {
+            return new T(static_cast<const T &>(_event));
+          },
+          _delivery, _coalesce, _context);
+    }
+
+    /// \brief Unsubscribe from events. If the subscriber is being called,
+    /// this blocks until it returns, so it's never called once this returns,
+    /// not even with queued events.
+    /// \param[in] _id ID returned by subscribeEvent.
+    /// \return True if the subscription was found.
+    IGNITION_GUI_VISIBLE
+    bool unsubscribeEvent(const EventSubscriptionId _id);
+
+    /// \brief Deliver an event to the subscribers of its type. The main
+    /// window does this for all events it receives, so prefer sending events
+    /// to it, which also reaches plugins which still filter its events.
+    /// \param[in] _event Event to deliver. It's only copied if there are
+    /// queued or worker subscribers.
+    IGNITION_GUI_VISIBLE
+    void publishEvent(const QEvent &_event);
+  }
+}
+
+#endif
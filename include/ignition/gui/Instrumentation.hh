@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_INSTRUMENTATION_HH_
+#define IGNITION_GUI_INSTRUMENTATION_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <ignition/common/Profiler.hh>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+  namespace gui
+  {
+    class Plugin;
+
+    /// \brief Timing statistics of one of a plugin's handlers, such as a
+    /// transport callback or a render event handler.
+    struct HandlerStats
+    {
+      /// \brief Handler name.
+      std::string name;
+
+      /// \brief Number of calls.
+      uint64_t count{0};
+
+      /// \brief Total time spent in the handler.
+      std::chrono::nanoseconds total{0};
+
+      /// \brief Longest call.
+      std::chrono::nanoseconds max{0};
+    };
+
+    /// \brief Size of one of a plugin's queues of pending work, such as
+    /// messages received from transport which will be processed on the next
+    /// frame.
+    struct QueueStats
+    {
+      /// \brief Queue name.
+      std::string name;
+
+      /// \brief Last recorded number of pending items.
+      size_t depth{0};
+
+      /// \brief Largest recorded number of pending items.
+      size_t maxDepth{0};
+    };
+
+    /// \brief Get whether plugin instrumentation is enabled. It's disabled by
+    /// default, and can be enabled with setInstrumentationEnabled, by
+    /// setting the IGN_GUI_INSTRUMENTATION environment variable before the
+    /// Application is created, or while it's acquired with
+    /// acquireInstrumentation. While disabled, recording costs a single
+    /// relaxed atomic load.
+    /// \return True if enabled.
+    IGNITION_GUI_VISIBLE
+    bool instrumentationEnabled();
+
+    /// \brief Enable or disable plugin instrumentation.
+    /// \param[in] _enabled True to enable.
+    IGNITION_GUI_VISIBLE
+    void setInstrumentationEnabled(const bool _enabled);
+
+    /// \brief Keep plugin instrumentation enabled until a matching call to
+    /// releaseInstrumentation, regardless of setInstrumentationEnabled.
+    /// Calls may be nested, for example by several plugins which display
+    /// statistics.
+    IGNITION_GUI_VISIBLE
+    void acquireInstrumentation();
+
+    /// \brief Release instrumentation acquired with acquireInstrumentation.
+    /// It stays enabled while other users hold it or if it was enabled with
+    /// setInstrumentationEnabled.
+    IGNITION_GUI_VISIBLE
+    void releaseInstrumentation();
+
+    /// \brief Measures the time until the end of its scope and records it
+    /// as a handler of a plugin, see Plugin::RecordHandler. Nothing is
+    /// measured if instrumentation is disabled when it's created.
+    ///
+    /// Prefer the IGN_GUI_PROFILE_HANDLER macro, which also creates an
+    /// IGN_PROFILE scope.
+    class IGNITION_GUI_VISIBLE ScopedHandlerTimer
+    {
+      /// \brief Constructor
+      /// \param[in] _plugin Plugin which owns the handler.
+      /// \param[in] _name Handler name, which must outlive this object,
+      /// typically a string literal.
+      public: ScopedHandlerTimer(Plugin *_plugin, const char *_name);
+
+      /// \brief Destructor, records the elapsed time.
+      public: ~ScopedHandlerTimer();
+
+      /// \brief No copies
+      public: ScopedHandlerTimer(const ScopedHandlerTimer &) = delete;
+
+      /// \brief No copies
+      public: ScopedHandlerTimer &operator=(const ScopedHandlerTimer &) =
+          delete;
+
+      /// \brief Plugin, null if not measuring.
+      private: Plugin *plugin{nullptr};
+
+      /// \brief Handler name.
+      private: const char *name{nullptr};
+
+      /// \brief Time the scope started.
+      private: std::chrono::steady_clock::time_point start;
+    };
+  }
+}
+
+#define IGN_GUI_HANDLER_CONCAT_IMPL(_a, _b) _a##_b
+#define IGN_GUI_HANDLER_CONCAT(_a, _b) IGN_GUI_HANDLER_CONCAT_IMPL(_a, _b)
+
+/// \brief Measure the rest of the current scope as handler _name of
+/// _plugin, and profile it with IGN_PROFILE.
+/// \param[in] _plugin Pointer to the ignition::gui::Plugin.
+/// \param[in] _name Handler name, a string literal.
+#define IGN_GUI_PROFILE_HANDLER(_plugin, _name) \
+  IGN_PROFILE(_name); \
+  ::ignition::gui::ScopedHandlerTimer \
+      IGN_GUI_HANDLER_CONCAT(ignGuiHandlerTimer, __LINE__)(_plugin, _name)
+
+#endif
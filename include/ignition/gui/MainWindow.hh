@@ -17,6 +17,8 @@
 #ifndef IGNITION_GUI_MAINWINDOW_HH_
 #define IGNITION_GUI_MAINWINDOW_HH_
 
+#include <chrono>
+#include <future>
 #include <map>
 #include <memory>
 #include <set>
@@ -197,10 +199,35 @@ namespace ignition
 
       /// \brief Save current window and plugin configuration to a file on disk.
       /// Will open an error dialog in case it's not possible to write to the
-      /// path.
+      /// path. The file is written to a temporary file which then replaces
+      /// it, so it's never left partially written. This blocks until the file
+      /// is written.
       /// \param[in] _path The full destination path including filename.
+      /// \sa SaveConfigAsync
       public: void SaveConfig(const std::string &_path);
 
+      /// \brief Save the configuration like SaveConfig without blocking on
+      /// file I/O. Plugin configurations are collected on the calling thread,
+      /// which must be the GUI thread, then the file is serialized and
+      /// written on a worker thread. Saves are written in the order they're
+      /// requested.
+      /// \param[in] _path The full destination path including filename.
+      /// \return Future which is true once the file was written, or false
+      /// if it couldn't be written.
+      public: std::shared_future<bool> SaveConfigAsync(
+          const std::string &_path);
+
+      /// \brief Periodically save the configuration in the background. A
+      /// hash of the configuration is kept, so the file is only written when
+      /// the configuration changed since it was last saved to that path.
+      /// Autosaves are skipped while a configuration is being loaded. This is
+      /// also set by the \<autosave\> element of a config's \<window\>.
+      /// \param[in] _path The full destination path including filename.
+      /// \param[in] _interval Time between autosaves, zero to disable them.
+      /// \sa SaveConfigAsync
+      public: void SetAutosave(const std::string &_path,
+          const std::chrono::milliseconds _interval);
+
       /// \brief Apply a WindowConfig to this window and keep a copy of it.
       /// \param[in] _config The configuration to apply.
       /// \return True if successful.
@@ -427,6 +454,26 @@ namespace ignition
       /// \brief Displays a message to the user
       signals: void notify(const QString &_message);
 
+      /// \brief Publish GUI events sent to the window on the event bus,
+      /// after plugins which filter the window's events have seen them.
+      /// \param[in] _event Event sent to the window.
+      /// \return True if the event was recognized.
+      /// \sa publishEvent
+      protected: bool event(QEvent *_event) override;
+
+      /// \brief Save the configuration to the autosave path if it changed.
+      /// \sa SetAutosave
+      private: void Autosave();
+
+      /// \brief Serialize and write the window config on a worker thread,
+      /// after previous saves.
+      /// \param[in] _path The full destination path including filename.
+      /// \param[in] _autosave True to skip writing if the config didn't
+      /// change, and to not notify the user.
+      /// \return Future which is true once the file was written.
+      private: std::shared_future<bool> QueueConfigSave(
+          const std::string &_path, const bool _autosave);
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<MainWindowPrivate> dataPtr;
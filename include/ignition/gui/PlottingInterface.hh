@@ -120,7 +120,8 @@ class IGNITION_GUI_VISIBLE Topic : public QObject
   /// \return fields size
   public: int FieldCount() const;
 
-  /// \brief Get the registered fields
+  /// \brief Get the registered fields. Not synchronized with the
+  /// callbacks, so only use it while not subscribed.
   /// \return Map of fields to their plots
   public: std::map<std::string, PlotData *> &Fields();
 
@@ -128,6 +129,15 @@ class IGNITION_GUI_VISIBLE Topic : public QObject
   /// \param[in] _msg the published msg from the topic
   public: void Callback(const google::protobuf::Message &_msg);
 
+  /// \brief Callback to receive serialized messages. Only the registered
+  /// fields and the header stamp are decoded, the rest of the message is
+  /// skipped. Safe to call while fields are registered from another thread.
+  /// \param[in] _data the serialized msg
+  /// \param[in] _size size of the serialized msg
+  /// \param[in] _msgType type of the msg
+  public: void RawCallback(const char *_data, const size_t _size,
+                           const std::string &_msgType);
+
   /// \brief Check if msg has header field and get its time
   /// \param[in] _msg msg to check its header
   /// \param[out] _headerTime header sim time
@@ -244,6 +254,12 @@ class IGNITION_GUI_VISIBLE PlottingInterface : public QObject
   /// \return updating plot timeout
   public: float Timeout() const;
 
+  /// \brief Pause or resume plotting. While paused, points aren't plotted
+  /// and the plotting time isn't updated periodically, but it still advances
+  /// by the time spent paused once resumed.
+  /// \param[in] _paused True to pause, false to resume.
+  public: void SetPaused(bool _paused);
+
   /// \brief slot to get triggered to plot a point and send its data to the UI
   /// \param[in] _chart chart ID
   /// \param[in] _fieldID field path ID
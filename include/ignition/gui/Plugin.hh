@@ -18,11 +18,18 @@
 #define IGNITION_GUI_PLUGIN_HH_
 
 #include <tinyxml2.h>
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "ignition/gui/qt.h"
+#include "ignition/gui/EventBus.hh"
 #include "ignition/gui/Export.hh"
+#include "ignition/gui/Instrumentation.hh"
+#include "ignition/gui/RenderHooks.hh"
 
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
@@ -116,10 +123,130 @@ namespace ignition
       /// \return The value of `delete_later`.
       public: bool DeleteLaterRequested() const;
 
+      /// \brief Get whether the plugin's card is shown, which means it's on a
+      /// window, visible and not collapsed.
+      ///
+      /// Plugins with `<lazy>true</lazy>` in their `<ignition-gui>` config
+      /// only have LoadConfig called once their card is first shown.
+      /// \return True if the card is shown.
+      /// \sa CardShownChanged
+      public: bool CardShown() const;
+
+      /// \brief Notify that the card was shown or hidden.
+      /// \sa CardShown
+      signals: void CardShownChanged();
+
+      /// \brief Get whether the plugin is active, which means its card is
+      /// shown and its window isn't minimized. Plugins start active.
+      /// \return True if active.
+      /// \sa OnActivate
+      /// \sa OnDeactivate
+      public: bool Active() const;
+
+      /// \brief Called when the plugin becomes active again after having
+      /// been deactivated. Override this to resume what was paused on
+      /// OnDeactivate.
+      /// \sa Active
+      protected: virtual void OnActivate()
+          {
+          }
+
+      /// \brief Called when the plugin becomes inactive, because its card
+      /// was hidden or collapsed, or its window was minimized. Override this
+      /// to unsubscribe from topics and stop timers which only update the
+      /// display.
+      ///
+      /// This isn't called for lazy plugins whose config wasn't loaded yet.
+      /// \sa Active
+      protected: virtual void OnDeactivate()
+          {
+          }
+
       /// \brief Wait until the plugin has a parent, then close and delete the
       /// parent.
       protected: void DeleteLater();
 
+      /// \brief Record how long one of this plugin's handlers took, such as
+      /// a transport callback or a render event handler. This does nothing
+      /// unless instrumentation is enabled, see instrumentationEnabled. It's
+      /// thread safe, so it can be called from transport threads.
+      ///
+      /// Handlers are usually measured with IGN_GUI_PROFILE_HANDLER instead
+      /// of calling this directly.
+      /// \param[in] _name Handler name.
+      /// \param[in] _duration Time the handler took.
+      public: void RecordHandler(const char *_name,
+          const std::chrono::steady_clock::duration _duration);
+
+      /// \brief Record the number of items pending in one of this plugin's
+      /// queues, such as messages waiting for the next frame. This does
+      /// nothing unless instrumentation is enabled, and it's thread safe.
+      /// \param[in] _name Queue name.
+      /// \param[in] _depth Number of pending items.
+      public: void RecordQueueDepth(const char *_name, const size_t _depth);
+
+      /// \brief Get the statistics of all handlers recorded since the
+      /// plugin was created or the statistics were reset.
+      /// \return Statistics sorted by handler name.
+      public: std::vector<HandlerStats> HandlerStatistics() const;
+
+      /// \brief Get the statistics of all queues recorded since the
+      /// plugin was created or the statistics were reset.
+      /// \return Statistics sorted by queue name.
+      public: std::vector<QueueStats> QueueStatistics() const;
+
+      /// \brief Clear all handler and queue statistics.
+      public: void ResetStatistics();
+
+      /// \brief Remove all render hooks and event subscriptions added by
+      /// this plugin, blocking until running ones return. Hooks usually call
+      /// into derived classes, which are already destroyed by the time
+      /// ~Plugin runs, so the application calls this before releasing a
+      /// plugin. Plugins which aren't owned by the application should call
+      /// it from their own destructor.
+      public: void RemoveCallbacks();
+
+      /// \brief Register a hook which 3D scenes call on every frame, owned
+      /// by this plugin. Its calls are recorded as handlers of this plugin,
+      /// and it's removed with RemoveCallbacks.
+      /// \param[in] _phase Phase to run in.
+      /// \param[in] _name Hook name, such as "MarkerManager::OnRender".
+      /// \param[in] _callback Function to call, from the render thread.
+      /// \param[in] _priority Lower priorities run first.
+      /// \param[in] _budget Expected maximum time of each call, zero for no
+      /// limit.
+      /// \return ID which can be used to remove the hook early.
+      /// \sa addRenderHook
+      /// \sa removeRenderHook
+      protected: RenderHookId AddRenderHook(const RenderPhase _phase,
+          const std::string &_name, std::function<void()> _callback,
+          const int _priority = 0,
+          const std::chrono::nanoseconds _budget =
+          std::chrono::nanoseconds(0));
+
+      /// \brief Subscribe to events of type T, such as
+      /// events::HoverOnScene, instead of filtering the main window's events.
+      /// Queued events are delivered to this plugin's thread, and the
+      /// subscription is removed with RemoveCallbacks.
+      /// \param[in] _callback Function to call with each event.
+      /// \param[in] _delivery How events are delivered.
+      /// \param[in] _coalesce True to only deliver the latest of the events
+      /// published while a delivery is pending.
+      /// \return ID which can be used to unsubscribe early.
+      /// \sa subscribeEvent
+      /// \sa unsubscribeEvent
+      protected: template <typename T>
+      EventSubscriptionId SubscribeEvent(
+          std::function<void(const T &)> _callback,
+          const EventDelivery _delivery = EventDelivery::kDirect,
+          const bool _coalesce = false)
+      {
+        auto id = subscribeEvent<T>(std::move(_callback), _delivery,
+            _coalesce, this);
+        this->KeepEventSubscription(id);
+        return id;
+      }
+
       /// \brief Title to be displayed on top of plugin.
       protected: std::string title = "";
 
@@ -139,6 +266,15 @@ namespace ignition
       /// through the <anchor> tag and any state properties.
       private: void ApplyAnchors();
 
+      /// \brief Check whether the card is shown and the plugin is active.
+      /// Loads the config of lazy plugins the first time they're active, and
+      /// calls OnActivate and OnDeactivate.
+      private: void UpdateActive();
+
+      /// \brief Remove an event subscription with RemoveCallbacks.
+      /// \param[in] _id Subscription ID, ignored if 0.
+      private: void KeepEventSubscription(const EventSubscriptionId _id);
+
       /// \internal
       /// \brief Pointer to private data
       private: std::unique_ptr<PluginPrivate> dataPtr;
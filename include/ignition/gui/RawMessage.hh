@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_RAWMESSAGE_HH_
+#define IGNITION_GUI_RAWMESSAGE_HH_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <ignition/transport/Node.hh>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+  namespace gui
+  {
+    class RawMessagePrivate;
+    class RawFieldReaderPrivate;
+
+    /// \brief A message received as serialized bytes. The bytes are only
+    /// parsed into a protobuf message if Message() is called, and then only
+    /// once, so consumers which don't need the contents, or only need some
+    /// of them through a RawFieldReader, never pay for a full parse.
+    class IGNITION_GUI_VISIBLE RawMessage
+    {
+      /// \brief Constructor. The data is copied.
+      /// \param[in] _data Serialized message.
+      /// \param[in] _size Size of the serialized message.
+      /// \param[in] _type Message type, such as "ignition.msgs.StringMsg".
+      public: RawMessage(const char *_data, size_t _size,
+                         const std::string &_type);
+
+      /// \brief Destructor
+      public: ~RawMessage();
+
+      /// \brief Get the serialized message.
+      /// \return Serialized bytes.
+      public: const std::string &Data() const;
+
+      /// \brief Get the message type.
+      /// \return Message type.
+      public: const std::string &Type() const;
+
+      /// \brief Get the parsed message, parsing it the first time this is
+      /// called. This is thread safe.
+      /// \return The message, or null if the type is unknown or the data
+      /// can't be parsed.
+      public: std::shared_ptr<const google::protobuf::Message> Message() const;
+
+      /// \brief Private data pointer
+      private: std::unique_ptr<RawMessagePrivate> dataPtr;
+    };
+
+    /// \brief Shared pointer to a raw message.
+    using RawMessagePtr = std::shared_ptr<const RawMessage>;
+
+    /// \brief Callback which receives raw messages.
+    using RawMessageCallback = std::function<void(const RawMessagePtr &)>;
+
+    /// \brief Subscribe to a topic of any message type, receiving messages
+    /// as serialized bytes which are never deserialized by transport.
+    /// \param[in] _node Node used to subscribe. Use Node::Unsubscribe to
+    /// stop receiving messages.
+    /// \param[in] _topic Topic to subscribe to.
+    /// \param[in] _callback Called from a transport thread for each message.
+    /// \return True if subscribed.
+    IGNITION_GUI_VISIBLE
+    bool subscribeRaw(transport::Node &_node, const std::string &_topic,
+                      const RawMessageCallback &_callback);
+
+    /// \brief Reads numeric fields out of serialized messages without
+    /// parsing them. Only the fields which were added are decoded, all other
+    /// fields are skipped over.
+    ///
+    /// Fields are given as paths of field names from the root message, such
+    /// as {"pose", "position", "x"}. Numeric and boolean fields are read as
+    /// doubles. A path can also end at a message field, in which case only
+    /// its presence is reported. Repeated fields aren't supported.
+    class IGNITION_GUI_VISIBLE RawFieldReader
+    {
+      /// \brief Constructor
+      /// \param[in] _descriptor Descriptor of the message type which will be
+      /// read.
+      public: explicit RawFieldReader(
+          const google::protobuf::Descriptor *_descriptor);
+
+      /// \brief Destructor
+      public: ~RawFieldReader();
+
+      /// \brief Get the descriptor of the message type.
+      /// \return Descriptor passed to the constructor.
+      public: const google::protobuf::Descriptor *Descriptor() const;
+
+      /// \brief Add a field to read.
+      /// \param[in] _path Field names from the root message.
+      /// \return Index used to get the field after reading, or -1 if the path
+      /// doesn't lead to a supported field.
+      public: int AddField(const std::vector<std::string> &_path);
+
+      /// \brief Read all added fields from a serialized message. Fields which
+      /// aren't present are reset to zero.
+      /// \param[in] _data Serialized message.
+      /// \param[in] _size Size of the serialized message.
+      /// \return False if the data is malformed.
+      public: bool Read(const char *_data, size_t _size);
+
+      /// \brief Check whether a field was present in the last message read.
+      /// \param[in] _index Index returned by AddField.
+      /// \return True if present.
+      public: bool Found(int _index) const;
+
+      /// \brief Get the value of a field in the last message read.
+      /// \param[in] _index Index returned by AddField.
+      /// \return Field value, zero if it wasn't present or for message
+      /// fields.
+      public: double Value(int _index) const;
+
+      /// \brief Private data pointer
+      private: std::unique_ptr<RawFieldReaderPrivate> dataPtr;
+    };
+  }
+}
+#endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_RENDERHOOKS_HH_
+#define IGNITION_GUI_RENDERHOOKS_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+  namespace gui
+  {
+    class Plugin;
+
+    /// \brief Phases of a 3D scene's frame in which render hooks run. Hooks
+    /// run in the render thread, so it's safe to make rendering calls from
+    /// them.
+    enum class RenderPhase : int
+    {
+      /// \brief Before the user camera is rendered. Matches
+      /// events::PreRender.
+      kPreRender = 0,
+
+      /// \brief After the user camera is rendered. Matches events::Render.
+      kRender = 1
+    };
+
+    /// \brief Unique ID of a render hook, 0 is never used.
+    using RenderHookId = uint64_t;
+
+    /// \brief Timing statistics of a render hook.
+    struct RenderHookStats
+    {
+      /// \brief Hook name.
+      std::string name;
+
+      /// \brief Phase the hook runs in.
+      RenderPhase phase{RenderPhase::kRender};
+
+      /// \brief Priority, lower runs first.
+      int priority{0};
+
+      /// \brief Time budget of each call, zero if unlimited.
+      std::chrono::nanoseconds budget{0};
+
+      /// \brief Number of calls.
+      uint64_t count{0};
+
+      /// \brief Total time spent in the hook.
+      std::chrono::nanoseconds total{0};
+
+      /// \brief Longest call.
+      std::chrono::nanoseconds max{0};
+
+      /// \brief Number of calls which took longer than the budget.
+      uint64_t overBudget{0};
+    };
+
+    /// \brief Register a hook which 3D scenes call on every frame, instead
+    /// of filtering events::Render or events::PreRender on the main window.
+    /// Hooks of a phase run in priority order, then in registration order.
+    /// Every call is timed, see renderHookStatistics. If the hook belongs to
+    /// a plugin, calls are also recorded as handlers of the plugin while
+    /// instrumentation is enabled, see Plugin::RecordHandler.
+    ///
+    /// Hooks must not add or remove hooks. This is thread safe.
+    /// \param[in] _phase Phase to run in.
+    /// \param[in] _name Hook name, such as "MarkerManager::OnRender".
+    /// \param[in] _callback Function to call.
+    /// \param[in] _priority Lower priorities run first.
+    /// \param[in] _budget Expected maximum time of each call, zero for no
+    /// limit. Calls which take longer are counted, and the first one is
+    /// reported with a warning.
+    /// \param[in] _plugin Plugin which owns the hook, may be null.
+    /// \return ID used to remove the hook.
+    /// \sa Plugin::AddRenderHook
+    IGNITION_GUI_VISIBLE
+    RenderHookId addRenderHook(const RenderPhase _phase,
+        const std::string &_name, std::function<void()> _callback,
+        const int _priority = 0,
+        const std::chrono::nanoseconds _budget = std::chrono::nanoseconds(0),
+        Plugin *_plugin = nullptr);
+
+    /// \brief Remove a render hook. If the hook is running, this blocks until
+    /// it returns, so it's never called once this returns.
+    /// \param[in] _id ID returned by addRenderHook.
+    /// \return True if the hook was found.
+    IGNITION_GUI_VISIBLE
+    bool removeRenderHook(const RenderHookId _id);
+
+    /// \brief Run all hooks of a phase. Called by 3D scenes from their render
+    /// thread.
+    /// \param[in] _phase Phase to run.
+    IGNITION_GUI_VISIBLE
+    void runRenderHooks(const RenderPhase _phase);
+
+    /// \brief Get the statistics of all registered hooks since they were
+    /// added or the statistics were reset.
+    /// \return Statistics in the order hooks run, pre-render hooks first.
+    IGNITION_GUI_VISIBLE
+    std::vector<RenderHookStats> renderHookStatistics();
+
+    /// \brief Clear the statistics of all registered hooks.
+    IGNITION_GUI_VISIBLE
+    void resetRenderHookStatistics();
+  }
+}
+
+#endif
@@ -17,6 +17,8 @@
 #ifndef IGNITION_GUI_SEARCHMODEL_HH_
 #define IGNITION_GUI_SEARCHMODEL_HH_
 
+#include <memory>
+
 #include "ignition/gui/Export.hh"
 #include "ignition/gui/qt.h"
 
@@ -24,6 +26,8 @@ namespace ignition
 {
 namespace gui
 {
+  class SearchModelPrivate;
+
   /// \brief Customize the proxy model to display search results.
   ///
   /// Features:
@@ -33,8 +37,34 @@ namespace gui
   ///   applicable
   /// * Items with DataRole::TYPE == "title" are ignored
   ///
+  /// The lowercase text of every source item is indexed once each time rows
+  /// are added, removed or moved on the source model, and only the changed
+  /// items are updated when their data changes. Each search is resolved for
+  /// the whole tree in a single pass over that index. DataRole::TO_EXPAND is
+  /// answered by this model and isn't written to the source model. Up to 64
+  /// distinct words are considered per search.
+  ///
   class IGNITION_GUI_VISIBLE SearchModel : public QSortFilterProxyModel
   {
+    /// \brief Constructor
+    public: SearchModel();
+
+    /// \brief Destructor
+    public: ~SearchModel() override;
+
+    /// \brief Overloaded Qt method. Keep track of changes to the source
+    /// model, so the index is rebuilt when needed.
+    /// \param[in] _model Source model.
+    public: void setSourceModel(QAbstractItemModel *_model) override;
+
+    /// \brief Overloaded Qt method. Answers DataRole::TO_EXPAND with the
+    /// result of the current search.
+    /// \param[in] _index Index on this model.
+    /// \param[in] _role Data role.
+    /// \return Data for the role.
+    public: QVariant data(const QModelIndex &_index,
+                          int _role = Qt::DisplayRole) const override;
+
     /// \brief Overloaded Qt method. Customize so we accept rows where:
     /// 1. Each of the words can be found in its ancestors or itself, but not
     /// necessarily all words on the same row, or
@@ -88,6 +118,10 @@ namespace gui
 
     /// \brief Full search string.
     public: QString search;
+
+    /// \internal
+    /// \brief Private data pointer
+    private: std::unique_ptr<SearchModelPrivate> dataPtr;
   };
 }
 }
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_TRANSPORTLOG_HH_
+#define IGNITION_GUI_TRANSPORTLOG_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+  namespace gui
+  {
+    class TransportLogWriterPrivate;
+    class TransportLogReaderPrivate;
+    class TransportLogPlayerPrivate;
+
+    /// \brief A message recorded in a transport log.
+    struct TransportLogRecord
+    {
+      /// \brief Time at which the message was received, since the start of
+      /// the recording.
+      std::chrono::nanoseconds time{0};
+
+      /// \brief Topic the message was published on.
+      std::string topic;
+
+      /// \brief Message type, such as "ignition.msgs.StringMsg".
+      std::string type;
+
+      /// \brief Serialized message.
+      std::string data;
+    };
+
+    /// \brief Writes serialized transport messages to a log file, with the
+    /// time at which they were received. Messages are never deserialized, so
+    /// any message type can be recorded. This is thread safe, messages can
+    /// be written straight from transport callbacks.
+    ///
+    /// The file starts with a header holding a magic string and the format
+    /// version, followed by one entry per message holding its time in
+    /// nanoseconds, topic, type and data. Integers are little endian and
+    /// strings are prefixed with their 32 bit size.
+    class IGNITION_GUI_VISIBLE TransportLogWriter
+    {
+      /// \brief Constructor
+      public: TransportLogWriter();
+
+      /// \brief Destructor. Closes the file.
+      public: ~TransportLogWriter();
+
+      /// \brief Create a log file, overwriting any existing file. Message
+      /// times are counted from this call.
+      /// \param[in] _path Path to the file.
+      /// \return True if the file could be created.
+      public: bool Open(const std::string &_path);
+
+      /// \brief Get whether a file is open.
+      /// \return True if open.
+      public: bool IsOpen() const;
+
+      /// \brief Flush and close the file.
+      public: void Close();
+
+      /// \brief Write a message received now.
+      /// \param[in] _topic Topic.
+      /// \param[in] _type Message type.
+      /// \param[in] _data Serialized message.
+      /// \param[in] _size Size of the serialized message.
+      /// \return True if written.
+      public: bool Write(const std::string &_topic, const std::string &_type,
+                         const char *_data, size_t _size);
+
+      /// \brief Write a message with a given time.
+      /// \param[in] _record Message to write.
+      /// \return True if written.
+      public: bool Write(const TransportLogRecord &_record);
+
+      /// \brief Get the number of messages written since the file was
+      /// opened.
+      /// \return Number of messages.
+      public: uint64_t Count() const;
+
+      /// \brief Get the number of bytes written since the file was opened.
+      /// \return Number of bytes.
+      public: uint64_t Bytes() const;
+
+      /// \brief Private data pointer
+      private: std::unique_ptr<TransportLogWriterPrivate> dataPtr;
+    };
+
+    /// \brief Reads the messages of a log file written by
+    /// TransportLogWriter, in order.
+    class IGNITION_GUI_VISIBLE TransportLogReader
+    {
+      /// \brief Constructor
+      public: TransportLogReader();
+
+      /// \brief Destructor
+      public: ~TransportLogReader();
+
+      /// \brief Open a log file and check its header.
+      /// \param[in] _path Path to the file.
+      /// \return True if the file is a log which can be read.
+      public: bool Open(const std::string &_path);
+
+      /// \brief Read the next message.
+      /// \param[out] _record The message.
+      /// \return False at the end of the file, or if the file is truncated
+      /// or corrupt.
+      public: bool Next(TransportLogRecord &_record);
+
+      /// \brief Private data pointer
+      private: std::unique_ptr<TransportLogReaderPrivate> dataPtr;
+    };
+
+    /// \brief Republishes the messages of a log file, either keeping their
+    /// recorded timing or as fast as possible. The whole log is loaded into
+    /// memory before publishing starts, so reading the file doesn't disturb
+    /// the timing, and messages are published from a separate thread.
+    class IGNITION_GUI_VISIBLE TransportLogPlayer
+    {
+      /// \brief Constructor
+      public: TransportLogPlayer();
+
+      /// \brief Destructor. Stops publishing.
+      public: ~TransportLogPlayer();
+
+      /// \brief Load a log file and advertise all of its topics. Topics are
+      /// advertised with the type of their first message, messages of other
+      /// types on the same topic are skipped.
+      /// \param[in] _path Path to the file.
+      /// \return True if the log could be read.
+      public: bool Load(const std::string &_path);
+
+      /// \brief Get the number of loaded messages.
+      /// \return Number of messages.
+      public: uint64_t MessageCount() const;
+
+      /// \brief Get the recorded duration of the log, which is the time of
+      /// its last message.
+      /// \return Duration.
+      public: std::chrono::nanoseconds Duration() const;
+
+      /// \brief Start publishing the loaded messages. Publishing stops on its
+      /// own after the last message.
+      /// \param[in] _fast True to publish as fast as possible, false to
+      /// publish each message at its recorded time.
+      public: void Start(const bool _fast);
+
+      /// \brief Stop publishing and wait for the publishing thread to finish.
+      public: void Stop();
+
+      /// \brief Get whether all messages have been published, or publishing
+      /// was stopped.
+      /// \return True if finished.
+      public: bool Finished() const;
+
+      /// \brief Get the number of messages published so far.
+      /// \return Number of messages.
+      public: uint64_t PublishedCount() const;
+
+      /// \brief Get the largest number of messages which were due at once
+      /// but hadn't been published yet, because publishing fell behind the
+      /// recorded timing. Always 0 when publishing as fast as possible.
+      /// \return Number of messages.
+      public: uint64_t MaxBacklog() const;
+
+      /// \brief Get the largest delay between the recorded time of a
+      /// message and the time it was published. Always 0 when publishing as
+      /// fast as possible.
+      /// \return Delay.
+      public: std::chrono::nanoseconds MaxLag() const;
+
+      /// \brief Get the wall time spent publishing, from Start until the last
+      /// message.
+      /// \return Elapsed time.
+      public: std::chrono::nanoseconds Elapsed() const;
+
+      /// \brief Private data pointer
+      private: std::unique_ptr<TransportLogPlayerPrivate> dataPtr;
+    };
+  }
+}
+#endif
@@ -35,9 +35,27 @@ extern "C" IGNITION_GUI_VISIBLE void cmdStandalone(const char *_filename);
 /// \param[in] _config Path to a config file.
 extern "C" IGNITION_GUI_VISIBLE void cmdConfig(const char *_config);
 
+/// \brief External hook to execute 'ign gui --replay' from the command
+/// line. The GUI runs headless, see WindowType::kHeadless, and the log is
+/// republished against it. Frame
+/// times, event loop latency, the publishing backlog, the time each
+/// plugin spends handling events and the handler and queue statistics
+/// recorded by instrumented plugins are printed when the replay is over.
+/// \param[in] _config Path to a config file, empty for the default config.
+/// \param[in] _log Path to a log recorded by the Recorder plugin.
+/// \param[in] _fast Non-zero to publish as fast as possible instead of
+/// keeping the recorded timing.
+extern "C" IGNITION_GUI_VISIBLE void cmdReplay(const char *_config,
+    const char *_log, int _fast);
+
 /// \brief External hook to execute 'ign gui' from the command line.
 extern "C" IGNITION_GUI_VISIBLE void cmdEmptyWindow();
 
+/// \brief External hook to execute 'ign gui --headless' from the command
+/// line. Main windows opened afterwards, with -c or without options, run
+/// headless. See WindowType::kHeadless.
+extern "C" IGNITION_GUI_VISIBLE void cmdHeadless();
+
 /// \brief External hook when executing 'ign gui -t' from the command line.
 /// \param[in] _filename Path to a QSS file.
 extern "C" IGNITION_GUI_VISIBLE void cmdSetStyleFromFile(const char *_filename);
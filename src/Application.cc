@@ -16,7 +16,19 @@
  */
 
 #include <tinyxml2.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
 #include <queue>
+#include <regex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/SignalHandler.hh>
@@ -29,6 +41,7 @@
 #include "ignition/gui/config.hh"
 #include "ignition/gui/Dialog.hh"
 #include "ignition/gui/Helpers.hh"
+#include "ignition/gui/Instrumentation.hh"
 #include "ignition/gui/MainWindow.hh"
 #include "ignition/gui/Plugin.hh"
 
@@ -36,14 +49,130 @@ namespace ignition
 {
   namespace gui
   {
+    /// \brief A plugin library which has been found and loaded, and whose
+    /// plugins are ready to be instantiated.
+    struct PluginLibrary
+    {
+      /// \brief Path to the library, empty if it wasn't found.
+      std::string path;
+
+      /// \brief Loader which loaded the library.
+      std::shared_ptr<plugin::Loader> loader;
+
+      /// \brief Names of the plugins in the library.
+      std::unordered_set<std::string> pluginNames;
+
+      /// \brief Error message, empty if the library was loaded.
+      std::string error;
+    };
+
+    /// \brief A directory which is searched for plugins, as of the last
+    /// time it was scanned.
+    struct PluginDirectory
+    {
+      /// \brief Path to the directory.
+      std::string path;
+
+      /// \brief Plugin files in the directory.
+      std::vector<std::string> files;
+
+      /// \brief True if the directory is watched for changes. Directories
+      /// which didn't exist when scanned can't be watched.
+      bool watched{false};
+
+      /// \brief True if the directory changed since it was scanned.
+      bool dirty{true};
+    };
+
+    /// \brief A configuration which is being loaded.
+    struct ConfigLoad
+    {
+      /// \brief Path to the configuration file.
+      std::string path;
+
+      /// \brief Parsed file, which owns the plugin elements.
+      std::shared_ptr<const tinyxml2::XMLDocument> doc;
+
+      /// \brief Plugin elements, in config order.
+      std::vector<const tinyxml2::XMLElement *> pluginElems;
+
+      /// \brief Filename of each plugin.
+      std::vector<std::string> filenames;
+
+      /// \brief Previous plugin kept for each element, null for plugins
+      /// which must be loaded.
+      std::vector<std::shared_ptr<Plugin>> keptPlugins;
+
+      /// \brief Whether each element is a kept plugin. Kept plugins may
+      /// have been removed since.
+      std::vector<bool> kept;
+
+      /// \brief Position of the next element to load.
+      size_t next{0};
+    };
+
     class ApplicationPrivate
     {
+      /// \brief Add all paths where plugins are searched for.
+      /// \param[in] _systemPaths Paths to populate.
+      public: void AddPluginPaths(common::SystemPaths &_systemPaths) const;
+
+      /// \brief Get all paths where plugins are searched for, in the order
+      /// documented in Application::PluginList. This doesn't touch the
+      /// filesystem.
+      /// \return Directory paths.
+      public: std::vector<std::string> PluginDirectoryPaths() const;
+
+      /// \brief Update the plugin index. Only directories which changed
+      /// since they were last scanned, or which didn't exist then, are
+      /// scanned again. Must be called from the GUI thread.
+      public: void RefreshPluginIndex();
+
+      /// \brief Find a plugin library on the plugin index.
+      /// \param[in] _filename Plugin filename, with or without the "lib"
+      /// prefix and extension.
+      /// \return Path to the library, or empty if it's not on the index.
+      public: std::string FindPluginLibrary(const std::string &_filename);
+
+      /// \brief Load a plugin library. This doesn't instantiate any plugins,
+      /// so it's safe to call from worker threads.
+      /// \param[in] _filename Plugin filename.
+      /// \param[in] _path Path to the library. If empty, the library is
+      /// searched for on all plugin paths.
+      /// \return The loaded library, or an error.
+      public: PluginLibrary LoadPluginLibrary(const std::string &_filename,
+          const std::string &_path) const;
+
+      /// \brief Find and load plugin libraries concurrently on a pool of
+      /// worker threads, and keep them in preloadedLibraries. Blocks until
+      /// all libraries are loaded.
+      /// \param[in] _filenames Plugin filenames, may contain duplicates.
+      public: void PreloadLibraries(const std::vector<std::string> &_filenames);
+
+      /// \brief Take a plugin's card out of its split, removing the split.
+      /// The card is kept, so it can be added back with AttachCard.
+      /// \param[in] _plugin Plugin on the main window.
+      public: void DetachCard(const std::shared_ptr<Plugin> &_plugin);
+
+      /// \brief Add a detached card to a new split at the end of the layout,
+      /// and move its plugin to the end of the plugin lists, so it's also
+      /// saved in that order.
+      /// \param[in] _plugin Plugin whose card was detached.
+      public: void AttachCard(const std::shared_ptr<Plugin> &_plugin);
+
       /// \brief QML engine
       public: QQmlApplicationEngine *engine{nullptr};
 
       /// \brief Pointer to main window
       public: MainWindow *mainWin{nullptr};
 
+      /// \brief True if created with WindowType::kHeadless.
+      public: bool headless{false};
+
+      /// \brief Number of frames rendered by the main window. Frames may be
+      /// rendered on the render thread.
+      public: std::atomic<uint64_t> frameCount{0};
+
       /// \brief Vector of pointers to dialogs
       public: std::vector<Dialog *> dialogs;
 
@@ -70,6 +199,54 @@ namespace ignition
 
       public: common::SignalHandler signalHandler;
 
+      /// \brief Libraries loaded ahead of time while loading a config, by
+      /// filename. LoadPlugin uses these instead of searching for the library
+      /// again. Cleared once the config is loaded.
+      public: std::unordered_map<std::string, PluginLibrary>
+          preloadedLibraries;
+
+      /// \brief Directories searched for plugins, in search order.
+      public: std::vector<PluginDirectory> pluginDirectories;
+
+      /// \brief Plugin index, mapping plugin names without "lib" prefix and
+      /// extension to library paths.
+      public: std::unordered_map<std::string, std::string> pluginIndex;
+
+      /// \brief Display names of the plugins on the index, in search order.
+      public: std::vector<std::string> pluginDisplayNames;
+
+      /// \brief Watches plugin directories, so they're only scanned again
+      /// when they change.
+      public: std::unique_ptr<QFileSystemWatcher> pluginWatcher;
+
+      /// \brief Filename and configuration which each plugin was loaded
+      /// with, used to keep plugins which are in both the old and the new
+      /// config when a config is loaded. Configurations are compact XML.
+      public: std::unordered_map<const Plugin *,
+          std::pair<std::string, std::string>> pluginConfigs;
+
+      /// \brief QML components by file.
+      public: std::unordered_map<std::string, QQmlComponent *> components;
+
+      /// \brief Libraries which plugins were instantiated from, by path.
+      /// They're kept loaded while their QML components are cached, because
+      /// compiled QML may live in the library.
+      public: std::unordered_map<std::string, std::shared_ptr<plugin::Loader>>
+          pluginLibraries;
+
+      /// \brief Reads and parses the latest config requested by
+      /// LoadConfigAsync. Each read waits for the previous one, so configs
+      /// are applied in the order they were requested.
+      public: std::shared_future<void> configRead;
+
+      /// \brief Configuration being loaded, null if none.
+      public: std::unique_ptr<ConfigLoad> configLoad;
+
+      /// \brief Configurations read by LoadConfigAsync which wait for the
+      /// one being loaded, in the order they were requested.
+      public: std::deque<std::pair<std::string,
+          std::shared_ptr<const tinyxml2::XMLDocument>>> pendingConfigs;
+
       /// \brief QT message handler that pipes qt messages into our console
       /// system.
       public: static void MessageHandler(QtMsgType _type,
@@ -81,12 +258,56 @@ namespace ignition
 using namespace ignition;
 using namespace gui;
 
+/////////////////////////////////////////////////
+/// \brief Print an element as compact XML, so that equivalent elements
+/// print the same regardless of their formatting.
+/// \param[in] _elem Element to print.
+/// \return XML string.
+static std::string compactXml(const tinyxml2::XMLElement *_elem)
+{
+  tinyxml2::XMLPrinter printer(nullptr, true);
+  _elem->Accept(&printer);
+  return printer.CStr();
+}
+
+/////////////////////////////////////////////////
+/// \brief Set up the Qt environment for a window type. This must happen
+/// before Qt is initialized, so it's called while constructing the
+/// QApplication base class. Variables which are already set are kept.
+/// \param[in] _argc Argument count.
+/// \param[in] _type Window type.
+/// \return _argc, to be passed on to QApplication.
+static int &setUpEnvironment(int &_argc, const WindowType _type)
+{
+  if (_type != WindowType::kHeadless)
+    return _argc;
+
+  auto setDefault = [](const char *_name, const char *_value)
+  {
+    if (!qEnvironmentVariableIsSet(_name))
+      qputenv(_name, _value);
+  };
+
+  setDefault("QT_QPA_PLATFORM", "offscreen");
+  setDefault("LIBGL_ALWAYS_SOFTWARE", "1");
+  setDefault("QSG_RENDER_LOOP", "basic");
+
+  // The offscreen platform needs an X server for OpenGL
+  if (qEnvironmentVariableIsEmpty("DISPLAY"))
+    setDefault("QT_QUICK_BACKEND", "software");
+
+  return _argc;
+}
+
 /////////////////////////////////////////////////
 Application::Application(int &_argc, char **_argv, const WindowType _type)
-  : QApplication(_argc, _argv), dataPtr(new ApplicationPrivate)
+  : QApplication(setUpEnvironment(_argc, _type), _argv),
+    dataPtr(new ApplicationPrivate)
 {
   igndbg << "Initializing application." << std::endl;
 
+  this->dataPtr->headless = _type == WindowType::kHeadless;
+
   // Configure console
   common::Console::SetPrefix("[GUI] ");
 
@@ -110,8 +331,16 @@ Application::Application(int &_argc, char **_argv, const WindowType _type)
   this->dataPtr->defaultConfigPath = common::joinPaths(
         home, ".ignition", "gui", "default.config");
 
+  // Plugin instrumentation
+  std::string instrumentation;
+  if (common::env("IGN_GUI_INSTRUMENTATION", instrumentation) &&
+      !instrumentation.empty() && instrumentation != "0")
+  {
+    setInstrumentationEnabled(true);
+  }
+
   // If it's a main window, initialize it
-  if (_type == WindowType::kMainWindow)
+  if (_type == WindowType::kMainWindow || _type == WindowType::kHeadless)
   {
     if (!this->InitializeMainWindow())
       ignerr << "Failed to initialize main window." << std::endl;
@@ -131,6 +360,12 @@ Application::~Application()
 {
   igndbg << "Terminating application." << std::endl;
 
+  // A config being read would be applied to a destroyed application
+  if (this->dataPtr->configRead.valid())
+    this->dataPtr->configRead.wait();
+  this->dataPtr->configLoad.reset();
+  this->dataPtr->pendingConfigs.clear();
+
   if (this->dataPtr->mainWin && this->dataPtr->mainWin->QuickWindow())
   {
     // Detach object from main window and leave libraries for ign-common
@@ -154,11 +389,19 @@ Application::~Application()
   }
   this->dataPtr->dialogs.clear();
 
+  for (auto &component : this->dataPtr->components)
+    delete component.second;
+  this->dataPtr->components.clear();
+
   if (this->dataPtr->engine)
   {
     this->dataPtr->engine->deleteLater();
   }
 
+  // Plugins on dialogs aren't removed one by one
+  for (auto &plugin : this->dataPtr->pluginsAdded)
+    plugin->RemoveCallbacks();
+
   std::queue<std::shared_ptr<Plugin>> empty;
   std::swap(this->dataPtr->pluginsToAdd, empty);
   this->dataPtr->pluginsAdded.clear();
@@ -172,6 +415,42 @@ QQmlApplicationEngine *Application::Engine() const
   return this->dataPtr->engine;
 }
 
+/////////////////////////////////////////////////
+QQmlComponent *Application::QmlComponent(const std::string &_file,
+    bool _wait)
+{
+  if (_file.empty())
+    return nullptr;
+
+  auto &component = this->dataPtr->components[_file];
+
+  // Try again if it failed, the file may not have been available before
+  if (nullptr != component && component->isError())
+  {
+    delete component;
+    component = nullptr;
+  }
+
+  if (nullptr == component)
+  {
+    component = new QQmlComponent(this->dataPtr->engine,
+        QString::fromStdString(_file), QQmlComponent::Asynchronous);
+  }
+
+  // Waiting for the asynchronous component with a nested event loop would
+  // run queued work, such as removing plugins, in the middle of loading
+  // one. Compile synchronously instead, which reuses the compilation already
+  // in progress.
+  if (_wait && component->isLoading())
+  {
+    delete component;
+    component = new QQmlComponent(this->dataPtr->engine,
+        QString::fromStdString(_file));
+  }
+
+  return component;
+}
+
 /////////////////////////////////////////////////
 Application *ignition::gui::App()
 {
@@ -217,9 +496,100 @@ bool Application::LoadConfig(const std::string &_config)
   }
 
   // Use tinyxml to read config
-  tinyxml2::XMLDocument doc;
-  auto success = !doc.LoadFile(_config.c_str());
-  if (!success)
+  auto doc = std::make_shared<tinyxml2::XMLDocument>();
+  doc->LoadFile(_config.c_str());
+  return this->LoadConfigDocument(_config, doc, false);
+}
+
+/////////////////////////////////////////////////
+void Application::LoadConfigAsync(const std::string &_path)
+{
+  if (_path.empty())
+  {
+    ignerr << "Missing config file" << std::endl;
+    this->ConfigLoaded(QString(), false);
+    return;
+  }
+
+  // Reads are chained on the worker, so they're applied in the order
+  // they're requested without blocking this thread
+  auto previous = this->dataPtr->configRead;
+  this->dataPtr->configRead = std::async(std::launch::async,
+      [this, _path, previous]()
+  {
+    if (previous.valid())
+      previous.wait();
+
+    auto doc = std::make_shared<tinyxml2::XMLDocument>();
+    doc->LoadFile(_path.c_str());
+
+    // Plugins must be instantiated on the application's thread
+    QMetaObject::invokeMethod(this, [this, _path, doc]()
+    {
+      this->dataPtr->pendingConfigs.emplace_back(_path, doc);
+      this->LoadPendingConfigs();
+    }, Qt::QueuedConnection);
+  }).share();
+}
+
+/////////////////////////////////////////////////
+bool Application::LoadingConfig() const
+{
+  return nullptr != this->dataPtr->configLoad;
+}
+
+/////////////////////////////////////////////////
+void Application::LoadPendingConfigs()
+{
+  auto &pending = this->dataPtr->pendingConfigs;
+  while (!this->dataPtr->configLoad && !pending.empty())
+  {
+    auto config = pending.front();
+    pending.pop_front();
+    if (!this->LoadConfigDocument(config.first, config.second, true))
+      this->ConfigLoaded(QString::fromStdString(config.first), false);
+  }
+}
+
+/////////////////////////////////////////////////
+void Application::ContinueConfigLoad()
+{
+  if (!this->dataPtr->configLoad)
+    return;
+
+  // Other events, such as painting the new card, are processed before the
+  // next step
+  auto path = this->dataPtr->configLoad->path;
+  bool success{false};
+  if (this->LoadConfigStep(success))
+  {
+    QMetaObject::invokeMethod(this, [this]()
+    {
+      this->ContinueConfigLoad();
+    }, Qt::QueuedConnection);
+    return;
+  }
+
+  // The load is over, so slots may load another config
+  this->ConfigLoaded(QString::fromStdString(path), success);
+  this->LoadPendingConfigs();
+}
+
+/////////////////////////////////////////////////
+bool Application::LoadConfigDocument(const std::string &_config,
+    std::shared_ptr<const tinyxml2::XMLDocument> _doc,
+    const bool _progressive)
+{
+  // Loads don't nest, the plugins of both configs would be mixed
+  if (this->dataPtr->configLoad)
+  {
+    ignerr << "Can't load config [" << _config << "] while config ["
+           << this->dataPtr->configLoad->path << "] is being loaded."
+           << std::endl;
+    return false;
+  }
+
+  if (_doc->Error())
   {
     // We do not show an error message if the default config path doesn't exist
     // yet. It's expected behavior, it will be created the first time the user
@@ -235,29 +605,158 @@ bool Application::LoadConfig(const std::string &_config)
 
   ignmsg << "Loading config [" << _config << "]" << std::endl;
 
-  // Clear all previous plugins
+  // Plugins in the new config
+  std::vector<const tinyxml2::XMLElement *> pluginElems;
+  std::vector<std::string> filenames;
+  std::vector<std::string> configs;
+  for (auto pluginElem = _doc->FirstChildElement("plugin");
+      pluginElem != nullptr;
+      pluginElem = pluginElem->NextSiblingElement("plugin"))
+  {
+    auto filename = pluginElem->Attribute("filename");
+    if (nullptr == filename)
+    {
+      ignerr << "Missing filename attribute on <plugin>" << std::endl;
+      continue;
+    }
+    pluginElems.push_back(pluginElem);
+    filenames.push_back(filename);
+    configs.push_back(compactXml(pluginElem));
+  }
+
+  // Keep previous plugins which were loaded with the same filename and
+  // config as a new one, and remove all others
+  std::vector<bool> kept(pluginElems.size(), false);
+  std::vector<std::shared_ptr<Plugin>> keptPlugins(pluginElems.size());
+  size_t keptCount{0};
   auto plugins = this->dataPtr->mainWin->findChildren<Plugin *>();
   for (auto plugin : plugins)
   {
+    bool keep{false};
+    auto loaded = this->dataPtr->pluginConfigs.find(plugin);
+    for (size_t i = 0; i < pluginElems.size() &&
+        loaded != this->dataPtr->pluginConfigs.end(); ++i)
+    {
+      if (!kept[i] && filenames[i] == loaded->second.first &&
+          configs[i] == loaded->second.second)
+      {
+        kept[i] = true;
+        keptPlugins[i] = this->PluginByName(
+            plugin->CardItem()->objectName().toStdString());
+        keep = true;
+        break;
+      }
+    }
+
+    if (keep)
+    {
+      keptCount++;
+      continue;
+    }
+
     auto pluginName = plugin->CardItem()->objectName();
     this->RemovePlugin(pluginName.toStdString());
   }
-  if (this->dataPtr->pluginsAdded.size() > 0)
+  if (this->dataPtr->pluginsAdded.size() != keptCount)
   {
     ignerr << "The plugin list was not properly cleaned up." << std::endl;
   }
-  this->dataPtr->pluginsAdded.clear();
 
-  // Process each plugin
-  for (auto pluginElem = doc.FirstChildElement("plugin"); pluginElem != nullptr;
-      pluginElem = pluginElem->NextSiblingElement("plugin"))
+  if (keptCount > 0)
   {
-    auto filename = pluginElem->Attribute("filename");
-    this->LoadPlugin(filename, pluginElem);
+    igndbg << "Kept [" << keptCount << "] plugins from previous config"
+           << std::endl;
+  }
+
+  // Finding and loading libraries doesn't touch Qt, so all libraries are
+  // loaded concurrently first
+  std::vector<std::string> toLoad;
+  for (size_t i = 0; i < pluginElems.size(); ++i)
+  {
+    if (!kept[i])
+      toLoad.push_back(filenames[i]);
+  }
+  this->dataPtr->PreloadLibraries(toLoad);
+
+  // The engine compiles QML in the background while plugins are being
+  // instantiated
+  this->QmlComponent(":qml/IgnCard.qml", false);
+  for (const auto &preloaded : this->dataPtr->preloadedLibraries)
+  {
+    if (!preloaded.second.error.empty())
+      continue;
+    const auto &filename = preloaded.first;
+    this->QmlComponent(":/" + filename + "/" + filename + ".qml", false);
+  }
+
+  // Kept plugins which are already laid out in config order, before any
+  // new plugin, stay where they are. All others are taken out of the layout
+  // and added back in config order.
+  size_t firstMoved{0};
+  while (firstMoved < pluginElems.size() && kept[firstMoved] &&
+      firstMoved < this->dataPtr->pluginsAdded.size() &&
+      this->dataPtr->pluginsAdded[firstMoved] == keptPlugins[firstMoved])
+  {
+    firstMoved++;
+  }
+  for (size_t i = firstMoved; i < pluginElems.size(); ++i)
+  {
+    if (kept[i] && keptPlugins[i])
+      this->dataPtr->DetachCard(keptPlugins[i]);
+  }
+
+  auto load = std::make_unique<ConfigLoad>();
+  load->path = _config;
+  load->doc = _doc;
+  load->pluginElems = std::move(pluginElems);
+  load->filenames = std::move(filenames);
+  load->keptPlugins = std::move(keptPlugins);
+  load->kept = std::move(kept);
+  load->next = firstMoved;
+  this->dataPtr->configLoad = std::move(load);
+
+  // Plugins are instantiated and added to the window on this thread, in
+  // config order
+  if (_progressive)
+  {
+    QMetaObject::invokeMethod(this, [this]()
+    {
+      this->ContinueConfigLoad();
+    }, Qt::QueuedConnection);
+    return true;
+  }
+
+  bool success{false};
+  while (this->LoadConfigStep(success)) {}
+  return success;
+}
+
+/////////////////////////////////////////////////
+bool Application::LoadConfigStep(bool &_success)
+{
+  auto &load = *this->dataPtr->configLoad;
+
+  // Kept cards are attached right away, new plugins are loaded one per step
+  while (load.next < load.pluginElems.size())
+  {
+    auto i = load.next++;
+    if (!load.kept[i])
+    {
+      this->LoadPlugin(load.filenames[i], load.pluginElems[i]);
+      return true;
+    }
+
+    if (load.keptPlugins[i])
+      this->dataPtr->AttachCard(load.keptPlugins[i]);
   }
+  this->dataPtr->preloadedLibraries.clear();
+
+  // Keep the document until the window properties are read
+  auto doc = load.doc;
+  this->dataPtr->configLoad.reset();
 
   // Process window properties
-  if (auto winElem = doc.FirstChildElement("window"))
+  if (auto winElem = doc->FirstChildElement("window"))
   {
     igndbg << "Loading window config" << std::endl;
 
@@ -266,6 +765,7 @@ bool Application::LoadConfig(const std::string &_config)
     {
       ignwarn << "There was an error parsing the <window> element"
               << std::endl;
+      _success = false;
       return false;
     }
     this->dataPtr->windowConfig.MergeFromXML(std::string(printer.CStr()));
@@ -277,11 +777,24 @@ bool Application::LoadConfig(const std::string &_config)
       dialogOnExitElem->QueryBoolText(&showDialogOnExit);
       this->dataPtr->mainWin->SetShowDialogOnExit(showDialogOnExit);
     }
+
+    // Autosave, to the default config unless a path is given
+    if (auto autosaveElem = winElem->FirstChildElement("autosave"))
+    {
+      double interval{0.0};
+      autosaveElem->QueryDoubleText(&interval);
+      std::string path = this->DefaultConfigPath();
+      if (auto pathAttr = autosaveElem->Attribute("path"))
+        path = pathAttr;
+      this->dataPtr->mainWin->SetAutosave(path,
+          std::chrono::milliseconds(static_cast<int64_t>(interval * 1000)));
+    }
   }
 
   this->ApplyConfig();
 
-  return true;
+  _success = true;
+  return false;
 }
 
 /////////////////////////////////////////////////
@@ -308,38 +821,28 @@ bool Application::LoadPlugin(const std::string &_filename,
 {
   igndbg << "Loading plugin [" << _filename << "]" << std::endl;
 
-  common::SystemPaths systemPaths;
-  systemPaths.SetPluginPathEnv(this->dataPtr->pluginPathEnv);
-
-  for (const auto &path : this->dataPtr->pluginPaths)
-    systemPaths.AddPluginPaths(path);
-
-  // Add default folder and install folder
-  std::string home;
-  common::env(IGN_HOMEDIR, home);
-  systemPaths.AddPluginPaths(home + "/.ignition/gui/plugins:" +
-                             IGN_GUI_PLUGIN_INSTALL_DIR);
-
-  auto pathToLib = systemPaths.FindSharedLibrary(_filename);
-  if (pathToLib.empty())
+  PluginLibrary library;
+  auto preloaded = this->dataPtr->preloadedLibraries.find(_filename);
+  if (preloaded != this->dataPtr->preloadedLibraries.end())
   {
-    ignerr << "Failed to load plugin [" << _filename <<
-              "] : couldn't find shared library." << std::endl;
-    return false;
+    library = preloaded->second;
+  }
+  else
+  {
+    library = this->dataPtr->LoadPluginLibrary(_filename,
+        this->dataPtr->FindPluginLibrary(_filename));
   }
 
-  // Load plugin
-  plugin::Loader pluginLoader;
-
-  auto pluginNames = pluginLoader.LoadLib(pathToLib);
-  if (pluginNames.empty())
+  if (!library.error.empty())
   {
-    ignerr << "Failed to load plugin [" << _filename <<
-              "] : couldn't load library on path [" << pathToLib <<
-              "]." << std::endl;
+    ignerr << library.error << std::endl;
     return false;
   }
 
+  auto &pluginLoader = *library.loader;
+  const auto &pluginNames = library.pluginNames;
+  const auto &pathToLib = library.path;
+
   // Go over all plugin names and get the first one that implements the
   // ignition::gui::Plugin interface
   plugin::PluginPtr commonPlugin;
@@ -392,6 +895,10 @@ bool Application::LoadPlugin(const std::string &_filename,
   if (nullptr == plugin->CardItem())
     return false;
 
+  this->dataPtr->pluginLibraries.emplace(pathToLib, library.loader);
+  this->dataPtr->pluginConfigs[plugin.get()] = std::make_pair(_filename,
+      _pluginElem ? compactXml(_pluginElem) : std::string());
+
   // Store plugin in queue to be added to the window
   this->dataPtr->pluginsToAdd.push(plugin);
 
@@ -408,6 +915,294 @@ bool Application::LoadPlugin(const std::string &_filename,
   return true;
 }
 
+/////////////////////////////////////////////////
+void ApplicationPrivate::AddPluginPaths(
+    common::SystemPaths &_systemPaths) const
+{
+  _systemPaths.SetPluginPathEnv(this->pluginPathEnv);
+
+  for (const auto &path : this->pluginPaths)
+    _systemPaths.AddPluginPaths(path);
+
+  // Add default folder and install folder
+  std::string home;
+  common::env(IGN_HOMEDIR, home);
+  _systemPaths.AddPluginPaths(home + "/.ignition/gui/plugins:" +
+                              IGN_GUI_PLUGIN_INSTALL_DIR);
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> ApplicationPrivate::PluginDirectoryPaths() const
+{
+  // 1. Paths from env variable
+  auto paths = common::SystemPaths::PathsFromEnv(this->pluginPathEnv);
+
+  // 2. Paths added by calling addPluginPath
+  for (auto const &path : this->pluginPaths)
+    paths.push_back(path);
+
+  // 3. ~/.ignition/gui/plugins
+  std::string home;
+  common::env(IGN_HOMEDIR, home);
+  paths.push_back(home + "/.ignition/gui/plugins");
+
+  // 4. Install path
+  paths.push_back(IGN_GUI_PLUGIN_INSTALL_DIR);
+
+  return {paths.begin(), paths.end()};
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the name under which a plugin file is indexed.
+/// \param[in] _filename File name, such as "libWorldStats.so".
+/// \return Name without "lib" prefix and extension, such as "WorldStats".
+static std::string pluginIndexName(const std::string &_filename)
+{
+  auto name = _filename;
+  if (name.find("lib") == 0)
+    name = name.substr(3);
+  return name.substr(0, name.find("."));
+}
+
+/////////////////////////////////////////////////
+void ApplicationPrivate::RefreshPluginIndex()
+{
+  if (!this->pluginWatcher)
+  {
+    this->pluginWatcher = std::make_unique<QFileSystemWatcher>();
+    QObject::connect(this->pluginWatcher.get(),
+        &QFileSystemWatcher::directoryChanged, this->pluginWatcher.get(),
+        [this](const QString &_path)
+        {
+          for (auto &dir : this->pluginDirectories)
+          {
+            if (QString::fromStdString(dir.path) == _path)
+              dir.dirty = true;
+          }
+        });
+  }
+
+  // Start over if the search paths changed
+  auto paths = this->PluginDirectoryPaths();
+  bool pathsChanged = paths.size() != this->pluginDirectories.size();
+  for (size_t i = 0; !pathsChanged && i < paths.size(); ++i)
+    pathsChanged = paths[i] != this->pluginDirectories[i].path;
+
+  if (pathsChanged)
+  {
+    auto watched = this->pluginWatcher->directories();
+    if (!watched.isEmpty())
+      this->pluginWatcher->removePaths(watched);
+
+    this->pluginDirectories.clear();
+    for (const auto &path : paths)
+    {
+      PluginDirectory dir;
+      dir.path = path;
+      this->pluginDirectories.push_back(dir);
+    }
+  }
+
+  // Scan directories which changed. Directories which can't be watched are
+  // checked for existence, so they're picked up once created.
+  bool changed{pathsChanged};
+  for (auto &dir : this->pluginDirectories)
+  {
+    if (!dir.dirty &&
+        (dir.watched || !QFileInfo(QString::fromStdString(dir.path)).isDir()))
+    {
+      continue;
+    }
+
+    dir.files.clear();
+    common::DirIter endIter;
+    for (common::DirIter dirIter(dir.path);
+        dirIter != endIter; ++dirIter)
+    {
+      auto plugin = common::basename(*dirIter);
+
+      // All we verify is that the file starts with "lib", any further
+      // checks would require loading the plugin.
+      if (plugin.find("lib") == 0)
+        dir.files.push_back(plugin);
+    }
+    std::sort(dir.files.begin(), dir.files.end());
+
+    auto qPath = QString::fromStdString(dir.path);
+    dir.watched = this->pluginWatcher->directories().contains(qPath) ||
+        (QFileInfo(qPath).isDir() && this->pluginWatcher->addPath(qPath));
+    dir.dirty = false;
+    changed = true;
+  }
+
+  if (!changed)
+    return;
+
+  // Earlier directories take precedence. Files are sorted, so the
+  // unversioned library comes before versioned ones.
+  // Split WWWCamelCase3D -> WWW Camel Case 3D
+  static const std::regex reg("(\\B[A-Z][a-z])|(\\B[0-9])");
+
+  this->pluginIndex.clear();
+  this->pluginDisplayNames.clear();
+  for (const auto &dir : this->pluginDirectories)
+  {
+    for (const auto &file : dir.files)
+    {
+      auto name = pluginIndexName(file);
+      if (this->pluginIndex.find(name) != this->pluginIndex.end())
+        continue;
+      this->pluginIndex[name] = common::joinPaths(dir.path, file);
+
+      this->pluginDisplayNames.push_back(std::regex_replace(name, reg, " $&"));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+std::string ApplicationPrivate::FindPluginLibrary(
+    const std::string &_filename)
+{
+  // Paths are left for SystemPaths
+  if (_filename.find_first_of("/\\") != std::string::npos)
+    return std::string();
+
+  this->RefreshPluginIndex();
+
+  auto it = this->pluginIndex.find(pluginIndexName(_filename));
+  if (it == this->pluginIndex.end())
+    return std::string();
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+PluginLibrary ApplicationPrivate::LoadPluginLibrary(
+    const std::string &_filename, const std::string &_path) const
+{
+  PluginLibrary library;
+  library.path = _path;
+
+  // Libraries which aren't on the index, for example those given by path or
+  // without the "lib" prefix, are searched for the same way as before
+  if (library.path.empty())
+  {
+    common::SystemPaths systemPaths;
+    this->AddPluginPaths(systemPaths);
+    library.path = systemPaths.FindSharedLibrary(_filename);
+  }
+  if (library.path.empty())
+  {
+    library.error = "Failed to load plugin [" + _filename +
+        "] : couldn't find shared library.";
+    return library;
+  }
+
+  library.loader = std::make_shared<plugin::Loader>();
+  library.pluginNames = library.loader->LoadLib(library.path);
+  if (library.pluginNames.empty())
+  {
+    library.error = "Failed to load plugin [" + _filename +
+        "] : couldn't load library on path [" + library.path + "].";
+  }
+
+  return library;
+}
+
+/////////////////////////////////////////////////
+void ApplicationPrivate::PreloadLibraries(
+    const std::vector<std::string> &_filenames)
+{
+  std::vector<std::string> unique;
+  for (const auto &filename : _filenames)
+  {
+    if (std::find(unique.begin(), unique.end(), filename) == unique.end())
+      unique.push_back(filename);
+  }
+
+  if (unique.empty())
+    return;
+
+  // Resolve paths on the index from this thread, the workers only load
+  std::vector<std::string> paths;
+  for (const auto &filename : unique)
+    paths.push_back(this->FindPluginLibrary(filename));
+
+  std::vector<PluginLibrary> libraries(unique.size());
+  std::atomic<size_t> next{0};
+  auto work = [&]()
+  {
+    for (auto i = next++; i < unique.size(); i = next++)
+      libraries[i] = this->LoadPluginLibrary(unique[i], paths[i]);
+  };
+
+  auto count = std::min<size_t>(unique.size(),
+      std::max(1u, std::thread::hardware_concurrency()));
+
+  // The calling thread is one of the workers
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < count; ++i)
+    workers.emplace_back(work);
+  work();
+  for (auto &worker : workers)
+    worker.join();
+
+  for (size_t i = 0; i < unique.size(); ++i)
+    this->preloadedLibraries[unique[i]] = std::move(libraries[i]);
+}
+
+/////////////////////////////////////////////////
+void ApplicationPrivate::DetachCard(const std::shared_ptr<Plugin> &_plugin)
+{
+  auto cardItem = _plugin->CardItem();
+  if (nullptr == cardItem || nullptr == cardItem->parentItem())
+    return;
+
+  auto bgItem = this->mainWin->QuickWindow()->findChild<QQuickItem *>(
+      "background");
+  if (!bgItem)
+    return;
+
+  auto splitName = cardItem->parentItem()->objectName();
+  cardItem->setParentItem(nullptr);
+  QMetaObject::invokeMethod(bgItem, "removeSplitItem",
+      Q_ARG(QVariant, splitName));
+}
+
+/////////////////////////////////////////////////
+void ApplicationPrivate::AttachCard(const std::shared_ptr<Plugin> &_plugin)
+{
+  // The plugin may have been removed while it was detached
+  auto it = std::find(this->pluginsAdded.begin(), this->pluginsAdded.end(),
+      _plugin);
+  if (it == this->pluginsAdded.end())
+    return;
+
+  auto cardItem = _plugin->CardItem();
+  auto bgItem = this->mainWin->QuickWindow()->findChild<QQuickItem *>(
+      "background");
+  if (nullptr == cardItem || !bgItem)
+    return;
+
+  QVariant splitName;
+  QMetaObject::invokeMethod(bgItem, "addSplitItem",
+      Q_RETURN_ARG(QVariant, splitName));
+
+  auto splitItem = bgItem->findChild<QQuickItem *>(splitName.toString());
+  if (!splitItem)
+  {
+    ignerr << "Internal error: failed to create split ["
+           << splitName.toString().toStdString() << "]" << std::endl;
+    return;
+  }
+  cardItem->setParentItem(splitItem);
+
+  // Saved configs list plugins in the main window's child order
+  _plugin->setParent(nullptr);
+  _plugin->setParent(this->mainWin);
+
+  std::rotate(it, it + 1, this->pluginsAdded.end());
+}
+
 /////////////////////////////////////////////////
 std::shared_ptr<Plugin> Application::PluginByName(
     const std::string &_pluginName) const
@@ -437,9 +1232,59 @@ bool Application::InitializeMainWindow()
 
   this->dataPtr->mainWin->setParent(this);
 
+  this->connect(this->dataPtr->mainWin->QuickWindow(),
+      &QQuickWindow::frameSwapped, this, [this]()
+      {
+        this->dataPtr->frameCount++;
+      }, Qt::DirectConnection);
+
   return true;
 }
 
+/////////////////////////////////////////////////
+bool Application::Headless() const
+{
+  return this->dataPtr->headless;
+}
+
+/////////////////////////////////////////////////
+bool Application::RenderFrame(int _timeout)
+{
+  if (!this->dataPtr->mainWin || !this->dataPtr->mainWin->QuickWindow())
+    return false;
+  auto window = this->dataPtr->mainWin->QuickWindow();
+
+  // Deliver what was queued before the frame, such as transport callbacks
+  // and property changes
+  this->processEvents();
+
+  if (!window->isExposed())
+    return false;
+
+  // Queued, because the frame may be swapped on the render thread
+  QEventLoop loop;
+  bool swapped{false};
+  auto connection = this->connect(window, &QQuickWindow::frameSwapped,
+      &loop, [&]()
+      {
+        swapped = true;
+        loop.quit();
+      }, Qt::QueuedConnection);
+  QTimer::singleShot(_timeout, &loop, &QEventLoop::quit);
+
+  window->update();
+  loop.exec();
+
+  this->disconnect(connection);
+  return swapped;
+}
+
+/////////////////////////////////////////////////
+uint64_t Application::FrameCount() const
+{
+  return this->dataPtr->frameCount;
+}
+
 /////////////////////////////////////////////////
 bool Application::ApplyConfig()
 {
@@ -584,47 +1429,22 @@ void Application::AddPluginPath(const std::string &_path)
 std::vector<std::pair<std::string, std::vector<std::string>>>
     Application::PluginList()
 {
-  // 1. Paths from env variable
-  auto paths = common::SystemPaths::PathsFromEnv(this->dataPtr->pluginPathEnv);
-
-  // 2. Paths added by calling addPluginPath
-  for (auto const &path : this->dataPtr->pluginPaths)
-    paths.push_back(path);
-
-  // 3. ~/.ignition/gui/plugins
-  std::string home;
-  common::env(IGN_HOMEDIR, home);
-  paths.push_back(home + "/.ignition/gui/plugins");
-
-  // 4. Install path
-  paths.push_back(IGN_GUI_PLUGIN_INSTALL_DIR);
+  this->dataPtr->RefreshPluginIndex();
 
-  // Populate map
   std::vector<std::pair<std::string, std::vector<std::string>>> plugins;
-
-  for (auto const &path : paths)
-  {
-    std::vector<std::string> ps;
-
-    common::DirIter endIter;
-    for (common::DirIter dirIter(path);
-        dirIter != endIter; ++dirIter)
-    {
-      auto plugin = common::basename(*dirIter);
-
-      // All we verify is that the file starts with "lib", any further
-      // checks would require loading the plugin.
-
-      if (plugin.find("lib") == 0)
-        ps.push_back(plugin);
-    }
-
-    plugins.push_back(std::make_pair(path, ps));
-  }
+  for (const auto &dir : this->dataPtr->pluginDirectories)
+    plugins.push_back(std::make_pair(dir.path, dir.files));
 
   return plugins;
 }
 
+/////////////////////////////////////////////////
+std::vector<std::string> Application::PluginDisplayNames()
+{
+  this->dataPtr->RefreshPluginIndex();
+  return this->dataPtr->pluginDisplayNames;
+}
+
 /////////////////////////////////////////////////
 void Application::OnPluginClose()
 {
@@ -635,6 +1455,12 @@ void Application::OnPluginClose()
 /////////////////////////////////////////////////
 void Application::RemovePlugin(std::shared_ptr<Plugin> _plugin)
 {
+  // Hooks may be running on the render thread, and must not outlive the
+  // derived plugin
+  _plugin->RemoveCallbacks();
+
+  this->dataPtr->pluginConfigs.erase(_plugin.get());
+
   this->dataPtr->pluginsAdded.erase(std::remove(
       this->dataPtr->pluginsAdded.begin(),
       this->dataPtr->pluginsAdded.end(), _plugin),
@@ -17,7 +17,17 @@
 
 #include <stdlib.h>
 #include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
 #include <ignition/utilities/ExtraTestMacros.hh>
 
 #include "test_config.h"  // NOLINT(build/include)
@@ -25,6 +35,7 @@
 #include "ignition/gui/Dialog.hh"
 #include "ignition/gui/MainWindow.hh"
 #include "ignition/gui/Plugin.hh"
+#include "ignition/gui/RenderHooks.hh"
 
 int g_argc = 1;
 char* g_argv[] =
@@ -146,6 +157,50 @@ TEST(ApplicationTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadPlugin))
   }
 }
 
+//////////////////////////////////////////////////
+TEST(ApplicationTest,
+    IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(RemovePluginWhileRendering))
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  std::string pluginName;
+  app.connect(&app, &Application::PluginAdded, [&pluginName](
+      const QString &_pluginName)
+  {
+    pluginName = _pluginName.toStdString();
+  });
+
+  // Plugin with a render hook
+  EXPECT_TRUE(app.LoadPlugin("GridConfig"));
+  EXPECT_FALSE(pluginName.empty());
+  EXPECT_EQ(1u, renderHookStatistics().size());
+
+  // Render thread
+  std::atomic<bool> stop{false};
+  std::atomic<int> frames{0};
+  std::thread renderThread([&stop, &frames]()
+  {
+    while (!stop)
+    {
+      runRenderHooks(RenderPhase::kRender);
+      frames++;
+    }
+  });
+
+  for (int sleep = 0; frames < 10 && sleep < 100; ++sleep)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  // Hooks are removed before the plugin is destroyed
+  EXPECT_TRUE(app.RemovePlugin(pluginName));
+  EXPECT_TRUE(renderHookStatistics().empty());
+
+  stop = true;
+  renderThread.join();
+}
+
 //////////////////////////////////////////////////
 TEST(ApplicationTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadConfig))
 {
@@ -174,6 +229,87 @@ TEST(ApplicationTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadConfig))
   }
 }
 
+//////////////////////////////////////////////////
+TEST(ApplicationTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(SwitchConfig))
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  EXPECT_EQ(nullptr, qGuiApp);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const std::string firstPath{"/tmp/ign_gui_switch_first.config"};
+  std::ofstream(firstPath) <<
+      "<plugin filename=\"Publisher\"/>"
+      "<plugin filename=\"TopicEcho\"/>";
+
+  // Same publisher, formatted differently, and a different echo config
+  const std::string secondPath{"/tmp/ign_gui_switch_second.config"};
+  std::ofstream(secondPath) <<
+      "<plugin filename=\"Publisher\">\n</plugin>\n"
+      "<plugin filename=\"TopicEcho\">"
+        "<ignition-gui><title>Echo</title></ignition-gui>"
+      "</plugin>";
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  EXPECT_TRUE(app.LoadConfig(firstPath));
+  auto plugins = win->findChildren<Plugin *>();
+  ASSERT_EQ(2, plugins.count());
+
+  std::string publisherName, echoName;
+  for (auto plugin : plugins)
+  {
+    auto name = plugin->CardItem()->objectName().toStdString();
+    if (plugin->Title() == "Publisher")
+      publisherName = name;
+    else
+      echoName = name;
+  }
+  ASSERT_FALSE(publisherName.empty());
+  ASSERT_FALSE(echoName.empty());
+  auto publisher = app.PluginByName(publisherName);
+
+  // The publisher is kept, the echo is replaced
+  EXPECT_TRUE(app.LoadConfig(secondPath));
+  EXPECT_EQ(publisher, app.PluginByName(publisherName));
+  EXPECT_EQ(nullptr, app.PluginByName(echoName));
+
+  plugins = win->findChildren<Plugin *>();
+  int echoCount{0};
+  for (auto plugin : plugins)
+  {
+    if (plugin->Title() == "Echo")
+      echoCount++;
+  }
+  EXPECT_EQ(1, echoCount);
+
+  // Both are kept, and laid out in the new order
+  const std::string thirdPath{"/tmp/ign_gui_switch_third.config"};
+  std::ofstream(thirdPath) <<
+      "<plugin filename=\"TopicEcho\">"
+        "<ignition-gui><title>Echo</title></ignition-gui>"
+      "</plugin>"
+      "<plugin filename=\"Publisher\"/>";
+
+  auto echo = win->findChildren<Plugin *>()[1];
+  EXPECT_TRUE(app.LoadConfig(thirdPath));
+  EXPECT_EQ(publisher, app.PluginByName(publisherName));
+
+  plugins = win->findChildren<Plugin *>();
+  ASSERT_EQ(2, plugins.count());
+  EXPECT_EQ(echo, plugins[0]);
+  EXPECT_EQ(publisher.get(), plugins[1]);
+  EXPECT_NE(plugins[0]->CardItem()->parentItem(),
+      plugins[1]->CardItem()->parentItem());
+
+  ignition::common::removeFile(firstPath);
+  ignition::common::removeFile(secondPath);
+  ignition::common::removeFile(thirdPath);
+}
+
 //////////////////////////////////////////////////
 TEST(ApplicationTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadDefaultConfig))
 {
@@ -199,6 +335,111 @@ TEST(ApplicationTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadDefaultConfig))
   }
 }
 
+//////////////////////////////////////////////////
+TEST(ApplicationTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(QmlComponent))
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  EXPECT_EQ(nullptr, qGuiApp);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  EXPECT_EQ(nullptr, app.QmlComponent(""));
+
+  // Compiled once and cached
+  auto card = app.QmlComponent(":qml/IgnCard.qml");
+  ASSERT_NE(nullptr, card);
+  EXPECT_TRUE(card->isReady());
+  EXPECT_EQ(card, app.QmlComponent(":qml/IgnCard.qml"));
+
+  // Started without waiting
+  auto settings = app.QmlComponent(":qml/IgnCardSettings.qml", false);
+  ASSERT_NE(nullptr, settings);
+  settings = app.QmlComponent(":qml/IgnCardSettings.qml");
+  ASSERT_NE(nullptr, settings);
+  EXPECT_TRUE(settings->isReady());
+  EXPECT_EQ(settings, app.QmlComponent(":qml/IgnCardSettings.qml", false));
+
+  // Waiting doesn't process queued work
+  bool called{false};
+  QMetaObject::invokeMethod(&app, [&called]() {called = true;},
+      Qt::QueuedConnection);
+  app.QmlComponent(":qml/IgnSplit.qml", false);
+  auto split = app.QmlComponent(":qml/IgnSplit.qml");
+  ASSERT_NE(nullptr, split);
+  EXPECT_FALSE(split->isLoading());
+  EXPECT_FALSE(called);
+  QCoreApplication::processEvents();
+  EXPECT_TRUE(called);
+
+  // Missing file
+  auto missing = app.QmlComponent(":/Banana/Banana.qml");
+  ASSERT_NE(nullptr, missing);
+  EXPECT_TRUE(missing->isError());
+
+  // Instances of the same plugin share a component
+  EXPECT_TRUE(app.LoadPlugin("Publisher"));
+  auto publisher = app.QmlComponent(":/Publisher/Publisher.qml");
+  ASSERT_NE(nullptr, publisher);
+  EXPECT_TRUE(publisher->isReady());
+  EXPECT_TRUE(app.LoadPlugin("Publisher"));
+  EXPECT_EQ(publisher, app.QmlComponent(":/Publisher/Publisher.qml"));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  EXPECT_EQ(2, win->findChildren<Plugin *>().count());
+}
+
+//////////////////////////////////////////////////
+TEST(ApplicationTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(PluginIndex))
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  EXPECT_EQ(nullptr, qGuiApp);
+
+  Application app(g_argc, g_argv);
+
+  // Directory which doesn't exist yet
+  auto pluginPath = ignition::common::joinPaths("/tmp", "ign_gui_plugin_index");
+  ignition::common::removeAll(pluginPath);
+  app.AddPluginPath(pluginPath);
+
+  auto filesOnPath = [&]() -> std::vector<std::string>
+  {
+    for (const auto &path : app.PluginList())
+    {
+      if (path.first == pluginPath)
+        return path.second;
+    }
+    ADD_FAILURE() << "Missing path [" << pluginPath << "]";
+    return {};
+  };
+  EXPECT_TRUE(filesOnPath().empty());
+
+  // Picked up once the directory is created
+  ASSERT_TRUE(ignition::common::createDirectories(pluginPath));
+  std::ofstream(ignition::common::joinPaths(pluginPath, "libFakePlugin3D.so"));
+  EXPECT_EQ(std::vector<std::string>{"libFakePlugin3D.so"}, filesOnPath());
+
+  auto names = app.PluginDisplayNames();
+  EXPECT_NE(names.end(), std::find(names.begin(), names.end(),
+      "Fake Plugin 3D"));
+
+  // The directory is now watched, and scanned again once it changes
+  std::ofstream(ignition::common::joinPaths(pluginPath, "libOtherFake.so"));
+  std::ofstream(ignition::common::joinPaths(pluginPath, "notAPlugin.txt"));
+  for (int i = 0; i < 100 && filesOnPath().size() < 2; ++i)
+  {
+    QCoreApplication::processEvents();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(std::vector<std::string>({"libFakePlugin3D.so", "libOtherFake.so"}),
+      filesOnPath());
+
+  ignition::common::removeAll(pluginPath);
+}
+
 //////////////////////////////////////////////////
 TEST(ApplicationTest,
     IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(InitializeMainWindow))
@@ -360,3 +601,31 @@ TEST(ApplicationTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(messageHandler))
   qWarning("This came from qWarning");
   qCritical("This came from qCritical");
 }
+
+//////////////////////////////////////////////////
+TEST(ApplicationTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Headless))
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  EXPECT_EQ(nullptr, qGuiApp);
+
+  Application app(g_argc, g_argv, WindowType::kHeadless);
+  EXPECT_TRUE(app.Headless());
+  EXPECT_EQ("offscreen", QGuiApplication::platformName());
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  ASSERT_NE(nullptr, win->QuickWindow());
+
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+  EXPECT_TRUE(app.LoadPlugin("Publisher"));
+
+  // Each call renders a frame
+  ASSERT_TRUE(app.RenderFrame());
+  auto count = app.FrameCount();
+  EXPECT_GE(count, 1u);
+
+  for (int i = 0; i < 3; ++i)
+    EXPECT_TRUE(app.RenderFrame());
+  EXPECT_GE(app.FrameCount(), count + 3);
+}
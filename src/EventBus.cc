@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
+
+#include "ignition/gui/EventBus.hh"
+
+namespace ignition
+{
+  namespace gui
+  {
+    /// \brief A subscription to an event type.
+    struct EventSubscription
+    {
+      /// \brief Unique ID.
+      EventSubscriptionId id{0};
+
+      /// \brief Subscribed event type.
+      QEvent::Type type{QEvent::None};
+
+      /// \brief Function to call with each event.
+      std::function<void(const QEvent &)> callback;
+
+      /// \brief Function which copies an event, used to queue events.
+      std::function<QEvent *(const QEvent &)> copy;
+
+      /// \brief How events are delivered.
+      EventDelivery delivery{EventDelivery::kDirect};
+
+      /// \brief True to only deliver the latest pending event.
+      bool coalesce{false};
+
+      /// \brief Object which receives queued events.
+      QPointer<QObject> context;
+
+      /// \brief Held while the callback runs, so unsubscribing waits for
+      /// it. Recursive so that callbacks may unsubscribe themselves.
+      std::recursive_mutex callbackMutex;
+
+      /// \brief False once unsubscribed. Protected by callbackMutex.
+      bool active{true};
+
+      /// \brief Protects pending and scheduled.
+      std::mutex pendingMutex;
+
+      /// \brief Latest event waiting to be delivered, when coalescing.
+      std::shared_ptr<const QEvent> pending;
+
+      /// \brief True if a delivery of the pending event is queued.
+      bool scheduled{false};
+
+      /// \brief Call the callback, unless unsubscribed.
+      /// \param[in] _event Event to deliver.
+      void Deliver(const QEvent &_event)
+      {
+        std::lock_guard<std::recursive_mutex> lock(this->callbackMutex);
+        if (this->active)
+          this->callback(_event);
+      }
+
+      /// \brief Deliver the pending event, when coalescing.
+      void DeliverPending()
+      {
+        std::shared_ptr<const QEvent> event;
+        {
+          std::lock_guard<std::mutex> lock(this->pendingMutex);
+          event.swap(this->pending);
+          this->scheduled = false;
+        }
+        if (event)
+          this->Deliver(*event);
+      }
+    };
+
+    /// \brief Subscriptions to a type. Lists are replaced rather than
+    /// modified, so publishers can iterate them without holding a lock.
+    using EventSubscriptions =
+        std::vector<std::shared_ptr<EventSubscription>>;
+
+    /// \brief Thread which runs worker deliveries in order.
+    class EventWorker
+    {
+      /// \brief Stop the thread, dropping queued deliveries.
+      public: ~EventWorker()
+      {
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          this->stop = true;
+          this->tasks.clear();
+        }
+        this->condition.notify_all();
+        if (this->thread.joinable())
+          this->thread.join();
+      }
+
+      /// \brief Queue a delivery, starting the thread on first use.
+      /// \param[in] _task Delivery to run.
+      public: void Post(std::function<void()> _task)
+      {
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          if (this->stop)
+            return;
+          if (!this->thread.joinable())
+            this->thread = std::thread(&EventWorker::Run, this);
+          this->tasks.push_back(std::move(_task));
+        }
+        this->condition.notify_one();
+      }
+
+      /// \brief Thread function.
+      private: void Run()
+      {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        while (true)
+        {
+          this->condition.wait(lock, [this]
+              {
+                return this->stop || !this->tasks.empty();
+              });
+          if (this->stop)
+            return;
+
+          auto task = std::move(this->tasks.front());
+          this->tasks.pop_front();
+
+          lock.unlock();
+          task();
+          lock.lock();
+        }
+      }
+
+      /// \brief Protects tasks and stop.
+      private: std::mutex mutex;
+
+      /// \brief Notified when a task is queued or the worker stops.
+      private: std::condition_variable condition;
+
+      /// \brief Queued deliveries.
+      private: std::deque<std::function<void()>> tasks;
+
+      /// \brief True once stopping.
+      private: bool stop{false};
+
+      /// \brief Worker thread, started on first use.
+      private: std::thread thread;
+    };
+
+    /// \brief Registered subscriptions.
+    class EventBusRegistry
+    {
+      /// \brief Protects subscriptions and nextId.
+      public: std::mutex mutex;
+
+      /// \brief Subscriptions by event type.
+      public: std::unordered_map<int,
+          std::shared_ptr<const EventSubscriptions>> subscriptions;
+
+      /// \brief ID of the next subscription.
+      public: EventSubscriptionId nextId{1};
+
+      /// \brief Runs worker deliveries. Declared last so it stops first.
+      public: EventWorker worker;
+    };
+
+    /// \brief Get the process wide registry.
+    /// \return The registry.
+    static EventBusRegistry &registry()
+    {
+      static EventBusRegistry instance;
+      return instance;
+    }
+
+    /// \brief Queue a delivery to a subscription's context or the worker.
+    /// \param[in] _sub Subscription.
+    /// \param[in] _task Delivery to run.
+    static void post(const std::shared_ptr<EventSubscription> &_sub,
+        std::function<void()> _task)
+    {
+      if (_sub->delivery == EventDelivery::kWorker)
+      {
+        registry().worker.Post(std::move(_task));
+        return;
+      }
+
+      QObject *context = _sub->context;
+      if (nullptr == context)
+        return;
+      QMetaObject::invokeMethod(context, std::move(_task),
+          Qt::QueuedConnection);
+    }
+  }
+}
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+EventSubscriptionId ignition::gui::subscribeEvent(const QEvent::Type _type,
+    std::function<void(const QEvent &)> _callback,
+    std::function<QEvent *(const QEvent &)> _copy,
+    const EventDelivery _delivery, const bool _coalesce, QObject *_context)
+{
+  if (!_callback || !_copy)
+  {
+    ignerr << "Can't subscribe to event type [" << _type
+           << "] without a callback." << std::endl;
+    return 0;
+  }
+
+  if (_delivery == EventDelivery::kQueued && nullptr == _context)
+    _context = QCoreApplication::instance();
+
+  if (_delivery == EventDelivery::kQueued && nullptr == _context)
+  {
+    ignerr << "Can't subscribe to event type [" << _type
+           << "] with queued delivery without a context or application."
+           << std::endl;
+    return 0;
+  }
+
+  auto sub = std::make_shared<EventSubscription>();
+  sub->type = _type;
+  sub->callback = std::move(_callback);
+  sub->copy = std::move(_copy);
+  sub->delivery = _delivery;
+  sub->coalesce = _coalesce && _delivery != EventDelivery::kDirect;
+  sub->context = _context;
+
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  sub->id = reg.nextId++;
+
+  auto &current = reg.subscriptions[_type];
+  auto subs = current ? std::make_shared<EventSubscriptions>(*current) :
+      std::make_shared<EventSubscriptions>();
+  subs->push_back(sub);
+  current = subs;
+
+  return sub->id;
+}
+
+/////////////////////////////////////////////////
+bool ignition::gui::unsubscribeEvent(const EventSubscriptionId _id)
+{
+  std::shared_ptr<EventSubscription> sub;
+  {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto typeIt = reg.subscriptions.begin();
+        typeIt != reg.subscriptions.end(); ++typeIt)
+    {
+      const auto &current = *typeIt->second;
+      auto it = std::find_if(current.begin(), current.end(),
+          [&_id](const std::shared_ptr<EventSubscription> &_sub)
+          {
+            return _sub->id == _id;
+          });
+      if (it == current.end())
+        continue;
+
+      sub = *it;
+      auto subs = std::make_shared<EventSubscriptions>(current);
+      subs->erase(subs->begin() + (it - current.begin()));
+      // Erasing invalidates typeIt, so stop looking
+      if (subs->empty())
+        reg.subscriptions.erase(typeIt);
+      else
+        typeIt->second = subs;
+      break;
+    }
+  }
+
+  if (!sub)
+    return false;
+
+  // Publishers may still hold the old list, and queued deliveries the
+  // subscription, so make sure neither calls it anymore.
+  std::lock_guard<std::recursive_mutex> lock(sub->callbackMutex);
+  sub->active = false;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::publishEvent(const QEvent &_event)
+{
+  std::shared_ptr<const EventSubscriptions> subs;
+  {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto it = reg.subscriptions.find(_event.type());
+    if (it == reg.subscriptions.end())
+      return;
+    subs = it->second;
+  }
+
+  IGN_PROFILE("publishEvent");
+
+  // Copied once for all queued subscribers, and only if there are any
+  std::shared_ptr<const QEvent> copy;
+  for (const auto &sub : *subs)
+  {
+    if (sub->delivery == EventDelivery::kDirect)
+    {
+      sub->Deliver(_event);
+      continue;
+    }
+
+    if (!copy)
+      copy.reset(sub->copy(_event));
+
+    if (!sub->coalesce)
+    {
+      post(sub, [sub, copy]() {sub->Deliver(*copy);});
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(sub->pendingMutex);
+      sub->pending = copy;
+      if (sub->scheduled)
+        continue;
+      sub->scheduled = true;
+    }
+    post(sub, [sub]() {sub->DeliverPending();});
+  }
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/EventBus.hh"
+#include "ignition/gui/GuiEvents.hh"
+#include "ignition/gui/MainWindow.hh"
+#include "ignition/gui/Plugin.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./EventBus_TEST")),
+};
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(EventBusTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Direct))
+{
+  std::vector<double> clicks;
+  auto clickId = subscribeEvent<events::LeftClickToScene>(
+      [&clicks](const events::LeftClickToScene &_event)
+      {
+        clicks.push_back(_event.Point().X());
+      });
+  EXPECT_NE(0u, clickId);
+
+  int blocks{0};
+  auto blockId = subscribeEvent<events::BlockOrbit>(
+      [&blocks](const events::BlockOrbit &)
+      {
+        blocks++;
+      });
+  EXPECT_NE(0u, blockId);
+
+  // Only subscribers of the event's type are called, synchronously
+  publishEvent(events::LeftClickToScene(math::Vector3d(1, 0, 0)));
+  publishEvent(events::LeftClickToScene(math::Vector3d(2, 0, 0)));
+  EXPECT_EQ(std::vector<double>({1, 2}), clicks);
+  EXPECT_EQ(0, blocks);
+
+  publishEvent(events::BlockOrbit(true));
+  EXPECT_EQ(1, blocks);
+
+  // Unsubscribed callbacks aren't called
+  EXPECT_TRUE(unsubscribeEvent(clickId));
+  EXPECT_FALSE(unsubscribeEvent(clickId));
+  publishEvent(events::LeftClickToScene(math::Vector3d(3, 0, 0)));
+  EXPECT_EQ(2u, clicks.size());
+
+  EXPECT_TRUE(unsubscribeEvent(blockId));
+
+  // Subscriptions need a callback
+  EXPECT_EQ(0u, subscribeEvent<events::BlockOrbit>(nullptr));
+}
+
+/////////////////////////////////////////////////
+TEST(EventBusTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Queued))
+{
+  Application app(g_argc, g_argv, WindowType::kDialog);
+
+  std::vector<double> all;
+  auto allId = subscribeEvent<events::LeftClickToScene>(
+      [&all](const events::LeftClickToScene &_event)
+      {
+        all.push_back(_event.Point().X());
+      }, EventDelivery::kQueued);
+
+  std::vector<double> latest;
+  auto latestId = subscribeEvent<events::LeftClickToScene>(
+      [&latest](const events::LeftClickToScene &_event)
+      {
+        latest.push_back(_event.Point().X());
+      }, EventDelivery::kQueued, true);
+
+  // Delivered once the event loop runs
+  for (int i = 1; i <= 3; ++i)
+    publishEvent(events::LeftClickToScene(math::Vector3d(i, 0, 0)));
+  EXPECT_TRUE(all.empty());
+  EXPECT_TRUE(latest.empty());
+
+  QCoreApplication::processEvents();
+  EXPECT_EQ(std::vector<double>({1, 2, 3}), all);
+  EXPECT_EQ(std::vector<double>({3}), latest);
+
+  // Queued events aren't delivered after unsubscribing
+  publishEvent(events::LeftClickToScene(math::Vector3d(4, 0, 0)));
+  EXPECT_TRUE(unsubscribeEvent(allId));
+  EXPECT_TRUE(unsubscribeEvent(latestId));
+  QCoreApplication::processEvents();
+  EXPECT_EQ(3u, all.size());
+  EXPECT_EQ(1u, latest.size());
+}
+
+/////////////////////////////////////////////////
+TEST(EventBusTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Worker))
+{
+  std::atomic<int> count{0};
+  std::thread::id threadId;
+  auto id = subscribeEvent<events::BlockOrbit>(
+      [&count, &threadId](const events::BlockOrbit &)
+      {
+        threadId = std::this_thread::get_id();
+        count++;
+      }, EventDelivery::kWorker);
+
+  for (int i = 0; i < 5; ++i)
+    publishEvent(events::BlockOrbit(true));
+
+  for (int sleep = 0; count < 5 && sleep < 100; ++sleep)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  EXPECT_TRUE(unsubscribeEvent(id));
+  EXPECT_EQ(5, count);
+  EXPECT_NE(std::this_thread::get_id(), threadId);
+}
+
+/////////////////////////////////////////////////
+TEST(EventBusTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(MainWindow))
+{
+  Application app(g_argc, g_argv);
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  {
+    // Plugin subscriptions are removed with the plugin
+    class BlockPlugin : public Plugin
+    {
+      public: BlockPlugin()
+      {
+        this->SubscribeEvent<events::BlockOrbit>(
+            [this](const events::BlockOrbit &_event)
+            {
+              this->blocked = _event.Block();
+            });
+      }
+      public: ~BlockPlugin() override
+      {
+        // Not owned by the application
+        this->RemoveCallbacks();
+      }
+      public: bool blocked{false};
+    };
+
+    BlockPlugin plugin;
+
+    // Events sent to the main window are published
+    events::BlockOrbit event(true);
+    app.sendEvent(win, &event);
+    EXPECT_TRUE(plugin.blocked);
+  }
+
+  events::BlockOrbit event(false);
+  app.sendEvent(win, &event);
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+
+#include <ignition/common/Console.hh>
+
+#include "ignition/gui/Instrumentation.hh"
+#include "ignition/gui/Plugin.hh"
+
+namespace ignition
+{
+  namespace gui
+  {
+    /// \brief Bit set while instrumentation is enabled explicitly.
+    static constexpr unsigned int kInstrumentationExplicit{1u};
+
+    /// \brief Step of the count of acquireInstrumentation users, which is
+    /// kept above the explicit bit.
+    static constexpr unsigned int kInstrumentationUser{2u};
+
+    /// \brief Explicit bit and count of users. Instrumentation is enabled
+    /// while it's not zero.
+    static std::atomic<unsigned int> g_instrumentationState{0u};
+  }
+}
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+bool ignition::gui::instrumentationEnabled()
+{
+  return g_instrumentationState.load(std::memory_order_relaxed) != 0u;
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::setInstrumentationEnabled(const bool _enabled)
+{
+  if (_enabled)
+    g_instrumentationState.fetch_or(kInstrumentationExplicit);
+  else
+    g_instrumentationState.fetch_and(~kInstrumentationExplicit);
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::acquireInstrumentation()
+{
+  g_instrumentationState.fetch_add(kInstrumentationUser);
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::releaseInstrumentation()
+{
+  auto state = g_instrumentationState.load();
+  do
+  {
+    if (state < kInstrumentationUser)
+    {
+      ignerr << "Instrumentation released more times than it was acquired"
+             << std::endl;
+      return;
+    }
+  }
+  while (!g_instrumentationState.compare_exchange_weak(state,
+      state - kInstrumentationUser));
+}
+
+/////////////////////////////////////////////////
+ScopedHandlerTimer::ScopedHandlerTimer(Plugin *_plugin, const char *_name)
+{
+  if (nullptr == _plugin || !instrumentationEnabled())
+    return;
+
+  this->plugin = _plugin;
+  this->name = _name;
+  this->start = std::chrono::steady_clock::now();
+}
+
+/////////////////////////////////////////////////
+ScopedHandlerTimer::~ScopedHandlerTimer()
+{
+  if (nullptr == this->plugin)
+    return;
+
+  this->plugin->RecordHandler(this->name,
+      std::chrono::steady_clock::now() - this->start);
+}
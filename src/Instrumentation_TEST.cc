@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Instrumentation.hh"
+#include "ignition/gui/Plugin.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(InstrumentationTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Disabled))
+{
+  setInstrumentationEnabled(false);
+  EXPECT_FALSE(instrumentationEnabled());
+
+  Plugin plugin;
+  {
+    IGN_GUI_PROFILE_HANDLER(&plugin, "handler");
+  }
+  plugin.RecordHandler("other", std::chrono::milliseconds(1));
+  plugin.RecordQueueDepth("queue", 3);
+
+  EXPECT_TRUE(plugin.HandlerStatistics().empty());
+  EXPECT_TRUE(plugin.QueueStatistics().empty());
+
+  // Null plugin
+  setInstrumentationEnabled(true);
+  {
+    ScopedHandlerTimer timer(nullptr, "handler");
+  }
+  setInstrumentationEnabled(false);
+}
+
+/////////////////////////////////////////////////
+TEST(InstrumentationTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Handlers))
+{
+  setInstrumentationEnabled(true);
+  EXPECT_TRUE(instrumentationEnabled());
+
+  Plugin plugin;
+  for (int i = 0; i < 3; ++i)
+  {
+    IGN_GUI_PROFILE_HANDLER(&plugin, "sleep");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  plugin.RecordHandler("direct", std::chrono::milliseconds(5));
+  plugin.RecordHandler("direct", std::chrono::milliseconds(1));
+
+  // Sorted by name
+  auto stats = plugin.HandlerStatistics();
+  ASSERT_EQ(2u, stats.size());
+
+  EXPECT_EQ("direct", stats[0].name);
+  EXPECT_EQ(2u, stats[0].count);
+  EXPECT_EQ(std::chrono::milliseconds(6), stats[0].total);
+  EXPECT_EQ(std::chrono::milliseconds(5), stats[0].max);
+
+  EXPECT_EQ("sleep", stats[1].name);
+  EXPECT_EQ(3u, stats[1].count);
+  EXPECT_LE(std::chrono::milliseconds(6), stats[1].total);
+  EXPECT_LE(std::chrono::milliseconds(2), stats[1].max);
+  EXPECT_GE(stats[1].total, stats[1].max);
+
+  // Handlers can be recorded from other threads
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&plugin]()
+    {
+      for (int j = 0; j < 100; ++j)
+        plugin.RecordHandler("threads", std::chrono::microseconds(1));
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  stats = plugin.HandlerStatistics();
+  ASSERT_EQ(3u, stats.size());
+  EXPECT_EQ("threads", stats[2].name);
+  EXPECT_EQ(400u, stats[2].count);
+
+  plugin.ResetStatistics();
+  EXPECT_TRUE(plugin.HandlerStatistics().empty());
+
+  setInstrumentationEnabled(false);
+}
+
+/////////////////////////////////////////////////
+TEST(InstrumentationTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Queues))
+{
+  setInstrumentationEnabled(true);
+
+  Plugin plugin;
+  plugin.RecordQueueDepth("queue", 3);
+  plugin.RecordQueueDepth("queue", 10);
+  plugin.RecordQueueDepth("queue", 4);
+  plugin.RecordQueueDepth("another", 0);
+
+  auto stats = plugin.QueueStatistics();
+  ASSERT_EQ(2u, stats.size());
+
+  EXPECT_EQ("another", stats[0].name);
+  EXPECT_EQ(0u, stats[0].depth);
+  EXPECT_EQ(0u, stats[0].maxDepth);
+
+  EXPECT_EQ("queue", stats[1].name);
+  EXPECT_EQ(4u, stats[1].depth);
+  EXPECT_EQ(10u, stats[1].maxDepth);
+
+  plugin.ResetStatistics();
+  EXPECT_TRUE(plugin.QueueStatistics().empty());
+
+  setInstrumentationEnabled(false);
+}
+
+/////////////////////////////////////////////////
+TEST(InstrumentationTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Acquire))
+{
+  setInstrumentationEnabled(false);
+  EXPECT_FALSE(instrumentationEnabled());
+
+  // Enabled while any user holds it
+  acquireInstrumentation();
+  acquireInstrumentation();
+  EXPECT_TRUE(instrumentationEnabled());
+
+  releaseInstrumentation();
+  EXPECT_TRUE(instrumentationEnabled());
+
+  releaseInstrumentation();
+  EXPECT_FALSE(instrumentationEnabled());
+
+  // Releasing too many times doesn't affect later users
+  releaseInstrumentation();
+  EXPECT_FALSE(instrumentationEnabled());
+  acquireInstrumentation();
+  EXPECT_TRUE(instrumentationEnabled());
+
+  // Disabling explicitly doesn't affect users
+  setInstrumentationEnabled(true);
+  setInstrumentationEnabled(false);
+  EXPECT_TRUE(instrumentationEnabled());
+
+  // Releasing doesn't disable an explicit enable
+  setInstrumentationEnabled(true);
+  releaseInstrumentation();
+  EXPECT_TRUE(instrumentationEnabled());
+
+  setInstrumentationEnabled(false);
+  EXPECT_FALSE(instrumentationEnabled());
+}
@@ -16,12 +16,16 @@
  */
 
 #include <tinyxml2.h>
-#include <regex>
+#include <algorithm>
+#include <functional>
+#include <future>
 #include <string>
+#include <unordered_map>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Filesystem.hh>
 #include "ignition/gui/Application.hh"
+#include "ignition/gui/EventBus.hh"
 #include "ignition/gui/MainWindow.hh"
 #include "ignition/gui/Plugin.hh"
 #include "ignition/gui/qt.h"
@@ -50,6 +54,20 @@ namespace ignition
 
       /// \brief Show the confirmation dialog on exit
       public: bool showDialogOnExit{false};
+
+      /// \brief Latest config save. Each save waits for the previous one,
+      /// so files are written in the order saves were requested.
+      public: std::shared_future<bool> lastSave;
+
+      /// \brief Hash of the config last written to each path. Only
+      /// accessed by saves, which run one at a time.
+      public: std::unordered_map<std::string, size_t> savedHashes;
+
+      /// \brief Triggers autosaves.
+      public: QTimer autosaveTimer;
+
+      /// \brief File which autosaves write to.
+      public: std::string autosavePath;
     };
   }
 }
@@ -66,10 +84,39 @@ std::string dirName(const std::string &_path)
   return _path.substr(0, found);
 }
 
+/// \brief Write a file through a temporary file in the same directory,
+/// which replaces the file once fully written. Readers and crashes never
+/// see a partially written file.
+/// \param[in] _path File path.
+/// \param[in] _content Content to write.
+/// \param[out] _error Error message on failure.
+/// \return True if successful.
+static bool writeFileAtomically(const std::string &_path,
+    const std::string &_content, std::string &_error)
+{
+  QSaveFile file(QString::fromStdString(_path));
+  if (!file.open(QIODevice::WriteOnly))
+  {
+    _error = file.errorString().toStdString();
+    return false;
+  }
+
+  file.write(_content.data(), static_cast<qint64>(_content.size()));
+  if (!file.commit())
+  {
+    _error = file.errorString().toStdString();
+    return false;
+  }
+  return true;
+}
+
 /////////////////////////////////////////////////
 MainWindow::MainWindow()
   : dataPtr(new MainWindowPrivate)
 {
+  connect(&this->dataPtr->autosaveTimer, &QTimer::timeout, this,
+      &MainWindow::Autosave);
+
   // Make MainWindow functions available from all QML files (using root)
   App()->Engine()->rootContext()->setContextProperty("MainWindow", this);
 
@@ -92,33 +139,35 @@ MainWindow::MainWindow()
 /////////////////////////////////////////////////
 MainWindow::~MainWindow()
 {
+  // Don't leave pending saves behind
+  if (this->dataPtr->lastSave.valid())
+    this->dataPtr->lastSave.wait();
+}
+
+/////////////////////////////////////////////////
+bool MainWindow::event(QEvent *_event)
+{
+  // GUI events are user types, Qt's own events aren't published
+  if (_event->type() >= QEvent::User)
+    publishEvent(*_event);
+
+  return QObject::event(_event);
 }
 
 /////////////////////////////////////////////////
 QStringList MainWindow::PluginListModel() const
 {
   QStringList pluginNames;
-  auto plugins = App()->PluginList();
-  for (auto const &path : plugins)
+  for (auto const &pluginName : App()->PluginDisplayNames())
   {
-    for (auto const &plugin : path.second)
+    // Show?
+    if (this->dataPtr->windowConfig.pluginsFromPaths ||
+        std::find(this->dataPtr->windowConfig.showPlugins.begin(),
+                  this->dataPtr->windowConfig.showPlugins.end(),
+                  pluginName) !=
+                  this->dataPtr->windowConfig.showPlugins.end())
     {
-      // Remove lib and .so
-      auto pluginName = plugin.substr(3, plugin.find(".") - 3);
-
-      // Split WWWCamelCase3D -> WWW Camel Case 3D
-      std::regex reg("(\\B[A-Z][a-z])|(\\B[0-9])");
-      pluginName = std::regex_replace(pluginName, reg, " $&");
-
-      // Show?
-      if (this->dataPtr->windowConfig.pluginsFromPaths ||
-          std::find(this->dataPtr->windowConfig.showPlugins.begin(),
-                    this->dataPtr->windowConfig.showPlugins.end(),
-                    pluginName) !=
-                    this->dataPtr->windowConfig.showPlugins.end())
-      {
-        pluginNames.append(QString::fromStdString(pluginName));
-      }
+      pluginNames.append(QString::fromStdString(pluginName));
     }
   }
 
@@ -143,13 +192,13 @@ void MainWindow::OnLoadConfig(const QString &_path)
   if (localPath.isEmpty())
     localPath = _path;
 
-  App()->LoadConfig(localPath.toStdString());
+  App()->LoadConfigAsync(localPath.toStdString());
 }
 
 /////////////////////////////////////////////////
 void MainWindow::OnSaveConfig()
 {
-  this->SaveConfig(App()->DefaultConfigPath());
+  this->SaveConfigAsync(App()->DefaultConfigPath());
 }
 
 /////////////////////////////////////////////////
@@ -158,34 +207,117 @@ void MainWindow::OnSaveConfigAs(const QString &_path)
   auto localPath = QUrl(_path).toLocalFile();
   if (localPath.isEmpty())
     localPath = _path;
-  this->SaveConfig(localPath.toStdString());
+  this->SaveConfigAsync(localPath.toStdString());
 }
 
 /////////////////////////////////////////////////
 void MainWindow::SaveConfig(const std::string &_path)
 {
+  this->SaveConfigAsync(_path).wait();
+}
+
+/////////////////////////////////////////////////
+std::shared_future<bool> MainWindow::SaveConfigAsync(const std::string &_path)
+{
+  // Plugins are queried on the GUI thread, everything else happens on the
+  // worker
   this->dataPtr->windowConfig = this->CurrentWindowConfig();
+  return this->QueueConfigSave(_path, false);
+}
 
-  // Create the intermediate directories if needed.
-  // We check for errors when we try to open the file.
-  auto dirname = dirName(_path);
-  ignition::common::createDirectories(dirname);
+/////////////////////////////////////////////////
+void MainWindow::SetAutosave(const std::string &_path,
+    const std::chrono::milliseconds _interval)
+{
+  this->dataPtr->autosavePath = _path;
 
-  // Open the file
-  std::ofstream out(_path.c_str(), std::ios::out);
-  if (!out)
+  if (_path.empty() || _interval.count() <= 0)
   {
-    std::string str = "Unable to open file: " + _path;
-    str += ".\nCheck file permissions.";
-    this->notify(QString::fromStdString(str));
+    this->dataPtr->autosaveTimer.stop();
+    return;
   }
-  else
-    out << this->dataPtr->windowConfig.XMLString();
 
-  std::string msg("Saved configuration to <b>" + _path + "</b>");
+  this->dataPtr->autosaveTimer.start(static_cast<int>(_interval.count()));
+}
+
+/////////////////////////////////////////////////
+void MainWindow::Autosave()
+{
+  // A config being loaded would be saved half loaded
+  if (App()->LoadingConfig())
+    return;
+
+  // Skip this round if the disk can't keep up
+  auto &lastSave = this->dataPtr->lastSave;
+  if (lastSave.valid() && lastSave.wait_for(std::chrono::seconds(0)) !=
+      std::future_status::ready)
+  {
+    return;
+  }
+
+  this->dataPtr->windowConfig = this->CurrentWindowConfig();
+  this->QueueConfigSave(this->dataPtr->autosavePath, true);
+}
+
+/////////////////////////////////////////////////
+std::shared_future<bool> MainWindow::QueueConfigSave(const std::string &_path,
+    const bool _autosave)
+{
+  auto config = this->dataPtr->windowConfig;
+  auto previous = this->dataPtr->lastSave;
+
+  this->dataPtr->lastSave = std::async(std::launch::async,
+      [this, config, _path, _autosave, previous]() -> bool
+  {
+    if (previous.valid())
+      previous.wait();
+
+    auto xml = config.XMLString();
+
+    // Autosaves only write configs which changed since the last save
+    auto hash = std::hash<std::string>()(xml);
+    auto &savedHashes = this->dataPtr->savedHashes;
+    auto saved = savedHashes.find(_path);
+    if (_autosave && saved != savedHashes.end() && saved->second == hash)
+      return true;
+
+    // Create the intermediate directories if needed.
+    // We check for errors when we try to open the file.
+    auto dirname = dirName(_path);
+    ignition::common::createDirectories(dirname);
+
+    std::string error;
+    if (!writeFileAtomically(_path, xml, error))
+    {
+      ignerr << "Failed to save configuration to [" << _path << "]: "
+             << error << std::endl;
+
+      std::string str = "Unable to open file: " + _path;
+      str += ".\nCheck file permissions.";
+      QMetaObject::invokeMethod(this, [this, str]()
+      {
+        this->notify(QString::fromStdString(str));
+      }, Qt::QueuedConnection);
+      return false;
+    }
+    savedHashes[_path] = hash;
+
+    if (_autosave)
+    {
+      igndbg << "Autosaved configuration to [" << _path << "]" << std::endl;
+      return true;
+    }
+
+    std::string msg("Saved configuration to <b>" + _path + "</b>");
+    ignmsg << msg << std::endl;
+    QMetaObject::invokeMethod(this, [this, msg]()
+    {
+      this->notify(QString::fromStdString(msg));
+    }, Qt::QueuedConnection);
+    return true;
+  }).share();
 
-  this->notify(QString::fromStdString(msg));
-  ignmsg << msg << std::endl;
+  return this->dataPtr->lastSave;
 }
 
 /////////////////////////////////////////////////
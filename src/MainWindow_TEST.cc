@@ -16,6 +16,10 @@
 */
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
 #include <thread>
 
 #include <ignition/common/Console.hh>
@@ -65,8 +69,13 @@ TEST(MainWindowTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(OnSaveConfig))
 
   // Save to default location
   {
-    // Trigger save
+    // Trigger save, the file appears once it's fully written
     mainWindow->OnSaveConfig();
+    for (int sleep = 0; !QFile::exists(QString::fromStdString(
+        kTestConfigFile)) && sleep < 100; ++sleep)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
 
     // Check saved file
     QFile saved(QString::fromStdString(kTestConfigFile));
@@ -98,8 +107,13 @@ TEST(MainWindowTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(SaveConfigAs))
 
   // Save to file
   {
-    // Trigger save
+    // Trigger save, the file appears once it's fully written
     mainWindow->OnSaveConfigAs(QString::fromStdString(kTestConfigFile));
+    for (int sleep = 0; !QFile::exists(QString::fromStdString(
+        kTestConfigFile)) && sleep < 100; ++sleep)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
 
     // Check saved file
     QFile saved(QString::fromStdString(kTestConfigFile));
@@ -140,12 +154,31 @@ TEST(MainWindowTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(OnLoadConfig))
   auto plugins = mainWindow->findChildren<Plugin *>();
   EXPECT_EQ(plugins.size(), 0);
 
+  // Configs are read in the background and applied on this thread
+  int loaded{0};
+  QObject::connect(&app, &Application::ConfigLoaded,
+      [&loaded](const QString &, bool _success)
+      {
+        EXPECT_TRUE(_success);
+        loaded++;
+      });
+  auto waitForLoad = [&loaded](int _count)
+  {
+    for (int sleep = 0; loaded < _count && sleep < 100; ++sleep)
+    {
+      QCoreApplication::processEvents();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(_count, loaded);
+  };
+
   // Load file with single plugin
   {
     // Trigger load
     auto path = QString::fromStdString(
           std::string(PROJECT_SOURCE_PATH) + "/test/config/test.config");
     mainWindow->OnLoadConfig(path);
+    waitForLoad(1);
 
     // Check window has 1 plugin
     plugins = mainWindow->findChildren<Plugin *>();
@@ -158,11 +191,37 @@ TEST(MainWindowTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(OnLoadConfig))
     auto path = QString::fromStdString(
           std::string(PROJECT_SOURCE_PATH) + "/test/config/state.config");
     mainWindow->OnLoadConfig(path);
+    waitForLoad(2);
 
     // Check window has 2 plugins
     plugins = mainWindow->findChildren<Plugin *>();
     EXPECT_EQ(2, plugins.size());
   }
+
+  // Configs requested while one is being loaded are applied after it, and
+  // synchronous loads are rejected meanwhile
+  {
+    auto testPath = std::string(PROJECT_SOURCE_PATH) +
+        "/test/config/test.config";
+    auto statePath = std::string(PROJECT_SOURCE_PATH) +
+        "/test/config/state.config";
+    mainWindow->OnLoadConfig(QString::fromStdString(testPath));
+    mainWindow->OnLoadConfig(QString::fromStdString(statePath));
+
+    for (int sleep = 0; !app.LoadingConfig() && sleep < 100; ++sleep)
+    {
+      QCoreApplication::processEvents();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(app.LoadingConfig());
+    EXPECT_FALSE(app.LoadConfig(statePath));
+
+    waitForLoad(4);
+    EXPECT_FALSE(app.LoadingConfig());
+
+    plugins = mainWindow->findChildren<Plugin *>();
+    EXPECT_EQ(2, plugins.size());
+  }
 }
 
 /////////////////////////////////////////////////
@@ -197,6 +256,73 @@ TEST(MainWindowTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(OnAddPlugin))
   EXPECT_EQ(plugins.size(), 2);
 }
 
+/////////////////////////////////////////////////
+TEST(MainWindowTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Autosave))
+{
+  ignition::common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+  App()->AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  auto mainWindow = App()->findChild<MainWindow *>();
+  ASSERT_NE(nullptr, mainWindow);
+
+  auto path = QString::fromStdString(kTestConfigFile);
+  std::remove(kTestConfigFile.c_str());
+
+  auto waitForFile = [&path]()
+  {
+    for (int sleep = 0; !QFile::exists(path) && sleep < 100; ++sleep)
+    {
+      QCoreApplication::processEvents();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return QFile::exists(path);
+  };
+
+  // Explicit saves always write
+  EXPECT_TRUE(mainWindow->SaveConfigAsync(kTestConfigFile).get());
+  EXPECT_TRUE(QFile::exists(path));
+  std::remove(kTestConfigFile.c_str());
+  EXPECT_TRUE(mainWindow->SaveConfigAsync(kTestConfigFile).get());
+  EXPECT_TRUE(QFile::exists(path));
+
+  // Autosaves don't write an unchanged config
+  std::remove(kTestConfigFile.c_str());
+  mainWindow->SetAutosave(kTestConfigFile, std::chrono::milliseconds(10));
+  EXPECT_FALSE(waitForFile());
+
+  // They write once it changes
+  mainWindow->OnAddPlugin("TestPlugin");
+  ASSERT_TRUE(waitForFile());
+
+  QFile saved(path);
+  ASSERT_TRUE(saved.open(QFile::ReadOnly));
+  EXPECT_TRUE(QString(saved.readAll()).contains("TestPlugin"));
+
+  // Disabled
+  mainWindow->SetAutosave(kTestConfigFile, std::chrono::milliseconds(0));
+  std::remove(kTestConfigFile.c_str());
+  mainWindow->OnAddPlugin("TestPlugin");
+  EXPECT_FALSE(waitForFile());
+
+  // Enabled from the window config
+  std::string autosaveConfig = "/tmp/ign-gui-autosave-test.config";
+  {
+    std::ofstream file(autosaveConfig);
+    file << "<window><autosave path=\"" << kTestConfigFile
+         << "\">0.01</autosave></window>";
+  }
+  EXPECT_TRUE(app.LoadConfig(autosaveConfig));
+  std::remove(autosaveConfig.c_str());
+  mainWindow->OnAddPlugin("TestPlugin");
+  EXPECT_TRUE(waitForFile());
+  mainWindow->SetAutosave(kTestConfigFile, std::chrono::milliseconds(0));
+  std::remove(kTestConfigFile.c_str());
+
+  // Saving to an invalid path fails
+  EXPECT_FALSE(mainWindow->SaveConfigAsync("/proc/ign-gui.config").get());
+}
+
 /////////////////////////////////////////////////
 TEST(WindowConfigTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(defaultValues))
 {
@@ -15,7 +15,16 @@
  *
 */
 
+#include <chrono>
+#include <mutex>
 #include <sstream>
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <ignition/msgs/Factory.hh>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
 #include <ignition/common/Console.hh>
 #include <ignition/common/StringUtils.hh>
 #include <ignition/transport/Node.hh>
@@ -24,6 +33,7 @@
 
 #include "ignition/gui/PlottingInterface.hh"
 #include "ignition/gui/Application.hh"
+#include "ignition/gui/RawMessage.hh"
 
 #define DEFAULT_TIME (INT_MIN)
 // 1/60 Period like the GuiSystem frequency (60Hz)
@@ -55,6 +65,41 @@ class TopicPrivate
   public: double FieldData(const google::protobuf::Message &_msg,
                            const google::protobuf::FieldDescriptor *_field);
 
+  /// \brief Check if a msg should be plotted, limiting the plotting
+  /// frequency, and update the last header time.
+  /// \param[in] _hasHeader True if the msg has a header
+  /// \param[in, out] _headerTime Header time if it has a header, set to the
+  /// default time otherwise
+  /// \return True if the msg should be plotted
+  public: bool UpdateTime(bool _hasHeader, double &_headerTime);
+
+  /// \brief Create the reader for serialized msgs of a type, with the
+  /// registered fields and the header stamp
+  /// \param[in] _msgType msg type
+  public: void CreateReader(const std::string &_msgType);
+
+  /// \brief Reads the registered fields from serialized msgs
+  public: std::unique_ptr<RawFieldReader> reader;
+
+  /// \brief Msg type of the reader
+  public: std::string readerType;
+
+  /// \brief True if the registered fields changed since the reader was
+  /// created
+  public: bool readerDirty = true;
+
+  /// \brief Reader index of each registered field
+  public: std::map<std::string, int> fieldIndices;
+
+  /// \brief Reader index of the header
+  public: int headerIndex = -1;
+
+  /// \brief Reader index of the header stamp seconds
+  public: int secIndex = -1;
+
+  /// \brief Reader index of the header stamp nanoseconds
+  public: int nsecIndex = -1;
+
   /// \brief Topic name
   public: std::string name;
 
@@ -66,6 +111,10 @@ class TopicPrivate
 
   /// \brief Plotting fields to update its values
   public: std::map<std::string, ignition::gui::PlotData*> fields;
+
+  /// \brief Protects the fields and the reader, since msgs are received on
+  /// the transport thread while fields are registered on the GUI thread
+  public: std::mutex mutex;
 };
 
 class TransportPrivate
@@ -90,6 +139,12 @@ class PlottingIfacePrivate
 
   /// \brief timer to update the plotting each time step
   public: QTimer timer;
+
+  /// \brief True while paused
+  public: bool paused{false};
+
+  /// \brief Time when plotting was paused
+  public: std::chrono::steady_clock::time_point pauseTime;
 };
 
 }
@@ -170,6 +225,7 @@ Topic::Topic(const std::string &_name) : QObject(),
 //////////////////////////////////////////////////////
 Topic::~Topic()
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   for (auto field : this->dataPtr->fields)
     delete field.second;
 }
@@ -183,26 +239,35 @@ std::string &Topic::Name() const
 //////////////////////////////////////////////////////
 void Topic::Register(const std::string &_fieldPath, int _chart)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
   // if a new field create a new field and register the chart
   if (this->dataPtr->fields.count(_fieldPath) == 0)
     this->dataPtr->fields[_fieldPath] = new PlotData();
 
   this->dataPtr->fields[_fieldPath]->AddChart(_chart);
+  this->dataPtr->readerDirty = true;
 }
 
 //////////////////////////////////////////////////////
 void Topic::UnRegister(const std::string &_fieldPath, int _chart)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
   this->dataPtr->fields[_fieldPath]->RemoveChart(_chart);
 
   // if no one registers to the field, remove it
   if (!this->dataPtr->fields[_fieldPath]->ChartCount())
+  {
     this->dataPtr->fields.erase(_fieldPath);
+    this->dataPtr->readerDirty = true;
+  }
 }
 
 //////////////////////////////////////////////////////
 int Topic::FieldCount() const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   return this->dataPtr->fields.size();
 }
 
@@ -213,31 +278,116 @@ std::map<std::string, PlotData*> &Topic::Fields()
 }
 
 //////////////////////////////////////////////////////
-void Topic::Callback(const google::protobuf::Message &_msg)
+bool TopicPrivate::UpdateTime(bool _hasHeader, double &_headerTime)
 {
-  // check for header time
-  double headerTime;
-  if (!this->HasHeader(_msg, headerTime))
+  if (!_hasHeader)
   {
-    if (!this->dataPtr->plottingTime)
-        return;
+    if (!this->plottingTime)
+        return false;
 
-    headerTime = DEFAULT_TIME;
+    _headerTime = DEFAULT_TIME;
 
-    if (*this->dataPtr->plottingTime - this->dataPtr->lastHeaderTime
-          < MAX_PERIOD_DIFF)
-      return;
+    if (*this->plottingTime - this->lastHeaderTime < MAX_PERIOD_DIFF)
+      return false;
 
-    this->dataPtr->lastHeaderTime = *this->dataPtr->plottingTime;
+    this->lastHeaderTime = *this->plottingTime;
   }
   else
   {
-    if (headerTime - this->dataPtr->lastHeaderTime < MAX_PERIOD_DIFF)
-        return;
+    if (_headerTime - this->lastHeaderTime < MAX_PERIOD_DIFF)
+        return false;
+
+    this->lastHeaderTime = _headerTime;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////
+void TopicPrivate::CreateReader(const std::string &_msgType)
+{
+  this->reader.reset();
+  this->readerType = _msgType;
+  this->readerDirty = false;
+  this->fieldIndices.clear();
+
+  auto msg = ignition::msgs::Factory::New(_msgType);
+  if (!msg)
+  {
+    ignwarn << "Unable to create msg of type [" << _msgType << "]"
+            << std::endl;
+    return;
+  }
+
+  this->reader = std::make_unique<RawFieldReader>(msg->GetDescriptor());
+  this->headerIndex = this->reader->AddField({"header"});
+  this->secIndex = this->reader->AddField({"header", "stamp", "sec"});
+  this->nsecIndex = this->reader->AddField({"header", "stamp", "nsec"});
+
+  for (auto fieldIt : this->fields)
+  {
+    this->fieldIndices[fieldIt.first] = this->reader->AddField(
+        ignition::common::Split(fieldIt.first, '-'));
+  }
+}
+
+//////////////////////////////////////////////////////
+void Topic::RawCallback(const char *_data, const size_t _size,
+                        const std::string &_msgType)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-    this->dataPtr->lastHeaderTime = headerTime;
+  if (this->dataPtr->readerDirty || this->dataPtr->readerType != _msgType)
+    this->dataPtr->CreateReader(_msgType);
+
+  auto &reader = this->dataPtr->reader;
+  if (!reader)
+    return;
+
+  if (!reader->Read(_data, _size))
+  {
+    ignwarn << "Invalid topic msg" << std::endl;
+    return;
   }
 
+  // check for header time
+  bool hasHeader = reader->Found(this->dataPtr->headerIndex);
+  double headerTime = reader->Value(this->dataPtr->secIndex) +
+      reader->Value(this->dataPtr->nsecIndex) * std::pow(10, -9);
+  if (!this->dataPtr->UpdateTime(hasHeader, headerTime))
+    return;
+
+  // update the registered fields, without decoding anything else
+  for (auto fieldIt : this->dataPtr->fields)
+  {
+    if (!fieldIt.second)
+      continue;
+
+    auto index = this->dataPtr->fieldIndices[fieldIt.first];
+    if (index < 0)
+      continue;
+
+    // Field Arrival Time
+    fieldIt.second->SetTime(headerTime);
+
+    // Field Value
+    fieldIt.second->SetValue(reader->Value(index));
+
+    // Update Field Charts UI
+    this->UpdateGui(fieldIt.first);
+  }
+}
+
+//////////////////////////////////////////////////////
+void Topic::Callback(const google::protobuf::Message &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // check for header time
+  double headerTime;
+  bool hasHeader = this->HasHeader(_msg, headerTime);
+  if (!this->dataPtr->UpdateTime(hasHeader, headerTime))
+    return;
+
   // loop over the registered fields and update them
   for (auto fieldIt : this->dataPtr->fields)
   {
@@ -443,7 +593,14 @@ void Transport::Subscribe(const std::string &_topic,
     this->dataPtr->topics[_topic] = topicHandler;
 
     topicHandler->Register(_fieldPath, _chart);
-    this->dataPtr->node.Subscribe(_topic, &Topic::Callback, topicHandler);
+
+    // only the registered fields are decoded from the serialized msgs
+    auto cb = [topicHandler](const char *_data, const size_t _size,
+        const transport::MessageInfo &_info)
+    {
+      topicHandler->RawCallback(_data, _size, _info.Type());
+    };
+    this->dataPtr->node.SubscribeRaw(_topic, cb);
 
     topicHandler->SetPlottingTimeRef(_time);
 
@@ -454,8 +611,6 @@ void Transport::Subscribe(const std::string &_topic,
   else
   {
     this->dataPtr->topics[_topic]->Register(_fieldPath, _chart);
-    this->dataPtr->node.Subscribe(_topic, &Topic::Callback,
-                                  this->dataPtr->topics[_topic]);
   }
 }
 
@@ -525,6 +680,26 @@ float PlottingInterface::Timeout() const
   return this->dataPtr->timer.interval();
 }
 
+//////////////////////////////////////////////////////
+void PlottingInterface::SetPaused(bool _paused)
+{
+  if (_paused == this->dataPtr->paused)
+    return;
+  this->dataPtr->paused = _paused;
+
+  if (_paused)
+  {
+    this->dataPtr->timer.stop();
+    this->dataPtr->pauseTime = std::chrono::steady_clock::now();
+    return;
+  }
+
+  // Account for the time spent paused in one step
+  *this->dataPtr->plottingTimeRef += std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - this->dataPtr->pauseTime).count();
+  this->dataPtr->timer.start();
+}
+
 //////////////////////////////////////////////////////
 void PlottingInterface::onComponentSubscribe(QString _entity, QString _typeId,
                                              QString _type, QString _attribute,
@@ -578,6 +753,9 @@ void PlottingInterface::InitTimer()
 void PlottingInterface::onPlot(int _chart, QString _fieldID,
                                double _x, double _y)
 {
+  if (this->dataPtr->paused)
+    return;
+
   // if _x == -1, then the msg has not header time
   // so update x with the default plotting time that is handled by a timer
   if (static_cast<int>(_x) == DEFAULT_TIME)
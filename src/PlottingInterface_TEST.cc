@@ -159,6 +159,49 @@ TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(HeaderTime))
   EXPECT_NE(static_cast<int>(fields["data"]->Value()), 20);
 }
 
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(RawCallback))
+{
+  common::Console::SetVerbosity(4);
+
+  msgs::Collision msg;
+  msg.set_name("not decoded");
+  msg.mutable_pose()->mutable_position()->set_x(10);
+  msg.mutable_pose()->mutable_position()->set_z(15);
+  msg.mutable_header()->mutable_stamp()->set_sec(10);
+
+  auto topic = Topic("");
+  topic.Register("pose-position-x", 1);
+  topic.Register("pose-position-z", 1);
+
+  auto data = msg.SerializeAsString();
+  topic.RawCallback(data.data(), data.size(), "ignition.msgs.Collision");
+
+  auto fields = topic.Fields();
+  EXPECT_DOUBLE_EQ(fields["pose-position-x"]->Value(), 10);
+  EXPECT_DOUBLE_EQ(fields["pose-position-z"]->Value(), 15);
+  EXPECT_DOUBLE_EQ(fields["pose-position-x"]->Time(), 10);
+
+  // time diff < max diff
+  msg.mutable_pose()->mutable_position()->set_x(20);
+  msg.mutable_header()->mutable_stamp()->set_nsec(1);
+  data = msg.SerializeAsString();
+  topic.RawCallback(data.data(), data.size(), "ignition.msgs.Collision");
+  EXPECT_DOUBLE_EQ(fields["pose-position-x"]->Value(), 10);
+
+  // newly registered fields are read
+  msg.mutable_header()->mutable_stamp()->set_sec(11);
+  msg.mutable_pose()->mutable_position()->set_y(5);
+  data = msg.SerializeAsString();
+  topic.Register("pose-position-y", 1);
+  topic.RawCallback(data.data(), data.size(), "ignition.msgs.Collision");
+  fields = topic.Fields();
+  EXPECT_DOUBLE_EQ(fields["pose-position-x"]->Value(), 20);
+  EXPECT_DOUBLE_EQ(fields["pose-position-y"]->Value(), 5);
+}
+
 //////////////////////////////////////////////////
 // Disable test on windows until we fix "LNK2001 unresolved external symbol"
 // error
@@ -15,7 +15,11 @@
  *
  */
 
+#include <algorithm>
+#include <map>
+#include <mutex>
 #include <unordered_set>
+#include <utility>
 
 #include <ignition/common/Console.hh>
 #include "ignition/gui/Application.hh"
@@ -62,6 +66,29 @@ class ignition::gui::PluginPrivate
   /// before the end of LoadConfig.
   public: bool deleteLaterRequested{false};
 
+  /// \brief Holds the value of the `lazy` element on the configuration.
+  /// Lazy plugins only have their config loaded once their card is shown.
+  public: bool lazy{false};
+
+  /// \brief True once LoadConfig was called.
+  public: bool configLoaded{false};
+
+  /// \brief True if the card is shown.
+  public: bool cardShown{false};
+
+  /// \brief True if the plugin is active.
+  public: bool active{true};
+
+  /// \brief Window which the card is on, watched for minimization.
+  public: QPointer<QQuickWindow> window;
+
+  /// \brief Connection to the window's visibility changes.
+  public: QMetaObject::Connection windowConnection;
+
+  /// \brief Plugin filename, used as the card's title until the config of
+  /// lazy plugins is loaded.
+  public: std::string filename;
+
   /// \brief Pointer to item generated with plugin's QML
   public: QQuickItem *pluginItem{nullptr};
 
@@ -78,6 +105,22 @@ class ignition::gui::PluginPrivate
 
   /// \brief Holds all anchor information
   public: Anchors anchors;
+
+  /// \brief Statistics of each handler, by name
+  public: std::map<std::string, HandlerStats, std::less<>> handlerStats;
+
+  /// \brief Statistics of each queue, by name
+  public: std::map<std::string, QueueStats, std::less<>> queueStats;
+
+  /// \brief Protects handler and queue statistics
+  public: mutable std::mutex statsMutex;
+
+  /// \brief Render hooks added by the plugin, removed on destruction.
+  public: std::vector<RenderHookId> renderHooks;
+
+  /// \brief Event subscriptions added by the plugin, removed on
+  /// destruction.
+  public: std::vector<EventSubscriptionId> eventSubscriptions;
 };
 
 using namespace ignition;
@@ -91,6 +134,8 @@ Plugin::Plugin() : dataPtr(new PluginPrivate)
 /////////////////////////////////////////////////
 Plugin::~Plugin()
 {
+  this->RemoveCallbacks();
+
   if (this->dataPtr->pluginItem)
     delete this->dataPtr->pluginItem;
 }
@@ -119,45 +164,43 @@ void Plugin::Load(const tinyxml2::XMLElement *_pluginElem)
 
   // Qml file
   std::string filename = _pluginElem->Attribute("filename");
+  this->dataPtr->filename = filename;
 
   // This let's <filename>.qml use <pluginclass> functions and properties
   this->dataPtr->context = new QQmlContext(App()->Engine()->rootContext());
   this->dataPtr->context->setContextProperty(QString::fromStdString(filename),
       this);
 
-  // Instantiate plugin QML file into a component
+  // Get the plugin's QML component, which is only compiled for the first
+  // instance
   std::string qmlFile(":/" + filename + "/" + filename + ".qml");
-  if (!QFile(QString::fromStdString(qmlFile)).exists())
-  {
-    ignerr << "Can't find [" << qmlFile
-           << "]. Are you sure it was added to the .qrc file?" << std::endl;
-    return;
-  }
-
-  QQmlComponent component(App()->Engine(), QString::fromStdString(qmlFile));
-  if (component.isError())
+  auto component = App()->QmlComponent(qmlFile);
+  if (nullptr == component || component->isError())
   {
     std::stringstream errors;
-    errors << "Failed to instantiate QML file [" << qmlFile << "]."
-           << std::endl;
-    for (auto error : component.errors())
+    errors << "Failed to instantiate QML file [" << qmlFile << "]. "
+           << "Are you sure it was added to the .qrc file?" << std::endl;
+    if (component)
     {
-      errors << "* " << error.toString().toStdString() << std::endl;
+      for (auto error : component->errors())
+      {
+        errors << "* " << error.toString().toStdString() << std::endl;
+      }
     }
     ignerr << errors.str();
     return;
   }
-  if (!component.isReady())
+  if (!component->isReady())
   {
     ignerr << "Component from QML file [" << qmlFile
-           << "] is not ready. Progress: " << component.progress()
+           << "] is not ready. Progress: " << component->progress()
            << " / 1.0" << std::endl;
     return;
   }
 
   // Create an item for the plugin
   this->dataPtr->pluginItem =
-      qobject_cast<QQuickItem *>(component.create(this->dataPtr->context));
+      qobject_cast<QQuickItem *>(component->create(this->dataPtr->context));
   if (!this->dataPtr->pluginItem)
   {
     ignerr << "Failed to instantiate QML file [" << qmlFile << "]." << std::endl
@@ -169,8 +212,26 @@ void Plugin::Load(const tinyxml2::XMLElement *_pluginElem)
   // Load common configuration
   this->LoadCommonConfig(_pluginElem->FirstChildElement("ignition-gui"));
 
-  // Load custom configuration
-  this->LoadConfig(_pluginElem);
+  // Load custom configuration, unless it's deferred until the card is shown
+  if (!this->dataPtr->lazy)
+  {
+    this->dataPtr->configLoaded = true;
+    this->LoadConfig(_pluginElem);
+  }
+
+  // Watch the card. Checks are queued, so the card's state is only checked
+  // once it has been placed and configured.
+  auto cardItem = this->CardItem();
+  if (nullptr == cardItem)
+    return;
+
+  auto update = [this]() {this->UpdateActive();};
+  this->connect(cardItem, &QQuickItem::windowChanged, this, update,
+      Qt::QueuedConnection);
+  this->connect(cardItem, &QQuickItem::visibleChanged, this, update,
+      Qt::QueuedConnection);
+  this->connect(cardItem, &QQuickItem::stateChanged, this, update,
+      Qt::QueuedConnection);
 }
 
 /////////////////////////////////////////////////
@@ -185,6 +246,11 @@ void Plugin::LoadCommonConfig(const tinyxml2::XMLElement *_ignGuiElem)
     this->title = elem->GetText();
   }
 
+  // Lazy
+  elem = _ignGuiElem->FirstChildElement("lazy");
+  if (nullptr != elem)
+    elem->QueryBoolText(&this->dataPtr->lazy);
+
   // Delete later
   elem = _ignGuiElem->FirstChildElement("delete_later");
   if (nullptr != elem)
@@ -409,9 +475,9 @@ QQuickItem *Plugin::CardItem() const
 
   // Instantiate a card
   std::string qmlFile(":qml/IgnCard.qml");
-  QQmlComponent cardComp(App()->Engine(),
-      QString(QString::fromStdString(qmlFile)));
-  auto cardItem = qobject_cast<QQuickItem *>(cardComp.create());
+  auto cardComp = App()->QmlComponent(qmlFile);
+  auto cardItem = cardComp ?
+      qobject_cast<QQuickItem *>(cardComp->create()) : nullptr;
   if (!cardItem)
   {
     ignerr << "Internal error: Failed to instantiate QML file [" << qmlFile
@@ -438,8 +504,10 @@ QQuickItem *Plugin::CardItem() const
   }
 
   // Configure card
-  cardItem->setProperty("pluginName",
-      QString::fromStdString(this->Title()));
+  auto title = this->Title();
+  if (title.empty() && !this->dataPtr->configLoaded)
+    title = this->dataPtr->filename;
+  cardItem->setProperty("pluginName", QString::fromStdString(title));
 
   for (auto prop : this->dataPtr->cardProperties)
   {
@@ -507,6 +575,78 @@ void Plugin::PostParentChanges()
   }
 }
 
+/////////////////////////////////////////////////
+bool Plugin::CardShown() const
+{
+  return this->dataPtr->cardShown;
+}
+
+/////////////////////////////////////////////////
+bool Plugin::Active() const
+{
+  return this->dataPtr->active;
+}
+
+/////////////////////////////////////////////////
+void Plugin::UpdateActive()
+{
+  auto cardItem = this->dataPtr->cardItem;
+  auto window = nullptr != cardItem ? cardItem->window() : nullptr;
+
+  // Follow the card to its current window
+  if (window != this->dataPtr->window)
+  {
+    this->disconnect(this->dataPtr->windowConnection);
+    this->dataPtr->window = window;
+    if (window)
+    {
+      this->dataPtr->windowConnection = this->connect(window,
+          &QWindow::visibilityChanged, this, [this]() {this->UpdateActive();},
+          Qt::QueuedConnection);
+    }
+  }
+
+  bool shown = nullptr != window && cardItem->isVisible() &&
+      !cardItem->state().endsWith("_collapsed");
+  if (shown != this->dataPtr->cardShown)
+  {
+    this->dataPtr->cardShown = shown;
+    this->CardShownChanged();
+  }
+
+  bool active = shown && window->visibility() != QWindow::Minimized;
+
+  // Lazy plugins are only loaded once active
+  if (!this->dataPtr->configLoaded)
+  {
+    if (!active)
+      return;
+
+    igndbg << "Loading config of lazy plugin [" << this->dataPtr->filename
+           << "]" << std::endl;
+
+    this->dataPtr->configLoaded = true;
+
+    tinyxml2::XMLDocument doc;
+    doc.Parse(this->configStr.c_str());
+    if (auto pluginElem = doc.FirstChildElement("plugin"))
+      this->LoadConfig(pluginElem);
+
+    cardItem->setProperty("pluginName",
+        QString::fromStdString(this->Title()));
+    return;
+  }
+
+  if (active == this->dataPtr->active)
+    return;
+  this->dataPtr->active = active;
+
+  if (active)
+    this->OnActivate();
+  else
+    this->OnDeactivate();
+}
+
 /////////////////////////////////////////////////
 void Plugin::ApplyAnchors()
 {
@@ -576,3 +716,102 @@ void Plugin::ApplyAnchors()
   this->CardItem()->setProperty("anchored", true);
 }
 
+/////////////////////////////////////////////////
+void Plugin::RecordHandler(const char *_name,
+    const std::chrono::steady_clock::duration _duration)
+{
+  if (!instrumentationEnabled())
+    return;
+
+  auto duration =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(_duration);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->statsMutex);
+  auto it = this->dataPtr->handlerStats.find(_name);
+  if (it == this->dataPtr->handlerStats.end())
+  {
+    it = this->dataPtr->handlerStats.emplace(_name, HandlerStats()).first;
+    it->second.name = _name;
+  }
+
+  it->second.count++;
+  it->second.total += duration;
+  it->second.max = std::max(it->second.max, duration);
+}
+
+/////////////////////////////////////////////////
+void Plugin::RecordQueueDepth(const char *_name, const size_t _depth)
+{
+  if (!instrumentationEnabled())
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->statsMutex);
+  auto it = this->dataPtr->queueStats.find(_name);
+  if (it == this->dataPtr->queueStats.end())
+  {
+    it = this->dataPtr->queueStats.emplace(_name, QueueStats()).first;
+    it->second.name = _name;
+  }
+
+  it->second.depth = _depth;
+  it->second.maxDepth = std::max(it->second.maxDepth, _depth);
+}
+
+/////////////////////////////////////////////////
+std::vector<HandlerStats> Plugin::HandlerStatistics() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->statsMutex);
+  std::vector<HandlerStats> stats;
+  for (const auto &handler : this->dataPtr->handlerStats)
+    stats.push_back(handler.second);
+  return stats;
+}
+
+/////////////////////////////////////////////////
+std::vector<QueueStats> Plugin::QueueStatistics() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->statsMutex);
+  std::vector<QueueStats> stats;
+  for (const auto &queue : this->dataPtr->queueStats)
+    stats.push_back(queue.second);
+  return stats;
+}
+
+/////////////////////////////////////////////////
+RenderHookId Plugin::AddRenderHook(const RenderPhase _phase,
+    const std::string &_name, std::function<void()> _callback,
+    const int _priority, const std::chrono::nanoseconds _budget)
+{
+  auto id = addRenderHook(_phase, _name, std::move(_callback), _priority,
+      _budget, this);
+  if (id != 0)
+    this->dataPtr->renderHooks.push_back(id);
+  return id;
+}
+
+/////////////////////////////////////////////////
+void Plugin::RemoveCallbacks()
+{
+  for (auto id : this->dataPtr->renderHooks)
+    removeRenderHook(id);
+  this->dataPtr->renderHooks.clear();
+
+  for (auto id : this->dataPtr->eventSubscriptions)
+    unsubscribeEvent(id);
+  this->dataPtr->eventSubscriptions.clear();
+}
+
+/////////////////////////////////////////////////
+void Plugin::KeepEventSubscription(const EventSubscriptionId _id)
+{
+  if (_id != 0)
+    this->dataPtr->eventSubscriptions.push_back(_id);
+}
+
+/////////////////////////////////////////////////
+void Plugin::ResetStatistics()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->statsMutex);
+  this->dataPtr->handlerStats.clear();
+  this->dataPtr->queueStats.clear();
+}
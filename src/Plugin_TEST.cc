@@ -134,3 +134,100 @@ TEST(PluginTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Getters))
   ASSERT_NE(nullptr, plugin->CardItem());
   ASSERT_NE(nullptr, plugin->Context());
 }
+
+/////////////////////////////////////////////////
+TEST(PluginTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Lazy))
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Lazy plugin which starts collapsed
+  const char *pluginStr =
+    "<plugin filename=\"Publisher\">"
+      "<ignition-gui>"
+        "<lazy>true</lazy>"
+        "<property key=\"state\" type=\"string\">docked_collapsed</property>"
+      "</ignition-gui>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("Publisher",
+      pluginDoc.FirstChildElement("plugin")));
+  QCoreApplication::processEvents();
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  ASSERT_EQ(1, win->findChildren<Plugin *>().size());
+  auto plugin = win->findChildren<Plugin *>()[0];
+
+  // The card is there, but the config isn't loaded yet
+  auto cardItem = plugin->CardItem();
+  ASSERT_NE(nullptr, cardItem);
+  EXPECT_FALSE(plugin->CardShown());
+  EXPECT_TRUE(plugin->Title().empty());
+  EXPECT_EQ("Publisher", cardItem->property("pluginName").toString());
+
+  int changes{0};
+  plugin->connect(plugin, &Plugin::CardShownChanged, [&changes]()
+  {
+    changes++;
+  });
+
+  // Expanding the card loads the config
+  cardItem->setProperty("state", "docked");
+  QCoreApplication::processEvents();
+  EXPECT_TRUE(plugin->CardShown());
+  EXPECT_EQ("Publisher", plugin->Title());
+  EXPECT_EQ(1, changes);
+
+  // Collapsing it again only notifies
+  cardItem->setProperty("state", "docked_collapsed");
+  QCoreApplication::processEvents();
+  EXPECT_FALSE(plugin->CardShown());
+  EXPECT_EQ("Publisher", plugin->Title());
+  EXPECT_EQ(2, changes);
+}
+
+/////////////////////////////////////////////////
+TEST(PluginTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Active))
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  EXPECT_TRUE(app.LoadPlugin("Publisher"));
+  QCoreApplication::processEvents();
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  ASSERT_EQ(1, win->findChildren<Plugin *>().size());
+  auto plugin = win->findChildren<Plugin *>()[0];
+  auto cardItem = plugin->CardItem();
+  ASSERT_NE(nullptr, cardItem);
+
+  // Plugins start active
+  EXPECT_TRUE(plugin->Active());
+
+  // Collapsing deactivates
+  cardItem->setProperty("state", "docked_collapsed");
+  QCoreApplication::processEvents();
+  EXPECT_FALSE(plugin->Active());
+
+  // Expanding activates again
+  cardItem->setProperty("state", "docked");
+  QCoreApplication::processEvents();
+  EXPECT_TRUE(plugin->Active());
+
+  // Hiding deactivates
+  cardItem->setVisible(false);
+  QCoreApplication::processEvents();
+  EXPECT_FALSE(plugin->Active());
+
+  cardItem->setVisible(true);
+  QCoreApplication::processEvents();
+  EXPECT_TRUE(plugin->Active());
+}
@@ -0,0 +1,434 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <ignition/msgs/Factory.hh>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <ignition/common/Console.hh>
+#include <ignition/transport/MessageInfo.hh>
+
+#include "ignition/gui/RawMessage.hh"
+
+namespace ignition
+{
+  namespace gui
+  {
+    class RawMessagePrivate
+    {
+      /// \brief Serialized message
+      public: std::string data;
+
+      /// \brief Message type
+      public: std::string type;
+
+      /// \brief Parsed message, set on first use
+      public: std::shared_ptr<const google::protobuf::Message> msg;
+
+      /// \brief Makes sure the message is parsed only once
+      public: std::once_flag parsed;
+    };
+
+    /// \brief Fields to read from a message, by field number
+    struct RawFieldNode
+    {
+      /// \brief A field to read
+      struct Entry
+      {
+        /// \brief Field descriptor
+        const google::protobuf::FieldDescriptor *field{nullptr};
+
+        /// \brief Index of the field's value, -1 if the field is only on
+        /// the path to other fields
+        int index{-1};
+
+        /// \brief Fields to read inside a message field
+        std::unique_ptr<RawFieldNode> node;
+      };
+
+      /// \brief Fields by field number
+      std::unordered_map<int, Entry> entries;
+    };
+
+    class RawFieldReaderPrivate
+    {
+      /// \brief Read the fields of a message, until the end of the input or
+      /// of its current limit.
+      /// \param[in] _input Input positioned at the start of the message.
+      /// \param[in] _node Fields to read.
+      /// \return False if the data is malformed.
+      public: bool ReadMessage(google::protobuf::io::CodedInputStream &_input,
+                               const RawFieldNode &_node);
+
+      /// \brief Descriptor of the root message
+      public: const google::protobuf::Descriptor *descriptor{nullptr};
+
+      /// \brief Fields of the root message
+      public: RawFieldNode root;
+
+      /// \brief Field values
+      public: std::vector<double> values;
+
+      /// \brief Whether each field was present
+      public: std::vector<bool> found;
+    };
+  }
+}
+
+using namespace ignition;
+using namespace gui;
+
+using WireFormatLite = google::protobuf::internal::WireFormatLite;
+
+/////////////////////////////////////////////////
+RawMessage::RawMessage(const char *_data, size_t _size,
+    const std::string &_type)
+  : dataPtr(new RawMessagePrivate)
+{
+  this->dataPtr->data.assign(_data, _size);
+  this->dataPtr->type = _type;
+}
+
+/////////////////////////////////////////////////
+RawMessage::~RawMessage()
+{
+}
+
+/////////////////////////////////////////////////
+const std::string &RawMessage::Data() const
+{
+  return this->dataPtr->data;
+}
+
+/////////////////////////////////////////////////
+const std::string &RawMessage::Type() const
+{
+  return this->dataPtr->type;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const google::protobuf::Message> RawMessage::Message() const
+{
+  std::call_once(this->dataPtr->parsed, [this]()
+  {
+    std::shared_ptr<google::protobuf::Message> msg =
+        msgs::Factory::New(this->dataPtr->type);
+    if (!msg)
+    {
+      ignerr << "Unable to create message of type [" << this->dataPtr->type
+             << "]" << std::endl;
+      return;
+    }
+
+    if (!msg->ParseFromString(this->dataPtr->data))
+    {
+      ignerr << "Failed to parse message of type [" << this->dataPtr->type
+             << "]" << std::endl;
+      return;
+    }
+
+    this->dataPtr->msg = msg;
+  });
+
+  return this->dataPtr->msg;
+}
+
+/////////////////////////////////////////////////
+bool ignition::gui::subscribeRaw(transport::Node &_node,
+    const std::string &_topic, const RawMessageCallback &_callback)
+{
+  auto cb = [_callback](const char *_data, const size_t _size,
+      const transport::MessageInfo &_info)
+  {
+    _callback(std::make_shared<const RawMessage>(_data, _size, _info.Type()));
+  };
+
+  return _node.SubscribeRaw(_topic, cb);
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a numeric value of a given field type.
+/// \param[in] _input Input positioned at the value.
+/// \param[in] _type Field type.
+/// \param[out] _value Value.
+/// \return False if the value couldn't be read.
+static bool readValue(google::protobuf::io::CodedInputStream &_input,
+    google::protobuf::FieldDescriptor::Type _type, double &_value)
+{
+  using google::protobuf::FieldDescriptor;
+
+  uint32_t u32{0};
+  uint64_t u64{0};
+  switch (_type)
+  {
+    case FieldDescriptor::TYPE_DOUBLE:
+      if (!_input.ReadLittleEndian64(&u64))
+        return false;
+      _value = WireFormatLite::DecodeDouble(u64);
+      return true;
+    case FieldDescriptor::TYPE_FLOAT:
+      if (!_input.ReadLittleEndian32(&u32))
+        return false;
+      _value = WireFormatLite::DecodeFloat(u32);
+      return true;
+    case FieldDescriptor::TYPE_FIXED64:
+      if (!_input.ReadLittleEndian64(&u64))
+        return false;
+      _value = static_cast<double>(u64);
+      return true;
+    case FieldDescriptor::TYPE_SFIXED64:
+      if (!_input.ReadLittleEndian64(&u64))
+        return false;
+      _value = static_cast<double>(static_cast<int64_t>(u64));
+      return true;
+    case FieldDescriptor::TYPE_FIXED32:
+      if (!_input.ReadLittleEndian32(&u32))
+        return false;
+      _value = u32;
+      return true;
+    case FieldDescriptor::TYPE_SFIXED32:
+      if (!_input.ReadLittleEndian32(&u32))
+        return false;
+      _value = static_cast<int32_t>(u32);
+      return true;
+    case FieldDescriptor::TYPE_INT64:
+      if (!_input.ReadVarint64(&u64))
+        return false;
+      _value = static_cast<double>(static_cast<int64_t>(u64));
+      return true;
+    case FieldDescriptor::TYPE_UINT64:
+      if (!_input.ReadVarint64(&u64))
+        return false;
+      _value = static_cast<double>(u64);
+      return true;
+    case FieldDescriptor::TYPE_INT32:
+    case FieldDescriptor::TYPE_ENUM:
+      if (!_input.ReadVarint64(&u64))
+        return false;
+      _value = static_cast<int32_t>(u64);
+      return true;
+    case FieldDescriptor::TYPE_UINT32:
+      if (!_input.ReadVarint32(&u32))
+        return false;
+      _value = u32;
+      return true;
+    case FieldDescriptor::TYPE_BOOL:
+      if (!_input.ReadVarint64(&u64))
+        return false;
+      _value = u64 != 0 ? 1.0 : 0.0;
+      return true;
+    case FieldDescriptor::TYPE_SINT32:
+      if (!_input.ReadVarint32(&u32))
+        return false;
+      _value = WireFormatLite::ZigZagDecode32(u32);
+      return true;
+    case FieldDescriptor::TYPE_SINT64:
+      if (!_input.ReadVarint64(&u64))
+        return false;
+      _value = static_cast<double>(WireFormatLite::ZigZagDecode64(u64));
+      return true;
+    default:
+      return false;
+  }
+}
+
+/////////////////////////////////////////////////
+RawFieldReader::RawFieldReader(
+    const google::protobuf::Descriptor *_descriptor)
+  : dataPtr(new RawFieldReaderPrivate)
+{
+  this->dataPtr->descriptor = _descriptor;
+}
+
+/////////////////////////////////////////////////
+RawFieldReader::~RawFieldReader()
+{
+}
+
+/////////////////////////////////////////////////
+const google::protobuf::Descriptor *RawFieldReader::Descriptor() const
+{
+  return this->dataPtr->descriptor;
+}
+
+/////////////////////////////////////////////////
+int RawFieldReader::AddField(const std::vector<std::string> &_path)
+{
+  using google::protobuf::FieldDescriptor;
+
+  if (_path.empty() || nullptr == this->dataPtr->descriptor)
+    return -1;
+
+  // Check the path before changing anything
+  std::vector<const FieldDescriptor *> fields;
+  auto descriptor = this->dataPtr->descriptor;
+  for (size_t i = 0; i < _path.size(); ++i)
+  {
+    if (nullptr == descriptor)
+      return -1;
+
+    auto field = descriptor->FindFieldByName(_path[i]);
+    if (nullptr == field || field->is_repeated())
+      return -1;
+
+    bool last = i + 1 == _path.size();
+    if (field->type() == FieldDescriptor::TYPE_STRING ||
+        field->type() == FieldDescriptor::TYPE_BYTES ||
+        field->type() == FieldDescriptor::TYPE_GROUP ||
+        (!last && field->type() != FieldDescriptor::TYPE_MESSAGE))
+    {
+      return -1;
+    }
+
+    fields.push_back(field);
+    descriptor = field->message_type();
+  }
+
+  auto node = &this->dataPtr->root;
+  for (size_t i = 0; i < fields.size(); ++i)
+  {
+    auto &entry = node->entries[fields[i]->number()];
+    entry.field = fields[i];
+
+    if (i + 1 < fields.size())
+    {
+      if (!entry.node)
+        entry.node.reset(new RawFieldNode);
+      node = entry.node.get();
+      continue;
+    }
+
+    // Same field added twice
+    if (entry.index >= 0)
+      return entry.index;
+
+    entry.index = static_cast<int>(this->dataPtr->values.size());
+    this->dataPtr->values.push_back(0.0);
+    this->dataPtr->found.push_back(false);
+  }
+
+  return static_cast<int>(this->dataPtr->values.size()) - 1;
+}
+
+/////////////////////////////////////////////////
+bool RawFieldReaderPrivate::ReadMessage(
+    google::protobuf::io::CodedInputStream &_input, const RawFieldNode &_node)
+{
+  using google::protobuf::FieldDescriptor;
+
+  while (true)
+  {
+    auto tag = _input.ReadTag();
+    if (tag == 0)
+      return _input.ConsumedEntireMessage();
+
+    auto it = _node.entries.find(WireFormatLite::GetTagFieldNumber(tag));
+    auto wireType = WireFormatLite::GetTagWireType(tag);
+
+    // Skip fields which weren't asked for, or which have an unexpected
+    // encoding, such as packed values
+    if (it == _node.entries.end() || wireType !=
+        WireFormatLite::WireTypeForFieldType(
+        static_cast<WireFormatLite::FieldType>(it->second.field->type())))
+    {
+      if (!WireFormatLite::SkipField(&_input, tag))
+        return false;
+      continue;
+    }
+
+    const auto &entry = it->second;
+
+    if (entry.field->type() != FieldDescriptor::TYPE_MESSAGE)
+    {
+      double value;
+      if (!readValue(_input, entry.field->type(), value))
+        return false;
+      this->values[entry.index] = value;
+      this->found[entry.index] = true;
+      continue;
+    }
+
+    uint32_t length;
+    if (!_input.ReadVarint32(&length))
+      return false;
+
+    // Reading a sub-message stops at the end of the data as if it were
+    // complete, so reject truncated ones here
+    if (length > static_cast<uint32_t>(_input.BytesUntilLimit()))
+      return false;
+
+    if (entry.index >= 0)
+      this->found[entry.index] = true;
+
+    if (!entry.node)
+    {
+      if (!_input.Skip(static_cast<int>(length)))
+        return false;
+      continue;
+    }
+
+    auto limit = _input.PushLimit(static_cast<int>(length));
+    if (!this->ReadMessage(_input, *entry.node))
+      return false;
+    _input.PopLimit(limit);
+  }
+}
+
+/////////////////////////////////////////////////
+bool RawFieldReader::Read(const char *_data, size_t _size)
+{
+  std::fill(this->dataPtr->values.begin(), this->dataPtr->values.end(), 0.0);
+  std::fill(this->dataPtr->found.begin(), this->dataPtr->found.end(), false);
+
+  if (_size > static_cast<size_t>(std::numeric_limits<int>::max()))
+    return false;
+
+  google::protobuf::io::CodedInputStream input(
+      reinterpret_cast<const uint8_t *>(_data), static_cast<int>(_size));
+
+  // So BytesUntilLimit is the size of the rest of the data
+  input.PushLimit(static_cast<int>(_size));
+  return this->dataPtr->ReadMessage(input, this->dataPtr->root);
+}
+
+/////////////////////////////////////////////////
+bool RawFieldReader::Found(int _index) const
+{
+  if (_index < 0 || _index >= static_cast<int>(this->dataPtr->found.size()))
+    return false;
+  return this->dataPtr->found[_index];
+}
+
+/////////////////////////////////////////////////
+double RawFieldReader::Value(int _index) const
+{
+  if (_index < 0 || _index >= static_cast<int>(this->dataPtr->values.size()))
+    return 0.0;
+  return this->dataPtr->values[_index];
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <thread>
+
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <ignition/msgs.hh>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <ignition/common/Console.hh>
+#include <ignition/transport.hh>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/RawMessage.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(RawMessageTest, LazyParse)
+{
+  msgs::StringMsg msg;
+  msg.set_data("hello");
+  auto data = msg.SerializeAsString();
+
+  RawMessage raw(data.data(), data.size(), "ignition.msgs.StringMsg");
+  EXPECT_EQ(data, raw.Data());
+  EXPECT_EQ("ignition.msgs.StringMsg", raw.Type());
+
+  auto parsed = raw.Message();
+  ASSERT_NE(nullptr, parsed);
+  EXPECT_EQ(msg.DebugString(), parsed->DebugString());
+
+  // Parsed only once
+  EXPECT_EQ(parsed, raw.Message());
+
+  // Unknown type
+  RawMessage unknown(data.data(), data.size(), "banana.message");
+  EXPECT_EQ(nullptr, unknown.Message());
+}
+
+/////////////////////////////////////////////////
+TEST(RawMessageTest, FieldReader)
+{
+  common::Console::SetVerbosity(4);
+
+  msgs::Collision msg;
+  msg.set_name("collision");
+  msg.mutable_pose()->mutable_position()->set_x(10);
+  msg.mutable_pose()->mutable_position()->set_z(-15);
+  msg.mutable_header()->mutable_stamp()->set_sec(3);
+  msg.mutable_header()->mutable_stamp()->set_nsec(500);
+  msg.set_id(42);
+  auto data = msg.SerializeAsString();
+
+  RawFieldReader reader(msg.GetDescriptor());
+  EXPECT_EQ(msg.GetDescriptor(), reader.Descriptor());
+
+  int header = reader.AddField({"header"});
+  int sec = reader.AddField({"header", "stamp", "sec"});
+  int nsec = reader.AddField({"header", "stamp", "nsec"});
+  int x = reader.AddField({"pose", "position", "x"});
+  int y = reader.AddField({"pose", "position", "y"});
+  int z = reader.AddField({"pose", "position", "z"});
+  int id = reader.AddField({"id"});
+  EXPECT_GE(header, 0);
+  EXPECT_GE(x, 0);
+
+  // Same field
+  EXPECT_EQ(x, reader.AddField({"pose", "position", "x"}));
+
+  // Unsupported fields
+  EXPECT_EQ(-1, reader.AddField({}));
+  EXPECT_EQ(-1, reader.AddField({"name"}));
+  EXPECT_EQ(-1, reader.AddField({"banana"}));
+  EXPECT_EQ(-1, reader.AddField({"pose", "banana"}));
+  EXPECT_EQ(-1, reader.AddField({"id", "x"}));
+  EXPECT_EQ(-1, reader.AddField({"header", "data"}));
+
+  EXPECT_TRUE(reader.Read(data.data(), data.size()));
+  EXPECT_TRUE(reader.Found(header));
+  EXPECT_DOUBLE_EQ(3.0, reader.Value(sec));
+  EXPECT_DOUBLE_EQ(500.0, reader.Value(nsec));
+  EXPECT_TRUE(reader.Found(x));
+  EXPECT_DOUBLE_EQ(10.0, reader.Value(x));
+  EXPECT_FALSE(reader.Found(y));
+  EXPECT_DOUBLE_EQ(0.0, reader.Value(y));
+  EXPECT_DOUBLE_EQ(-15.0, reader.Value(z));
+  EXPECT_DOUBLE_EQ(42.0, reader.Value(id));
+
+  // Values are reset for each message
+  msgs::Collision empty;
+  data = empty.SerializeAsString();
+  EXPECT_TRUE(reader.Read(data.data(), data.size()));
+  EXPECT_FALSE(reader.Found(header));
+  EXPECT_FALSE(reader.Found(x));
+  EXPECT_DOUBLE_EQ(0.0, reader.Value(x));
+
+  // Malformed data
+  data = msg.SerializeAsString();
+  EXPECT_FALSE(reader.Read(data.data(), data.size() - 3));
+
+  // Sub-message cut at the end of one of its fields, the last field of the
+  // message being pose
+  msgs::Collision poseOnly;
+  poseOnly.mutable_pose()->mutable_position()->set_x(10);
+  poseOnly.mutable_pose()->mutable_orientation()->set_w(1);
+  data = poseOnly.SerializeAsString();
+  auto orientationSize = 2 + poseOnly.pose().orientation().ByteSizeLong();
+  EXPECT_TRUE(reader.Read(data.data(), data.size()));
+  EXPECT_FALSE(reader.Read(data.data(), data.size() - orientationSize));
+
+  // Bad indices
+  EXPECT_FALSE(reader.Found(-1));
+  EXPECT_DOUBLE_EQ(0.0, reader.Value(100));
+}
+
+/////////////////////////////////////////////////
+TEST(RawMessageTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Subscribe))
+{
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Int32>("/raw_test");
+
+  std::mutex mutex;
+  RawMessagePtr received;
+  EXPECT_TRUE(subscribeRaw(node, "/raw_test",
+      [&](const RawMessagePtr &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        received = _msg;
+      }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  msgs::Int32 msg;
+  msg.set_data(5);
+  pub.Publish(msg);
+
+  for (int sleep = 0; sleep < 30; ++sleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (received)
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_NE(nullptr, received);
+  EXPECT_EQ("ignition.msgs.Int32", received->Type());
+  EXPECT_EQ(msg.SerializeAsString(), received->Data());
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
+
+#include "ignition/gui/Instrumentation.hh"
+#include "ignition/gui/Plugin.hh"
+#include "ignition/gui/RenderHooks.hh"
+
+namespace ignition
+{
+  namespace gui
+  {
+    /// \brief A registered render hook.
+    struct RenderHook
+    {
+      /// \brief Unique ID, also gives the registration order.
+      RenderHookId id{0};
+
+      /// \brief Function to call.
+      std::function<void()> callback;
+
+      /// \brief Plugin which owns the hook, may be null.
+      Plugin *plugin{nullptr};
+
+      /// \brief Name, phase, priority, budget and timing.
+      RenderHookStats stats;
+    };
+
+    /// \brief Registered hooks. They're kept sorted in the order they run,
+    /// so running a phase doesn't need to sort or allocate.
+    class RenderHookRegistry
+    {
+      /// \brief Protects hooks. It's held while hooks run, so that removed
+      /// hooks are never called again.
+      public: std::mutex mutex;
+
+      /// \brief Hooks sorted by phase, priority and ID.
+      public: std::vector<RenderHook> hooks;
+
+      /// \brief ID of the next hook.
+      public: RenderHookId nextId{1};
+    };
+
+    /// \brief Get the process wide registry.
+    /// \return The registry.
+    static RenderHookRegistry &registry()
+    {
+      static RenderHookRegistry instance;
+      return instance;
+    }
+
+    /// \brief Order in which hooks run.
+    /// \param[in] _a First hook.
+    /// \param[in] _b Second hook.
+    /// \return True if _a runs before _b.
+    static bool runsBefore(const RenderHook &_a, const RenderHook &_b)
+    {
+      return std::make_tuple(_a.stats.phase, _a.stats.priority, _a.id) <
+             std::make_tuple(_b.stats.phase, _b.stats.priority, _b.id);
+    }
+  }
+}
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+RenderHookId ignition::gui::addRenderHook(const RenderPhase _phase,
+    const std::string &_name, std::function<void()> _callback,
+    const int _priority, const std::chrono::nanoseconds _budget,
+    Plugin *_plugin)
+{
+  if (!_callback)
+  {
+    ignerr << "Can't add render hook [" << _name << "] without a callback."
+           << std::endl;
+    return 0;
+  }
+
+  RenderHook hook;
+  hook.callback = std::move(_callback);
+  hook.plugin = _plugin;
+  hook.stats.name = _name;
+  hook.stats.phase = _phase;
+  hook.stats.priority = _priority;
+  hook.stats.budget = _budget;
+
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  hook.id = reg.nextId++;
+  auto id = hook.id;
+  reg.hooks.insert(std::upper_bound(reg.hooks.begin(), reg.hooks.end(),
+      hook, runsBefore), std::move(hook));
+  return id;
+}
+
+/////////////////////////////////////////////////
+bool ignition::gui::removeRenderHook(const RenderHookId _id)
+{
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  auto it = std::find_if(reg.hooks.begin(), reg.hooks.end(),
+      [&_id](const RenderHook &_hook) {return _hook.id == _id;});
+  if (it == reg.hooks.end())
+    return false;
+
+  reg.hooks.erase(it);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::runRenderHooks(const RenderPhase _phase)
+{
+  IGN_PROFILE("runRenderHooks");
+
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+
+  RenderHook key;
+  key.stats.phase = _phase;
+  key.stats.priority = std::numeric_limits<int>::min();
+  for (auto it = std::lower_bound(reg.hooks.begin(), reg.hooks.end(), key,
+      runsBefore); it != reg.hooks.end() && it->stats.phase == _phase; ++it)
+  {
+    auto start = std::chrono::steady_clock::now();
+    it->callback();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    auto &stats = it->stats;
+    stats.count++;
+    stats.total += elapsed;
+    stats.max = std::max(stats.max, elapsed);
+
+    if (stats.budget.count() > 0 && elapsed > stats.budget)
+    {
+      if (stats.overBudget++ == 0)
+      {
+        ignwarn << "Render hook [" << stats.name << "] took "
+                << std::chrono::duration<double, std::milli>(elapsed).count()
+                << " ms, over its budget of "
+                << std::chrono::duration<double, std::milli>(
+                   stats.budget).count()
+                << " ms. Further overruns are only counted." << std::endl;
+      }
+    }
+
+    if (nullptr != it->plugin)
+      it->plugin->RecordHandler(stats.name.c_str(), elapsed);
+  }
+}
+
+/////////////////////////////////////////////////
+std::vector<RenderHookStats> ignition::gui::renderHookStatistics()
+{
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+
+  std::vector<RenderHookStats> stats;
+  stats.reserve(reg.hooks.size());
+  for (const auto &hook : reg.hooks)
+    stats.push_back(hook.stats);
+  return stats;
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::resetRenderHookStatistics()
+{
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+
+  for (auto &hook : reg.hooks)
+  {
+    hook.stats.count = 0;
+    hook.stats.total = std::chrono::nanoseconds(0);
+    hook.stats.max = std::chrono::nanoseconds(0);
+    hook.stats.overBudget = 0;
+  }
+}
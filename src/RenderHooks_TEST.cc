@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Plugin.hh"
+#include "ignition/gui/RenderHooks.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Order))
+{
+  std::vector<std::string> calls;
+  auto add = [&calls](RenderPhase _phase, const std::string &_name,
+      int _priority)
+  {
+    return addRenderHook(_phase, _name,
+        [&calls, _name]() {calls.push_back(_name);}, _priority);
+  };
+
+  std::vector<RenderHookId> ids;
+  ids.push_back(add(RenderPhase::kRender, "late", 10));
+  ids.push_back(add(RenderPhase::kRender, "first", 0));
+  ids.push_back(add(RenderPhase::kPreRender, "pre", 0));
+  ids.push_back(add(RenderPhase::kRender, "second", 0));
+  ids.push_back(add(RenderPhase::kRender, "early", -10));
+
+  // Only hooks of the phase, by priority, then by registration
+  runRenderHooks(RenderPhase::kRender);
+  EXPECT_EQ(std::vector<std::string>({"early", "first", "second", "late"}),
+      calls);
+
+  calls.clear();
+  runRenderHooks(RenderPhase::kPreRender);
+  EXPECT_EQ(std::vector<std::string>({"pre"}), calls);
+
+  // Removed hooks aren't called
+  calls.clear();
+  EXPECT_TRUE(removeRenderHook(ids[1]));
+  EXPECT_FALSE(removeRenderHook(ids[1]));
+  runRenderHooks(RenderPhase::kRender);
+  EXPECT_EQ(std::vector<std::string>({"early", "second", "late"}), calls);
+
+  for (auto id : ids)
+    removeRenderHook(id);
+  EXPECT_TRUE(renderHookStatistics().empty());
+
+  // Hooks need a callback
+  EXPECT_EQ(0u, addRenderHook(RenderPhase::kRender, "null", nullptr));
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Statistics))
+{
+  auto fast = addRenderHook(RenderPhase::kRender, "fast", []() {}, 0,
+      std::chrono::seconds(1));
+  auto slow = addRenderHook(RenderPhase::kRender, "slow", []()
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      }, 1, std::chrono::microseconds(100));
+
+  for (int i = 0; i < 3; ++i)
+    runRenderHooks(RenderPhase::kRender);
+
+  auto stats = renderHookStatistics();
+  ASSERT_EQ(2u, stats.size());
+
+  EXPECT_EQ("fast", stats[0].name);
+  EXPECT_EQ(RenderPhase::kRender, stats[0].phase);
+  EXPECT_EQ(0, stats[0].priority);
+  EXPECT_EQ(3u, stats[0].count);
+  EXPECT_EQ(0u, stats[0].overBudget);
+
+  EXPECT_EQ("slow", stats[1].name);
+  EXPECT_EQ(1, stats[1].priority);
+  EXPECT_EQ(3u, stats[1].count);
+  EXPECT_EQ(3u, stats[1].overBudget);
+  EXPECT_LE(std::chrono::milliseconds(6), stats[1].total);
+  EXPECT_LE(std::chrono::milliseconds(2), stats[1].max);
+
+  resetRenderHookStatistics();
+  stats = renderHookStatistics();
+  ASSERT_EQ(2u, stats.size());
+  EXPECT_EQ(0u, stats[1].count);
+  EXPECT_EQ(0u, stats[1].overBudget);
+  EXPECT_EQ(std::chrono::nanoseconds(0), stats[1].total);
+
+  removeRenderHook(fast);
+  removeRenderHook(slow);
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(PluginHooks))
+{
+  setInstrumentationEnabled(true);
+
+  {
+    // Plugin hooks are recorded as plugin handlers
+    class HookPlugin : public Plugin
+    {
+      public: HookPlugin()
+      {
+        this->AddRenderHook(RenderPhase::kRender, "HookPlugin::OnRender",
+            [this]() {this->calls++;});
+      }
+      public: int calls{0};
+    };
+
+    HookPlugin plugin;
+    runRenderHooks(RenderPhase::kRender);
+    runRenderHooks(RenderPhase::kRender);
+    EXPECT_EQ(2, plugin.calls);
+
+    auto stats = plugin.HandlerStatistics();
+    ASSERT_EQ(1u, stats.size());
+    EXPECT_EQ("HookPlugin::OnRender", stats[0].name);
+    EXPECT_EQ(2u, stats[0].count);
+
+    EXPECT_EQ(1u, renderHookStatistics().size());
+  }
+
+  // Removed with the plugin
+  EXPECT_TRUE(renderHookStatistics().empty());
+
+  setInstrumentationEnabled(false);
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(RemoveWhileRunning))
+{
+  std::atomic<bool> destroyed{false};
+  std::atomic<int> calls{0};
+  std::atomic<int> lateCalls{0};
+
+  // The hook uses data owned by the derived class
+  class DataPlugin : public Plugin
+  {
+    public: explicit DataPlugin(std::atomic<bool> &_destroyed,
+        std::atomic<int> &_calls, std::atomic<int> &_lateCalls)
+      : data(new int(0)), destroyed(_destroyed)
+    {
+      this->AddRenderHook(RenderPhase::kRender, "DataPlugin::OnRender",
+          [this, &_destroyed, &_calls, &_lateCalls]()
+          {
+            if (_destroyed)
+              _lateCalls++;
+            (*this->data)++;
+            _calls++;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+          });
+    }
+    public: ~DataPlugin() override
+    {
+      this->RemoveCallbacks();
+      this->destroyed = true;
+      this->data.reset();
+    }
+    public: std::unique_ptr<int> data;
+    public: std::atomic<bool> &destroyed;
+  };
+
+  auto plugin = new DataPlugin(destroyed, calls, lateCalls);
+
+  // Render thread
+  std::atomic<bool> stop{false};
+  std::thread renderThread([&stop]()
+  {
+    while (!stop)
+      runRenderHooks(RenderPhase::kRender);
+  });
+
+  for (int sleep = 0; calls < 10 && sleep < 100; ++sleep)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_LE(10, calls);
+
+  // Waits for a running call, and isn't called afterwards
+  delete plugin;
+  auto callsAfterDelete = calls.load();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  stop = true;
+  renderThread.join();
+
+  EXPECT_EQ(0, lateCalls);
+  EXPECT_EQ(callsAfterDelete, calls);
+  EXPECT_TRUE(renderHookStatistics().empty());
+}
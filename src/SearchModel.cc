@@ -15,85 +15,326 @@
  *
 */
 
+#include <cstdint>
+#include <vector>
+
 #include <ignition/common/Console.hh>
 
 #include "ignition/gui/Enums.hh"
 #include "ignition/gui/SearchModel.hh"
 
+namespace ignition
+{
+namespace gui
+{
+  /// \brief An indexed source item.
+  struct SearchNode
+  {
+    /// \brief Lowercase text of the filter role.
+    QString text;
+
+    /// \brief Position of the parent in the index, -1 for top level items.
+    int parent{-1};
+
+    /// \brief True for titles, which are never accepted.
+    bool title{false};
+  };
+
+  /// \brief Private data for the SearchModel class.
+  class SearchModelPrivate
+  {
+    /// \brief Index all items of a source model, parents before children.
+    /// \param[in] _model Source model.
+    /// \param[in] _role Role holding the text to search.
+    public: void Build(const QAbstractItemModel *_model, int _role);
+
+    /// \brief Index the descendants of an item.
+    /// \param[in] _model Source model.
+    /// \param[in] _parent Parent item on the source model.
+    /// \param[in] _parentNode Position of the parent in the index.
+    public: void AddChildren(const QAbstractItemModel *_model,
+        const QModelIndex &_parent, int _parentNode);
+
+    /// \brief Update the index for items whose data changed, or mark it as
+    /// outdated if they aren't indexed.
+    /// \param[in] _topLeft First changed item.
+    /// \param[in] _bottomRight Last changed item.
+    /// \param[in] _roles Changed roles, empty if all may have changed.
+    public: void Update(const QModelIndex &_topLeft,
+        const QModelIndex &_bottomRight, const QVector<int> &_roles);
+
+    /// \brief Resolve a search for all indexed items.
+    /// \param[in] _search Full search string.
+    public: void Resolve(const QString &_search);
+
+    /// \brief Indexed items, parents before children.
+    public: std::vector<SearchNode> nodes;
+
+    /// \brief Position of each source item in the index. Keys are persistent
+    /// so they stay valid while the index is up to date. They may move when
+    /// rows change, which marks the index as outdated, so it's cleared and
+    /// rebuilt before any lookup.
+    public: QHash<QPersistentModelIndex, int> positions;
+
+    /// \brief Whether each item is accepted by the current search.
+    public: std::vector<bool> accepted;
+
+    /// \brief Whether each item should be expanded for the current search.
+    public: std::vector<bool> expand;
+
+    /// \brief Role which was indexed.
+    public: int role{-1};
+
+    /// \brief Search which was resolved.
+    public: QString resolvedSearch;
+
+    /// \brief True if the source model changed since it was indexed.
+    public: bool dirty{true};
+
+    /// \brief True if the flags match the index, false if they must be
+    /// computed again.
+    public: bool resolved{false};
+
+    /// \brief Connections to the source model.
+    public: std::vector<QMetaObject::Connection> connections;
+  };
+}
+}
+
 using namespace ignition;
 using namespace gui;
 
 /////////////////////////////////////////////////
-bool SearchModel::filterAcceptsRow(const int _srcRow,
-      const QModelIndex &_srcParent) const
+void SearchModelPrivate::Build(const QAbstractItemModel *_model, int _role)
 {
-  // Item index in search model.
-  auto id = this->sourceModel()->index(_srcRow, 0, _srcParent);
+  this->nodes.clear();
+  this->positions.clear();
+  this->role = _role;
+  this->dirty = false;
+  this->resolved = false;
+
+  if (_model)
+    this->AddChildren(_model, QModelIndex(), -1);
+}
 
-  // Ignore titles.
-  if (this->sourceModel()->data(id, DataRole::TYPE).toString() ==
-      "title")
+/////////////////////////////////////////////////
+void SearchModelPrivate::AddChildren(const QAbstractItemModel *_model,
+    const QModelIndex &_parent, int _parentNode)
+{
+  for (int i = 0; i < _model->rowCount(_parent); ++i)
   {
-    return false;
+    auto id = _model->index(i, 0, _parent);
+
+    SearchNode node;
+    node.text = _model->data(id, this->role).toString().toLower();
+    node.parent = _parentNode;
+    node.title = _model->data(id, DataRole::TYPE).toString() == "title";
+
+    int position = static_cast<int>(this->nodes.size());
+    this->nodes.push_back(node);
+    this->positions.insert(QPersistentModelIndex(id), position);
+
+    this->AddChildren(_model, id, position);
   }
+}
 
-  // Collapsed by default.
-  this->sourceModel()->blockSignals(true);
-  this->sourceModel()->setData(id, false, DataRole::TO_EXPAND);
-  this->sourceModel()->blockSignals(false);
+/////////////////////////////////////////////////
+void SearchModelPrivate::Update(const QModelIndex &_topLeft,
+    const QModelIndex &_bottomRight, const QVector<int> &_roles)
+{
+  // Only the first column is indexed
+  if (this->dirty || _topLeft.column() > 0)
+    return;
 
-  // Empty search matches everything.
-  if (this->search.isEmpty())
-    return true;
+  if (!_roles.isEmpty() && !_roles.contains(this->role) &&
+      !_roles.contains(DataRole::TYPE))
+  {
+    return;
+  }
+
+  auto model = _topLeft.model();
+  for (int i = _topLeft.row(); i <= _bottomRight.row(); ++i)
+  {
+    auto id = model->index(i, 0, _topLeft.parent());
+    auto it = this->positions.find(QPersistentModelIndex(id));
+    if (it == this->positions.end())
+    {
+      this->dirty = true;
+      return;
+    }
+
+    auto &node = this->nodes[it.value()];
+    node.text = model->data(id, this->role).toString().toLower();
+    node.title = model->data(id, DataRole::TYPE).toString() == "title";
+  }
+  this->resolved = false;
+}
+
+/////////////////////////////////////////////////
+void SearchModelPrivate::Resolve(const QString &_search)
+{
+  this->resolvedSearch = _search;
+  this->resolved = true;
+
+  auto count = this->nodes.size();
+  this->accepted.assign(count, false);
+  this->expand.assign(count, false);
 
-  // Each word must match at least once, either self, parent or child.
-  auto words = this->search.split(" ");
-  for (auto word : words)
+  // Distinct words, each one is a bit
+  QStringList words;
+  for (const auto &word : _search.toLower().split(" "))
   {
-    if (word.isEmpty())
-      continue;
+    if (!word.isEmpty() && !words.contains(word) && words.size() < 64)
+      words.append(word);
+  }
+
+  // Empty search matches everything.
+  if (words.empty())
+  {
+    for (size_t i = 0; i < count; ++i)
+      this->accepted[i] = !this->nodes[i].title;
+    return;
+  }
 
-    // Expand this if at least one child contains the word.
-    // Note that this is not enough for this to be accepted, we need to match
-    // all words.
-    if (this->HasChildAcceptsItself(id, word))
+  uint64_t all = words.size() == 64 ?
+      ~uint64_t(0) : (uint64_t(1) << words.size()) - 1;
+
+  // Words found on each item itself, and on its ancestors. Parents come
+  // before their children.
+  std::vector<uint64_t> self(count, 0);
+  std::vector<uint64_t> ancestors(count, 0);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto &node = this->nodes[i];
+    for (int w = 0; w < words.size(); ++w)
     {
-      this->sourceModel()->blockSignals(true);
-      this->sourceModel()->setData(id, true, DataRole::TO_EXPAND);
-      this->sourceModel()->blockSignals(false);
+      if (node.text.contains(words[w]))
+        self[i] |= uint64_t(1) << w;
     }
+    if (node.parent >= 0)
+      ancestors[i] = ancestors[node.parent] | self[node.parent];
+  }
 
-    // At least one of the children fits rule 1.
-    if (this->HasAcceptedChildren(_srcRow, _srcParent))
-      continue;
+  // Bottom-up: words found on descendants, and whether any child is
+  // accepted. Children come after their parents, so they're done first.
+  std::vector<uint64_t> descendants(count, 0);
+  std::vector<bool> acceptedChild(count, false);
+  for (size_t i = count; i-- > 0;)
+  {
+    const auto &node = this->nodes[i];
+
+    // Each word must match at least once, either self or an ancestor, or
+    // one of the children must be accepted.
+    this->accepted[i] = !node.title &&
+        (acceptedChild[i] || ((self[i] | ancestors[i]) & all) == all);
 
-    // Row itself contains this word.
-    if (this->FilterAcceptsRowItself(_srcRow, _srcParent, word))
-      continue;
+    // Expand this if at least one descendant contains one of the words.
+    this->expand[i] = descendants[i] != 0;
 
-    // One of the ancestors contains this word.
-    QModelIndex parentIndex = _srcParent;
-    bool parentAccepted = false;
-    while (parentIndex.isValid())
+    if (node.parent >= 0)
     {
-      if (this->FilterAcceptsRowItself(parentIndex.row(),
-          parentIndex.parent(), word))
-      {
-        parentAccepted = true;
-        break;
-      }
-      parentIndex = parentIndex.parent();
+      descendants[node.parent] |= self[i] | descendants[i];
+      if (this->accepted[i])
+        acceptedChild[node.parent] = true;
     }
+  }
+}
+
+/////////////////////////////////////////////////
+SearchModel::SearchModel()
+  : dataPtr(new SearchModelPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SearchModel::~SearchModel()
+{
+  for (const auto &connection : this->dataPtr->connections)
+    QObject::disconnect(connection);
+}
+
+/////////////////////////////////////////////////
+void SearchModel::setSourceModel(QAbstractItemModel *_model)
+{
+  for (const auto &connection : this->dataPtr->connections)
+    QObject::disconnect(connection);
+  this->dataPtr->connections.clear();
+  this->dataPtr->dirty = true;
 
-    if (parentAccepted)
-      continue;
+  // Connect before the base class, so the index is updated before the base
+  // class filters changed rows
+  if (_model)
+  {
+    auto markDirty = [this]()
+    {
+      this->dataPtr->dirty = true;
+    };
+    auto &connections = this->dataPtr->connections;
+    connections.push_back(QObject::connect(_model,
+        &QAbstractItemModel::rowsInserted, this, markDirty));
+    connections.push_back(QObject::connect(_model,
+        &QAbstractItemModel::rowsRemoved, this, markDirty));
+    connections.push_back(QObject::connect(_model,
+        &QAbstractItemModel::rowsMoved, this, markDirty));
+    connections.push_back(QObject::connect(_model,
+        &QAbstractItemModel::dataChanged, this,
+        [this](const QModelIndex &_topLeft, const QModelIndex &_bottomRight,
+            const QVector<int> &_roles)
+        {
+          this->dataPtr->Update(_topLeft, _bottomRight, _roles);
+        }));
+    connections.push_back(QObject::connect(_model,
+        &QAbstractItemModel::layoutChanged, this, markDirty));
+    connections.push_back(QObject::connect(_model,
+        &QAbstractItemModel::modelReset, this, markDirty));
+  }
 
-    // This word can't be found on the row or a parent, and no child is fully
-    // accepted.
+  QSortFilterProxyModel::setSourceModel(_model);
+}
+
+/////////////////////////////////////////////////
+QVariant SearchModel::data(const QModelIndex &_index, int _role) const
+{
+  if (_role != DataRole::TO_EXPAND)
+    return QSortFilterProxyModel::data(_index, _role);
+
+  auto srcIndex = this->mapToSource(_index);
+  if (!srcIndex.isValid() || !this->filterAcceptsRow(srcIndex.row(),
+      srcIndex.parent()))
+  {
     return false;
   }
 
-  return true;
+  auto it = this->dataPtr->positions.find(
+      QPersistentModelIndex(srcIndex.sibling(srcIndex.row(), 0)));
+  if (it == this->dataPtr->positions.end())
+    return false;
+
+  return static_cast<bool>(this->dataPtr->expand[it.value()]);
+}
+
+/////////////////////////////////////////////////
+bool SearchModel::filterAcceptsRow(const int _srcRow,
+      const QModelIndex &_srcParent) const
+{
+  // Item index in search model.
+  QPersistentModelIndex id(
+      this->sourceModel()->index(_srcRow, 0, _srcParent));
+
+  if (this->dataPtr->dirty || this->dataPtr->role != this->filterRole() ||
+      (id.isValid() && !this->dataPtr->positions.contains(id)))
+  {
+    this->dataPtr->Build(this->sourceModel(), this->filterRole());
+  }
+
+  if (!this->dataPtr->resolved || this->dataPtr->resolvedSearch != this->search)
+    this->dataPtr->Resolve(this->search);
+
+  auto it = this->dataPtr->positions.find(id);
+  if (it == this->dataPtr->positions.end())
+    return false;
+
+  return this->dataPtr->accepted[it.value()];
 }
 
 /////////////////////////////////////////////////
@@ -173,3 +173,75 @@ TEST(SearchModelTest, NestedStructure)
   }
 }
 
+
+/////////////////////////////////////////////////
+TEST(SearchModelTest, SourceChanges)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  auto sourceModel = new QStandardItemModel();
+  ASSERT_NE(nullptr, sourceModel);
+
+  auto foo = new QStandardItem();
+  foo->setData("foo", DataRole::DISPLAY_NAME);
+  sourceModel->appendRow(foo);
+
+  auto searchModel = new SearchModel();
+  ASSERT_NE(nullptr, searchModel);
+
+  searchModel->setFilterRole(DataRole::DISPLAY_NAME);
+  searchModel->setSourceModel(sourceModel);
+
+  searchModel->SetSearch("bar");
+  EXPECT_EQ(searchModel->rowCount(), 0);
+
+  // New rows are indexed
+  auto bar = new QStandardItem();
+  bar->setData("bar", DataRole::DISPLAY_NAME);
+  sourceModel->appendRow(bar);
+  EXPECT_EQ(searchModel->rowCount(), 1);
+
+  // Nested rows are indexed
+  auto barChild = new QStandardItem();
+  barChild->setData("child", DataRole::DISPLAY_NAME);
+  foo->appendRow(barChild);
+  searchModel->SetSearch("child");
+  EXPECT_EQ(searchModel->rowCount(), 1);
+  EXPECT_TRUE(searchModel->data(searchModel->index(0, 0),
+      DataRole::TO_EXPAND).toBool());
+
+  // Changed data is indexed
+  foo->setData("bar", DataRole::DISPLAY_NAME);
+  searchModel->SetSearch("bar");
+  EXPECT_EQ(searchModel->rowCount(), 2);
+
+  // Changed nested data is indexed
+  barChild->setData("baz", DataRole::DISPLAY_NAME);
+  searchModel->SetSearch("baz");
+  EXPECT_EQ(searchModel->rowCount(), 1);
+  EXPECT_TRUE(searchModel->data(searchModel->index(0, 0),
+      DataRole::TO_EXPAND).toBool());
+
+  // Other roles aren't searched
+  barChild->setData("qux", Qt::ToolTipRole);
+  searchModel->SetSearch("qux");
+  EXPECT_EQ(searchModel->rowCount(), 0);
+
+  // Rows which become titles aren't accepted
+  bar->setData("title", DataRole::TYPE);
+  searchModel->SetSearch("bar");
+  EXPECT_EQ(searchModel->rowCount(), 1);
+
+  // Source model isn't modified
+  EXPECT_FALSE(foo->data(DataRole::TO_EXPAND).isValid());
+
+  // Rows after a removed row are still found
+  auto baz = new QStandardItem();
+  baz->setData("baz", DataRole::DISPLAY_NAME);
+  sourceModel->appendRow(baz);
+  sourceModel->removeRow(0);
+  searchModel->SetSearch("baz");
+  EXPECT_EQ(searchModel->rowCount(), 1);
+  EXPECT_FALSE(searchModel->data(searchModel->index(0, 0),
+      DataRole::TO_EXPAND).toBool());
+}
@@ -0,0 +1,566 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/transport/Node.hh>
+
+#include "ignition/gui/TransportLog.hh"
+
+namespace ignition
+{
+  namespace gui
+  {
+    /// \brief Identifies log files
+    static const char kMagic[] = "IGNGUILOG";
+
+    /// \brief Version of the file format
+    static const uint32_t kVersion{1};
+
+    /// \brief Largest string size accepted when reading, so a corrupt
+    /// file can't cause huge allocations
+    static const uint32_t kMaxStringSize{1u << 30};
+
+    class TransportLogWriterPrivate
+    {
+      /// \brief Append an unsigned integer, little endian
+      /// \param[in] _value Value
+      /// \param[in] _bytes Number of bytes to write
+      public: void Put(uint64_t _value, int _bytes);
+
+      /// \brief Append a string prefixed with its size
+      /// \param[in] _data String data
+      /// \param[in] _size String size
+      public: void PutString(const char *_data, size_t _size);
+
+      /// \brief Append a message
+      /// \param[in] _time Time since the file was opened
+      /// \param[in] _topic Topic
+      /// \param[in] _type Message type
+      /// \param[in] _data Serialized message
+      /// \param[in] _size Size of the serialized message
+      /// \return True if the file is still good
+      public: bool PutRecord(std::chrono::nanoseconds _time,
+          const std::string &_topic, const std::string &_type,
+          const char *_data, size_t _size);
+
+      /// \brief Output file
+      public: std::ofstream file;
+
+      /// \brief Time at which the file was opened
+      public: std::chrono::steady_clock::time_point start;
+
+      /// \brief Number of messages written
+      public: uint64_t count{0};
+
+      /// \brief Number of bytes written
+      public: uint64_t bytes{0};
+
+      /// \brief Protects everything above
+      public: mutable std::mutex mutex;
+    };
+
+    class TransportLogReaderPrivate
+    {
+      /// \brief Read an unsigned integer, little endian
+      /// \param[out] _value Value
+      /// \param[in] _bytes Number of bytes to read
+      /// \return False if the file ended
+      public: bool Get(uint64_t &_value, int _bytes);
+
+      /// \brief Read a string prefixed with its size
+      /// \param[out] _str String
+      /// \return False if the file ended or the size is invalid
+      public: bool GetString(std::string &_str);
+
+      /// \brief Input file
+      public: std::ifstream file;
+    };
+
+    class TransportLogPlayerPrivate
+    {
+      /// \brief Publish all messages, called on the publishing thread
+      /// \param[in] _fast True to ignore recorded times
+      public: void Play(const bool _fast);
+
+      /// \brief A loaded message with its publisher
+      public: struct Entry
+      {
+        /// \brief Recorded message
+        TransportLogRecord record;
+
+        /// \brief Publisher for its topic, null if the type doesn't match
+        /// the advertised one
+        transport::Node::Publisher *pub{nullptr};
+      };
+
+      /// \brief Loaded messages, in recorded order
+      public: std::vector<Entry> entries;
+
+      /// \brief Node used to advertise
+      public: transport::Node node;
+
+      /// \brief Publisher of a topic
+      public: struct TopicPublisher
+      {
+        /// \brief Advertised type
+        std::string type;
+
+        /// \brief Publisher
+        transport::Node::Publisher pub;
+      };
+
+      /// \brief Publishers by topic
+      public: std::unordered_map<std::string, TopicPublisher> publishers;
+
+      /// \brief Publishing thread
+      public: std::thread thread;
+
+      /// \brief Set to stop publishing
+      public: std::atomic<bool> stop{false};
+
+      /// \brief Used with cv
+      public: std::mutex mutex;
+
+      /// \brief Wakes the publishing thread when stopping
+      public: std::condition_variable cv;
+
+      /// \brief Set when publishing is over
+      public: std::atomic<bool> finished{true};
+
+      /// \brief Number of messages published
+      public: std::atomic<uint64_t> published{0};
+
+      /// \brief Largest backlog
+      public: std::atomic<uint64_t> maxBacklog{0};
+
+      /// \brief Largest lag in nanoseconds
+      public: std::atomic<int64_t> maxLag{0};
+
+      /// \brief Publishing time in nanoseconds
+      public: std::atomic<int64_t> elapsed{0};
+    };
+  }
+}
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+void TransportLogWriterPrivate::Put(uint64_t _value, int _bytes)
+{
+  char buf[8];
+  for (int i = 0; i < _bytes; ++i)
+    buf[i] = static_cast<char>((_value >> (8 * i)) & 0xFF);
+  this->file.write(buf, _bytes);
+  this->bytes += _bytes;
+}
+
+/////////////////////////////////////////////////
+void TransportLogWriterPrivate::PutString(const char *_data, size_t _size)
+{
+  this->Put(_size, 4);
+  this->file.write(_data, _size);
+  this->bytes += _size;
+}
+
+/////////////////////////////////////////////////
+bool TransportLogWriterPrivate::PutRecord(std::chrono::nanoseconds _time,
+    const std::string &_topic, const std::string &_type, const char *_data,
+    size_t _size)
+{
+  this->Put(static_cast<uint64_t>(_time.count()), 8);
+  this->PutString(_topic.data(), _topic.size());
+  this->PutString(_type.data(), _type.size());
+  this->PutString(_data, _size);
+  this->count++;
+  return this->file.good();
+}
+
+/////////////////////////////////////////////////
+TransportLogWriter::TransportLogWriter()
+  : dataPtr(new TransportLogWriterPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+TransportLogWriter::~TransportLogWriter()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool TransportLogWriter::Open(const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->file.is_open())
+    this->dataPtr->file.close();
+
+  this->dataPtr->file.open(_path,
+      std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!this->dataPtr->file.is_open())
+  {
+    ignerr << "Failed to create log file [" << _path << "]" << std::endl;
+    return false;
+  }
+
+  this->dataPtr->count = 0;
+  this->dataPtr->bytes = 0;
+  this->dataPtr->file.write(kMagic, sizeof(kMagic) - 1);
+  this->dataPtr->bytes += sizeof(kMagic) - 1;
+  this->dataPtr->Put(kVersion, 4);
+  this->dataPtr->start = std::chrono::steady_clock::now();
+  return this->dataPtr->file.good();
+}
+
+/////////////////////////////////////////////////
+bool TransportLogWriter::IsOpen() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->file.is_open();
+}
+
+/////////////////////////////////////////////////
+void TransportLogWriter::Close()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->file.is_open())
+    this->dataPtr->file.close();
+}
+
+/////////////////////////////////////////////////
+bool TransportLogWriter::Write(const std::string &_topic,
+    const std::string &_type, const char *_data, size_t _size)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->file.is_open())
+    return false;
+
+  auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - this->dataPtr->start);
+  return this->dataPtr->PutRecord(time, _topic, _type, _data, _size);
+}
+
+/////////////////////////////////////////////////
+bool TransportLogWriter::Write(const TransportLogRecord &_record)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->file.is_open())
+    return false;
+
+  return this->dataPtr->PutRecord(_record.time, _record.topic, _record.type,
+      _record.data.data(), _record.data.size());
+}
+
+/////////////////////////////////////////////////
+uint64_t TransportLogWriter::Count() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->count;
+}
+
+/////////////////////////////////////////////////
+uint64_t TransportLogWriter::Bytes() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->bytes;
+}
+
+/////////////////////////////////////////////////
+bool TransportLogReaderPrivate::Get(uint64_t &_value, int _bytes)
+{
+  unsigned char buf[8];
+  if (!this->file.read(reinterpret_cast<char *>(buf), _bytes))
+    return false;
+
+  _value = 0;
+  for (int i = 0; i < _bytes; ++i)
+    _value |= static_cast<uint64_t>(buf[i]) << (8 * i);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TransportLogReaderPrivate::GetString(std::string &_str)
+{
+  uint64_t size;
+  if (!this->Get(size, 4) || size > kMaxStringSize)
+    return false;
+
+  _str.resize(size);
+  return size == 0 || this->file.read(&_str[0], size);
+}
+
+/////////////////////////////////////////////////
+TransportLogReader::TransportLogReader()
+  : dataPtr(new TransportLogReaderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+TransportLogReader::~TransportLogReader()
+{
+}
+
+/////////////////////////////////////////////////
+bool TransportLogReader::Open(const std::string &_path)
+{
+  if (this->dataPtr->file.is_open())
+    this->dataPtr->file.close();
+
+  this->dataPtr->file.open(_path, std::ios::in | std::ios::binary);
+  if (!this->dataPtr->file.is_open())
+  {
+    ignerr << "Failed to open log file [" << _path << "]" << std::endl;
+    return false;
+  }
+
+  char magic[sizeof(kMagic) - 1];
+  uint64_t version;
+  if (!this->dataPtr->file.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, kMagic, sizeof(magic)) != 0 ||
+      !this->dataPtr->Get(version, 4))
+  {
+    ignerr << "File [" << _path << "] isn't a transport log" << std::endl;
+    this->dataPtr->file.close();
+    return false;
+  }
+
+  if (version != kVersion)
+  {
+    ignerr << "Log file [" << _path << "] has unsupported version ["
+           << version << "]" << std::endl;
+    this->dataPtr->file.close();
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TransportLogReader::Next(TransportLogRecord &_record)
+{
+  if (!this->dataPtr->file.is_open())
+    return false;
+
+  uint64_t time;
+  if (!this->dataPtr->Get(time, 8))
+    return false;
+
+  if (!this->dataPtr->GetString(_record.topic) ||
+      !this->dataPtr->GetString(_record.type) ||
+      !this->dataPtr->GetString(_record.data))
+  {
+    ignwarn << "Transport log is truncated or corrupt" << std::endl;
+    return false;
+  }
+
+  _record.time = std::chrono::nanoseconds(time);
+  return true;
+}
+
+/////////////////////////////////////////////////
+TransportLogPlayer::TransportLogPlayer()
+  : dataPtr(new TransportLogPlayerPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+TransportLogPlayer::~TransportLogPlayer()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+bool TransportLogPlayer::Load(const std::string &_path)
+{
+  this->Stop();
+
+  TransportLogReader reader;
+  if (!reader.Open(_path))
+    return false;
+
+  this->dataPtr->entries.clear();
+  this->dataPtr->publishers.clear();
+
+  TransportLogPlayerPrivate::Entry entry;
+  while (reader.Next(entry.record))
+  {
+    auto it = this->dataPtr->publishers.find(entry.record.topic);
+    if (it == this->dataPtr->publishers.end())
+    {
+      TransportLogPlayerPrivate::TopicPublisher topicPub;
+      topicPub.type = entry.record.type;
+      topicPub.pub = this->dataPtr->node.Advertise(entry.record.topic,
+          entry.record.type);
+      if (!topicPub.pub)
+      {
+        ignerr << "Failed to advertise topic [" << entry.record.topic
+               << "] with type [" << entry.record.type << "]" << std::endl;
+      }
+      it = this->dataPtr->publishers.emplace(entry.record.topic,
+          std::move(topicPub)).first;
+    }
+
+    entry.pub = nullptr;
+    if (it->second.pub && it->second.type == entry.record.type)
+      entry.pub = &it->second.pub;
+
+    this->dataPtr->entries.push_back(std::move(entry));
+    entry = TransportLogPlayerPrivate::Entry();
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t TransportLogPlayer::MessageCount() const
+{
+  return this->dataPtr->entries.size();
+}
+
+/////////////////////////////////////////////////
+std::chrono::nanoseconds TransportLogPlayer::Duration() const
+{
+  if (this->dataPtr->entries.empty())
+    return std::chrono::nanoseconds(0);
+  return this->dataPtr->entries.back().record.time;
+}
+
+/////////////////////////////////////////////////
+void TransportLogPlayer::Start(const bool _fast)
+{
+  this->Stop();
+
+  this->dataPtr->stop = false;
+  this->dataPtr->finished = false;
+  this->dataPtr->published = 0;
+  this->dataPtr->maxBacklog = 0;
+  this->dataPtr->maxLag = 0;
+  this->dataPtr->elapsed = 0;
+  this->dataPtr->thread = std::thread(&TransportLogPlayerPrivate::Play,
+      this->dataPtr.get(), _fast);
+}
+
+/////////////////////////////////////////////////
+void TransportLogPlayer::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->cv.notify_all();
+
+  if (this->dataPtr->thread.joinable())
+    this->dataPtr->thread.join();
+}
+
+/////////////////////////////////////////////////
+bool TransportLogPlayer::Finished() const
+{
+  return this->dataPtr->finished;
+}
+
+/////////////////////////////////////////////////
+uint64_t TransportLogPlayer::PublishedCount() const
+{
+  return this->dataPtr->published;
+}
+
+/////////////////////////////////////////////////
+uint64_t TransportLogPlayer::MaxBacklog() const
+{
+  return this->dataPtr->maxBacklog;
+}
+
+/////////////////////////////////////////////////
+std::chrono::nanoseconds TransportLogPlayer::MaxLag() const
+{
+  return std::chrono::nanoseconds(this->dataPtr->maxLag.load());
+}
+
+/////////////////////////////////////////////////
+std::chrono::nanoseconds TransportLogPlayer::Elapsed() const
+{
+  return std::chrono::nanoseconds(this->dataPtr->elapsed.load());
+}
+
+/////////////////////////////////////////////////
+void TransportLogPlayerPrivate::Play(const bool _fast)
+{
+  auto start = std::chrono::steady_clock::now();
+
+  // Index of the first message which isn't due yet, used to measure how
+  // many due messages are waiting to be published
+  size_t due{0};
+
+  for (size_t i = 0; i < this->entries.size(); ++i)
+  {
+    const auto &entry = this->entries[i];
+
+    if (!_fast)
+    {
+      auto deadline = start + entry.record.time;
+      std::unique_lock<std::mutex> lock(this->mutex);
+      if (this->cv.wait_until(lock, deadline,
+          [this] {return this->stop.load();}))
+      {
+        break;
+      }
+      lock.unlock();
+
+      auto now = std::chrono::steady_clock::now();
+      auto lag = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          now - deadline).count();
+      if (lag > this->maxLag)
+        this->maxLag = lag;
+
+      // Messages other than this one which are already due
+      due = std::max(due, i + 1);
+      while (due < this->entries.size() &&
+             start + this->entries[due].record.time <= now)
+      {
+        ++due;
+      }
+      uint64_t backlog = due - i - 1;
+      if (backlog > this->maxBacklog)
+        this->maxBacklog = backlog;
+    }
+    else if (this->stop)
+    {
+      break;
+    }
+
+    if (entry.pub && entry.pub->PublishRaw(entry.record.data,
+        entry.record.type))
+    {
+      this->published++;
+    }
+  }
+
+  this->elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count();
+  this->finished = true;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <fstream>
+#include <thread>
+
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <ignition/msgs.hh>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <ignition/common/Console.hh>
+#include <ignition/transport.hh>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/TransportLog.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(TransportLogTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(WriteRead))
+{
+  std::string path = "/tmp/ign-gui-transport-log-test.tlog";
+
+  // Write
+  {
+    TransportLogWriter writer;
+    EXPECT_FALSE(writer.IsOpen());
+    EXPECT_FALSE(writer.Write("/a", "type", "x", 1));
+
+    ASSERT_TRUE(writer.Open(path));
+    EXPECT_TRUE(writer.IsOpen());
+
+    TransportLogRecord record;
+    record.time = std::chrono::milliseconds(5);
+    record.topic = "/a";
+    record.type = "ignition.msgs.StringMsg";
+    record.data = std::string("\0\1\2", 3);
+    EXPECT_TRUE(writer.Write(record));
+
+    EXPECT_TRUE(writer.Write("/b", "ignition.msgs.Empty", "", 0));
+    EXPECT_EQ(2u, writer.Count());
+    EXPECT_LT(0u, writer.Bytes());
+  }
+
+  // Read
+  TransportLogReader reader;
+  ASSERT_TRUE(reader.Open(path));
+
+  TransportLogRecord record;
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(std::chrono::milliseconds(5), record.time);
+  EXPECT_EQ("/a", record.topic);
+  EXPECT_EQ("ignition.msgs.StringMsg", record.type);
+  EXPECT_EQ(std::string("\0\1\2", 3), record.data);
+
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ("/b", record.topic);
+  EXPECT_EQ("ignition.msgs.Empty", record.type);
+  EXPECT_TRUE(record.data.empty());
+
+  EXPECT_FALSE(reader.Next(record));
+
+  // Truncated file
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(contents.data(), contents.size() - 2);
+  }
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_TRUE(reader.Next(record));
+  EXPECT_FALSE(reader.Next(record));
+
+  // Not a log
+  {
+    std::ofstream out(path, std::ios::trunc);
+    out << "not a log";
+  }
+  EXPECT_FALSE(reader.Open(path));
+  EXPECT_FALSE(reader.Open("/tmp/ign-gui-missing.tlog"));
+}
+
+/////////////////////////////////////////////////
+TEST(TransportLogTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Play))
+{
+  common::Console::SetVerbosity(4);
+
+  std::string path = "/tmp/ign-gui-transport-log-play.tlog";
+
+  // 20 messages, 5 ms apart
+  {
+    TransportLogWriter writer;
+    ASSERT_TRUE(writer.Open(path));
+
+    TransportLogRecord record;
+    record.topic = "/transport_log_play";
+    record.type = "ignition.msgs.Int32";
+    for (int i = 0; i < 20; ++i)
+    {
+      msgs::Int32 msg;
+      msg.set_data(i);
+      record.time = std::chrono::milliseconds(5 * i);
+      record.data = msg.SerializeAsString();
+      EXPECT_TRUE(writer.Write(record));
+    }
+  }
+
+  TransportLogPlayer player;
+  EXPECT_FALSE(player.Load("/tmp/ign-gui-missing.tlog"));
+  ASSERT_TRUE(player.Load(path));
+  EXPECT_EQ(20u, player.MessageCount());
+  EXPECT_EQ(std::chrono::milliseconds(95), player.Duration());
+
+  std::atomic<int> received{0};
+  std::atomic<int> last{-1};
+  std::function<void(const msgs::Int32 &)> cb = [&](const msgs::Int32 &_msg)
+  {
+    last = _msg.data();
+    received++;
+  };
+
+  transport::Node node;
+  EXPECT_TRUE(node.Subscribe("/transport_log_play", cb));
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  // Real time
+  player.Start(false);
+  EXPECT_FALSE(player.Finished());
+
+  int sleep = 0;
+  while ((!player.Finished() || received.load() < 20) && sleep++ < 100)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  EXPECT_TRUE(player.Finished());
+  EXPECT_EQ(20u, player.PublishedCount());
+  EXPECT_EQ(20, received.load());
+  EXPECT_EQ(19, last.load());
+  EXPECT_LE(std::chrono::milliseconds(95), player.Elapsed());
+
+  // As fast as possible
+  received = 0;
+  player.Start(true);
+
+  sleep = 0;
+  while ((!player.Finished() || received.load() < 20) && sleep++ < 100)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  EXPECT_TRUE(player.Finished());
+  EXPECT_EQ(20u, player.PublishedCount());
+  EXPECT_EQ(20, received.load());
+  EXPECT_EQ(0u, player.MaxBacklog());
+
+  // Stop before the end
+  player.Start(false);
+  player.Stop();
+  EXPECT_TRUE(player.Finished());
+  EXPECT_GT(20u, player.PublishedCount());
+}
@@ -17,7 +17,14 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 
@@ -25,7 +32,10 @@
 #include "ignition/gui/config.hh"
 #include "ignition/gui/Export.hh"
 #include "ignition/gui/ign.hh"
+#include "ignition/gui/Instrumentation.hh"
 #include "ignition/gui/MainWindow.hh"
+#include "ignition/gui/Plugin.hh"
+#include "ignition/gui/TransportLog.hh"
 
 int g_argc = 1;
 char* g_argv[] =
@@ -33,6 +43,249 @@ char* g_argv[] =
   reinterpret_cast<char*>(const_cast<char*>("./ignition")),
 };
 
+/// \brief Type of main window, set to headless by cmdHeadless.
+ignition::gui::WindowType g_mainWindowType =
+    ignition::gui::WindowType::kMainWindow;
+
+namespace
+{
+  /// \brief Durations in milliseconds, summarized at the end of a replay.
+  class Samples
+  {
+    /// \brief Add a duration.
+    /// \param[in] _ms Duration in milliseconds.
+    public: void Add(const double _ms)
+    {
+      this->values.push_back(_ms);
+    }
+
+    /// \brief Print the count, mean, percentiles and maximum.
+    /// \param[in] _out Stream to print to.
+    public: void Print(std::ostream &_out)
+    {
+      if (this->values.empty())
+      {
+        _out << "no samples" << std::endl;
+        return;
+      }
+
+      std::sort(this->values.begin(), this->values.end());
+      double total{0.0};
+      for (auto value : this->values)
+        total += value;
+
+      auto percentile = [this](double _p)
+      {
+        auto i = static_cast<size_t>(_p * (this->values.size() - 1));
+        return this->values[i];
+      };
+
+      _out << std::fixed << std::setprecision(3)
+           << "count " << this->values.size()
+           << ", mean " << total / this->values.size()
+           << ", p50 " << percentile(0.5)
+           << ", p95 " << percentile(0.95)
+           << ", p99 " << percentile(0.99)
+           << ", max " << this->values.back()
+           << ", total " << total << std::endl;
+    }
+
+    /// \brief All durations.
+    private: std::vector<double> values;
+  };
+
+  /// \brief Application which measures how long each plugin takes to handle
+  /// the events delivered to it, such as queued slot calls coming from
+  /// transport callbacks and timers, as well as frame times and event loop
+  /// latency.
+  class ReplayApplication : public ignition::gui::Application
+  {
+    /// \brief Constructor
+    /// \param[in] _argc Argument count.
+    /// \param[in] _argv Argument values.
+    public: ReplayApplication(int &_argc, char **_argv)
+      : Application(_argc, _argv, ignition::gui::WindowType::kHeadless)
+    {
+    }
+
+    /// \brief Start measuring.
+    public: void Start()
+    {
+      auto win = this->findChild<ignition::gui::MainWindow *>();
+
+      // Only keep what the plugins record during the replay
+      if (win)
+      {
+        for (auto plugin : win->findChildren<ignition::gui::Plugin *>())
+          plugin->ResetStatistics();
+      }
+
+      if (win && win->QuickWindow())
+      {
+        // Frame signals may come from the render thread
+        auto quickWin = win->QuickWindow();
+        this->connect(quickWin, &QQuickWindow::beforeSynchronizing, this,
+            [this]()
+            {
+              std::lock_guard<std::mutex> lock(this->frameMutex);
+              this->frameStart = std::chrono::steady_clock::now();
+            }, Qt::DirectConnection);
+        this->connect(quickWin, &QQuickWindow::frameSwapped, this,
+            [this]()
+            {
+              std::lock_guard<std::mutex> lock(this->frameMutex);
+              auto now = std::chrono::steady_clock::now();
+              if (this->lastFrame.time_since_epoch().count() != 0)
+              {
+                this->frameIntervals.Add(std::chrono::duration<double,
+                    std::milli>(now - this->lastFrame).count());
+              }
+              if (this->frameStart.time_since_epoch().count() != 0)
+              {
+                this->frameTimes.Add(std::chrono::duration<double,
+                    std::milli>(now - this->frameStart).count());
+              }
+              this->lastFrame = now;
+            }, Qt::DirectConnection);
+      }
+
+      // The event loop latency is how late a periodic timer fires
+      auto probe = new QTimer(this);
+      probe->setTimerType(Qt::PreciseTimer);
+      this->lastProbe = std::chrono::steady_clock::now();
+      this->connect(probe, &QTimer::timeout, this, [this]()
+          {
+            auto now = std::chrono::steady_clock::now();
+            auto late = std::chrono::duration<double, std::milli>(
+                now - this->lastProbe).count() - kProbePeriod;
+            this->loopLatency.Add(std::max(0.0, late));
+            this->lastProbe = now;
+          });
+      probe->start(static_cast<int>(kProbePeriod));
+
+      this->measuring = true;
+    }
+
+    /// \brief Stop measuring.
+    public: void Stop()
+    {
+      this->measuring = false;
+    }
+
+    // Documentation inherited
+    public: bool notify(QObject *_receiver, QEvent *_event) override
+    {
+      // Plugins live in the GUI thread
+      if (!this->measuring || QThread::currentThread() != this->thread())
+        return Application::notify(_receiver, _event);
+
+      auto start = std::chrono::steady_clock::now();
+      auto result = Application::notify(_receiver, _event);
+      auto ms = std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start).count();
+
+      // Attribute the event to the plugin which owns its receiver. Nested
+      // events are included in the time of the outer ones.
+      for (auto obj = _receiver; obj != nullptr; obj = obj->parent())
+      {
+        auto plugin = qobject_cast<ignition::gui::Plugin *>(obj);
+        if (!plugin)
+          continue;
+
+        auto name = plugin->CardItem() ?
+            plugin->CardItem()->objectName().toStdString() : plugin->Title();
+        this->handlers[name].Add(ms);
+        break;
+      }
+      return result;
+    }
+
+    /// \brief Print all measurements.
+    /// \param[in] _out Stream to print to.
+    public: void Print(std::ostream &_out)
+    {
+      std::lock_guard<std::mutex> lock(this->frameMutex);
+      _out << "Frame interval (ms): ";
+      this->frameIntervals.Print(_out);
+      _out << "Frame time (ms): ";
+      this->frameTimes.Print(_out);
+      _out << "Event loop latency (ms): ";
+      this->loopLatency.Print(_out);
+      _out << "Handler latency by plugin (ms):" << std::endl;
+      if (this->handlers.empty())
+        _out << "  no events delivered to plugins" << std::endl;
+      for (auto &handler : this->handlers)
+      {
+        _out << "  " << handler.first << ": ";
+        handler.second.Print(_out);
+      }
+
+      // Statistics recorded by the plugins themselves
+      auto win = this->findChild<ignition::gui::MainWindow *>();
+      if (!win)
+        return;
+
+      _out << "Instrumented handlers and queues:" << std::endl;
+      bool any{false};
+      for (auto plugin : win->findChildren<ignition::gui::Plugin *>())
+      {
+        for (const auto &handler : plugin->HandlerStatistics())
+        {
+          any = true;
+          auto totalMs = std::chrono::duration<double, std::milli>(
+              handler.total).count();
+          _out << "  " << plugin->Title() << " " << handler.name
+               << ": count " << handler.count
+               << ", mean " << totalMs / handler.count
+               << ", max " << std::chrono::duration<double, std::milli>(
+                  handler.max).count()
+               << ", total " << totalMs << " ms" << std::endl;
+        }
+        for (const auto &queue : plugin->QueueStatistics())
+        {
+          any = true;
+          _out << "  " << plugin->Title() << " " << queue.name
+               << ": depth " << queue.depth << ", max depth "
+               << queue.maxDepth << std::endl;
+        }
+      }
+      if (!any)
+        _out << "  none recorded" << std::endl;
+    }
+
+    /// \brief Period of the event loop probe in milliseconds
+    private: static constexpr double kProbePeriod{10.0};
+
+    /// \brief Whether events are being measured
+    private: bool measuring{false};
+
+    /// \brief Time spent handling events, by plugin
+    private: std::map<std::string, Samples> handlers;
+
+    /// \brief Time between frames
+    private: Samples frameIntervals;
+
+    /// \brief Time from the start of synchronization until a frame is
+    /// swapped
+    private: Samples frameTimes;
+
+    /// \brief Delay of the event loop probe
+    private: Samples loopLatency;
+
+    /// \brief Protects frame measurements
+    private: std::mutex frameMutex;
+
+    /// \brief Start of the current frame
+    private: std::chrono::steady_clock::time_point frameStart;
+
+    /// \brief Time of the last frame
+    private: std::chrono::steady_clock::time_point lastFrame;
+
+    /// \brief Time the probe last fired
+    private: std::chrono::steady_clock::time_point lastProbe;
+  };
+}
+
 //////////////////////////////////////////////////
 void startConsoleLog()
 {
@@ -97,7 +350,7 @@ extern "C" IGNITION_GUI_VISIBLE void cmdConfig(const char *_config)
 {
   startConsoleLog();
 
-  ignition::gui::Application app(g_argc, g_argv);
+  ignition::gui::Application app(g_argc, g_argv, g_mainWindowType);
 
   if (!app.findChild<ignition::gui::MainWindow *>())
   {
@@ -112,6 +365,80 @@ extern "C" IGNITION_GUI_VISIBLE void cmdConfig(const char *_config)
   app.exec();
 }
 
+//////////////////////////////////////////////////
+extern "C" IGNITION_GUI_VISIBLE void cmdReplay(const char *_config,
+    const char *_log, int _fast)
+{
+  startConsoleLog();
+
+  ReplayApplication app(g_argc, g_argv);
+  ignition::gui::setInstrumentationEnabled(true);
+
+  if (!app.findChild<ignition::gui::MainWindow *>())
+  {
+    return;
+  }
+
+  std::string config(_config);
+  if ((config.empty() && !app.LoadDefaultConfig()) ||
+      (!config.empty() && !app.LoadConfig(config)))
+  {
+    return;
+  }
+
+  ignition::gui::TransportLogPlayer player;
+  if (!player.Load(_log))
+  {
+    return;
+  }
+
+  // Give the plugins time to discover the advertised topics before
+  // publishing, then quit shortly after the last message, so the GUI
+  // handles the remaining ones
+  QTimer::singleShot(1000, &app, [&]()
+      {
+        app.Start();
+        player.Start(_fast != 0);
+
+        auto poll = new QTimer(&app);
+        QObject::connect(poll, &QTimer::timeout, &app, [&, poll]()
+            {
+              if (!player.Finished())
+                return;
+              poll->stop();
+              QTimer::singleShot(500, &app, &QCoreApplication::quit);
+            });
+        poll->start(50);
+      });
+
+  app.exec();
+  app.Stop();
+  player.Stop();
+
+  std::cout << "Replayed [" << player.PublishedCount() << "] of ["
+            << player.MessageCount() << "] messages from [" << _log
+            << "] in " << std::fixed << std::setprecision(3)
+            << std::chrono::duration<double>(player.Elapsed()).count()
+            << " s (recorded " << std::chrono::duration<double>(
+               player.Duration()).count() << " s, "
+            << (_fast ? "as fast as possible" : "real time") << ")"
+            << std::endl;
+  if (!_fast)
+  {
+    std::cout << "Publishing backlog: max " << player.MaxBacklog()
+              << " messages, max lag "
+              << std::chrono::duration<double, std::milli>(
+                 player.MaxLag()).count() << " ms" << std::endl;
+  }
+  app.Print(std::cout);
+}
+
+//////////////////////////////////////////////////
+extern "C" IGNITION_GUI_VISIBLE void cmdHeadless()
+{
+  g_mainWindowType = ignition::gui::WindowType::kHeadless;
+}
+
 //////////////////////////////////////////////////
 extern "C" IGNITION_GUI_VISIBLE void cmdVerbose(const char *_verbosity)
 {
@@ -123,7 +450,7 @@ extern "C" IGNITION_GUI_VISIBLE void cmdEmptyWindow()
 {
   startConsoleLog();
 
-  ignition::gui::Application app(g_argc, g_argv);
+  ignition::gui::Application app(g_argc, g_argv, g_mainWindowType);
 
   if (!app.findChild<ignition::gui::MainWindow *>())
   {
@@ -42,7 +42,6 @@
 #include "ignition/gui/Application.hh"
 #include "ignition/gui/Conversions.hh"
 #include "ignition/gui/GuiEvents.hh"
-#include "ignition/gui/MainWindow.hh"
 
 #include <ignition/transport/Node.hh>
 
@@ -93,7 +92,7 @@ class ignition::gui::plugins::CameraTrackingPrivate
 
   /// \brief Process key releases
   /// \param[in] _e Key release event
-  public: void HandleKeyRelease(events::KeyReleaseOnScene *_e);
+  public: void HandleKeyRelease(const events::KeyReleaseOnScene &_e);
 
   /// \brief Protects variable changed through services.
   public: std::mutex mutex;
@@ -467,41 +466,23 @@ void CameraTracking::LoadConfig(const tinyxml2::XMLElement *)
   if (this->title.empty())
     this->title = "Camera tracking";
 
-  App()->findChild<MainWindow *>()->installEventFilter(this);
-}
-
-/////////////////////////////////////////////////
-void CameraTrackingPrivate::HandleKeyRelease(events::KeyReleaseOnScene *_e)
-{
-  if (_e->Key().Key() == Qt::Key_Escape)
-  {
-    if (!this->followTarget.empty())
-    {
-      this->followTarget = std::string();
+  // Follow targets after the scene managers have moved them
+  this->AddRenderHook(RenderPhase::kRender, "CameraTracking::OnRender",
+      [this]() {this->dataPtr->OnRender();}, 10);
 
-      _e->accept();
-    }
-  }
+  this->SubscribeEvent<events::KeyReleaseOnScene>(
+      [this](const events::KeyReleaseOnScene &_event)
+      {
+        this->dataPtr->HandleKeyRelease(_event);
+      });
 }
 
 /////////////////////////////////////////////////
-bool CameraTracking::eventFilter(QObject *_obj, QEvent *_event)
+void CameraTrackingPrivate::HandleKeyRelease(
+    const events::KeyReleaseOnScene &_e)
 {
-  if (_event->type() == events::Render::kType)
-  {
-    this->dataPtr->OnRender();
-  }
-  else if (_event->type() == events::KeyReleaseOnScene::kType)
-  {
-    events::KeyReleaseOnScene *keyEvent =
-      static_cast<events::KeyReleaseOnScene*>(_event);
-    if (keyEvent)
-    {
-      this->dataPtr->HandleKeyRelease(keyEvent);
-    }
-  }
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+  if (_e.Key().Key() == Qt::Key_Escape)
+    this->followTarget = std::string();
 }
 
 // Register this plugin
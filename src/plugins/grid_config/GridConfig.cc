@@ -146,33 +146,27 @@ void GridConfig::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     }
   }
 
-  ignition::gui::App()->findChild<
-      ignition::gui::MainWindow *>()->installEventFilter(this);
+  this->AddRenderHook(RenderPhase::kRender, "GridConfig::OnRender",
+      [this]() {this->OnRender();});
 }
 
 /////////////////////////////////////////////////
-bool GridConfig::eventFilter(QObject *_obj, QEvent *_event)
+void GridConfig::OnRender()
 {
-  if (_event->type() == ignition::gui::events::Render::kType)
-  {
-    if (nullptr == this->dataPtr->scene)
-      this->dataPtr->scene = rendering::sceneFromFirstRenderEngine();
+  if (nullptr == this->dataPtr->scene)
+    this->dataPtr->scene = rendering::sceneFromFirstRenderEngine();
 
-    if (nullptr != this->dataPtr->scene)
-    {
-      // Create grid setup at startup
-      this->CreateGrids();
+  if (nullptr != this->dataPtr->scene)
+  {
+    // Create grid setup at startup
+    this->CreateGrids();
 
-      // Update combo box
-      this->RefreshList();
+    // Update combo box
+    this->RefreshList();
 
-      // Update selected grid
-      this->UpdateGrid();
-    }
+    // Update selected grid
+    this->UpdateGrid();
   }
-
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
 }
 
 /////////////////////////////////////////////////
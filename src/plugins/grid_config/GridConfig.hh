@@ -66,8 +66,8 @@ namespace gui
     // Documentation inherited
     public: void LoadConfig(const tinyxml2::XMLElement *) override;
 
-    // Documentation inherited
-    protected: bool eventFilter(QObject *_obj, QEvent *_event) override;
+    /// \brief Update grids, called from the render thread on every frame.
+    private: void OnRender();
 
     /// \brief Create grids defined at startup
     public: void CreateGrids();
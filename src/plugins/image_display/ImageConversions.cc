@@ -0,0 +1,621 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ImageConversions.hh"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define IGN_GUI_IMAGE_SSE2
+#endif
+
+#include <ignition/common/Console.hh>
+
+using namespace ignition;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Get an output image with the given size and format, reusing the
+/// given image's memory if possible.
+/// \param[in, out] _image Image to reuse and output.
+/// \param[in] _width Width.
+/// \param[in] _height Height.
+/// \param[in] _format Format.
+static void prepareImage(QImage &_image, unsigned int _width,
+    unsigned int _height, QImage::Format _format)
+{
+  // Writing to a shared image would detach it, which copies it first
+  if (_image.isNull() || !_image.isDetached() ||
+      _image.width() != static_cast<int>(_width) ||
+      _image.height() != static_cast<int>(_height) ||
+      _image.format() != _format)
+  {
+    _image = QImage(_width, _height, _format);
+  }
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::plugins::Gray16ToGray8(const uint16_t *_src,
+    size_t _count, uint16_t _min, uint16_t _max, uint8_t *_dst)
+{
+  // Fixed point scale, so the loop has no floats nor branches and can be
+  // vectorized by the compiler. Rounded up so _max maps to 255.
+  uint32_t range = _max > _min ? _max - _min : 1u;
+  uint32_t scale = ((255u << 16) + range - 1) / range;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    uint32_t v = std::min(std::max(_src[i], _min), _max);
+    _dst[i] = static_cast<uint8_t>(((v - _min) * scale) >> 16);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the linear mapping from depth to [0, 255], as in
+/// offset + value * scale.
+/// \param[in] _min Value mapped to 0, or 255 if inverted.
+/// \param[in] _max Value mapped to 255, or 0 if inverted.
+/// \param[in] _invert True to invert the mapping.
+/// \param[out] _offset Offset.
+/// \param[out] _scale Scale.
+static void depthMapping(float _min, float _max, bool _invert,
+    float &_offset, float &_scale)
+{
+  float range = _max - _min;
+  if (!(std::fabs(range) > std::numeric_limits<float>::epsilon()))
+    range = 1.0f;
+  _scale = 255.0f / range;
+  _offset = -_min * _scale;
+  if (_invert)
+  {
+    _offset = 255.0f - _offset;
+    _scale = -_scale;
+  }
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::plugins::DepthToGray8(const float *_src, size_t _count,
+    float _min, float _max, bool _invert, uint8_t *_dst, float *_farthest)
+{
+  float offset;
+  float scale;
+  depthMapping(_min, _max, _invert, offset, scale);
+
+  const float lowest = std::numeric_limits<float>::lowest();
+  float farthest = lowest;
+
+  size_t i = 0;
+#ifdef IGN_GUI_IMAGE_SSE2
+  const __m128 absMaskV = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  const __m128 infV = _mm_set1_ps(std::numeric_limits<float>::infinity());
+  const __m128 lowestV = _mm_set1_ps(lowest);
+  const __m128 offsetV = _mm_set1_ps(offset);
+  const __m128 scaleV = _mm_set1_ps(scale);
+  const __m128 maxOutV = _mm_set1_ps(255.0f);
+  const __m128 zeroV = _mm_setzero_ps();
+  __m128 farthestV = lowestV;
+  for (; i + 8 <= _count; i += 8)
+  {
+    __m128 a = _mm_loadu_ps(_src + i);
+    __m128 b = _mm_loadu_ps(_src + i + 4);
+
+    // False for NaN and infinity
+    __m128 finiteA = _mm_cmplt_ps(_mm_and_ps(a, absMaskV), infV);
+    __m128 finiteB = _mm_cmplt_ps(_mm_and_ps(b, absMaskV), infV);
+
+    farthestV = _mm_max_ps(farthestV, _mm_or_ps(_mm_and_ps(finiteA, a),
+        _mm_andnot_ps(finiteA, lowestV)));
+    farthestV = _mm_max_ps(farthestV, _mm_or_ps(_mm_and_ps(finiteB, b),
+        _mm_andnot_ps(finiteB, lowestV)));
+
+    a = _mm_add_ps(offsetV, _mm_mul_ps(a, scaleV));
+    b = _mm_add_ps(offsetV, _mm_mul_ps(b, scaleV));
+    a = _mm_and_ps(_mm_min_ps(_mm_max_ps(a, zeroV), maxOutV), finiteA);
+    b = _mm_and_ps(_mm_min_ps(_mm_max_ps(b, zeroV), maxOutV), finiteB);
+
+    __m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(a),
+        _mm_cvttps_epi32(b));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(_dst + i),
+        _mm_packus_epi16(packed, packed));
+  }
+  float lanes[4];
+  _mm_storeu_ps(lanes, farthestV);
+  farthest = std::max(std::max(lanes[0], lanes[1]),
+      std::max(lanes[2], lanes[3]));
+#endif
+
+  for (; i < _count; ++i)
+  {
+    if (!std::isfinite(_src[i]))
+    {
+      _dst[i] = 0;
+      continue;
+    }
+
+    farthest = std::max(farthest, _src[i]);
+    float t = offset + _src[i] * scale;
+    if (t < 0.0f)
+      t = 0.0f;
+    else if (t > 255.0f)
+      t = 255.0f;
+    _dst[i] = static_cast<uint8_t>(t);
+  }
+
+  if (nullptr != _farthest)
+    *_farthest = farthest;
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::plugins::DepthToRgb8(const float *_src, size_t _count,
+    float _min, float _max, bool _invert, const uint8_t *_lut, uint8_t *_dst,
+    float *_farthest)
+{
+  float offset;
+  float scale;
+  depthMapping(_min, _max, _invert, offset, scale);
+
+  float farthest = std::numeric_limits<float>::lowest();
+  for (size_t i = 0; i < _count; ++i)
+  {
+    uint8_t *out = _dst + i * 3;
+    if (!std::isfinite(_src[i]))
+    {
+      out[0] = out[1] = out[2] = 0;
+      continue;
+    }
+
+    farthest = std::max(farthest, _src[i]);
+    float t = std::min(std::max(offset + _src[i] * scale, 0.0f), 255.0f);
+    const uint8_t *color = _lut + static_cast<unsigned int>(t) * 3;
+    out[0] = color[0];
+    out[1] = color[1];
+    out[2] = color[2];
+  }
+
+  if (nullptr != _farthest)
+    *_farthest = farthest;
+}
+
+/////////////////////////////////////////////////
+bool ignition::gui::plugins::DepthPercentiles(const char *_data,
+    unsigned int _width, unsigned int _height, unsigned int _step, float _low,
+    float _high, float &_min, float &_max)
+{
+  const unsigned int kGridSize = 64;
+  const unsigned int strideX = std::max(1u, _width / kGridSize);
+  const unsigned int strideY = std::max(1u, _height / kGridSize);
+
+  std::vector<float> samples;
+  samples.reserve((_width / strideX + 1) * (_height / strideY + 1));
+  for (unsigned int y = 0; y < _height; y += strideY)
+  {
+    auto row = reinterpret_cast<const float *>(_data + y * _step);
+    for (unsigned int x = 0; x < _width; x += strideX)
+    {
+      if (std::isfinite(row[x]))
+        samples.push_back(row[x]);
+    }
+  }
+
+  if (samples.empty())
+    return false;
+
+  // Clamped with the bounds first, so NaN becomes 0
+  _low = std::min(100.0f, std::max(0.0f, _low));
+  _high = std::min(100.0f, std::max(0.0f, _high));
+  if (_low > _high)
+    std::swap(_low, _high);
+
+  auto index = [&](float _percentile)
+  {
+    return static_cast<size_t>(_percentile / 100.0f * (samples.size() - 1));
+  };
+
+  auto lowIt = samples.begin() + index(_low);
+  std::nth_element(samples.begin(), lowIt, samples.end());
+  _min = *lowIt;
+
+  auto highIt = samples.begin() + index(_high);
+  std::nth_element(samples.begin(), highIt, samples.end());
+  _max = *highIt;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Build a color map lookup table from a polynomial approximation.
+/// \param[in] _coeffs Polynomial coefficients for red, green and blue, from
+/// the constant term up.
+/// \return 256 RGB entries.
+template<size_t N>
+static std::array<uint8_t, 768> buildLut(const float (&_coeffs)[3][N])
+{
+  std::array<uint8_t, 768> lut;
+  for (unsigned int i = 0; i < 256; ++i)
+  {
+    float t = i / 255.0f;
+    for (unsigned int c = 0; c < 3; ++c)
+    {
+      // Horner's method
+      float v = 0.0f;
+      for (size_t k = N; k > 0; --k)
+        v = v * t + _coeffs[c][k - 1];
+      v = std::min(std::max(v, 0.0f), 1.0f);
+      lut[i * 3 + c] = static_cast<uint8_t>(std::lround(v * 255.0f));
+    }
+  }
+  return lut;
+}
+
+/////////////////////////////////////////////////
+const uint8_t *ignition::gui::plugins::ColorMapLut(ColorMap _colorMap)
+{
+  // Polynomial fit of Turbo, by Ruofei Du
+  static const float kTurbo[3][6] = {
+      {0.13572138f, 4.61539260f, -42.66032258f, 132.13108234f,
+       -152.94239396f, 59.28637943f},
+      {0.09140261f, 2.19418839f, 4.84296658f, -14.18503333f, 4.27729857f,
+       2.82956604f},
+      {0.10667330f, 12.64194608f, -60.58204836f, 110.36276771f,
+       -89.90310912f, 27.34824973f}};
+
+  // Polynomial fit of Viridis, by Matt Zucker
+  static const float kViridis[3][7] = {
+      {0.2777273272234177f, 0.1050930431085774f, -0.3308618287255563f,
+       -4.634230498983486f, 6.228269936347081f, 4.776384997670288f,
+       -5.435455855934631f},
+      {0.005407344544966578f, 1.404613529898575f, 0.214847559468213f,
+       -5.799100973351585f, 14.17993336680509f, -13.74514537774601f,
+       4.645852612178535f},
+      {0.3340998053353061f, 1.384590162594685f, 0.09509516302823659f,
+       -19.33244095627987f, 56.69055260068105f, -65.35303263337234f,
+       26.3124352495832f}};
+
+  switch (_colorMap)
+  {
+    case ColorMap::kTurbo:
+    {
+      static const auto lut = buildLut(kTurbo);
+      return lut.data();
+    }
+    case ColorMap::kViridis:
+    {
+      static const auto lut = buildLut(kViridis);
+      return lut.data();
+    }
+    case ColorMap::kGray:
+    default:
+      return nullptr;
+  }
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::plugins::MinMax16(const uint16_t *_src, size_t _count,
+    uint16_t &_min, uint16_t &_max)
+{
+  uint16_t min = std::numeric_limits<uint16_t>::max();
+  uint16_t max = std::numeric_limits<uint16_t>::lowest();
+  for (size_t i = 0; i < _count; ++i)
+  {
+    min = std::min(min, _src[i]);
+    max = std::max(max, _src[i]);
+  }
+  _min = min;
+  _max = max;
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::plugins::BayerToRgb8(const uint8_t *_src,
+    unsigned int _width, unsigned int _height, unsigned int _srcStep,
+    BayerPattern _pattern, uint8_t *_dst, unsigned int _dstStep)
+{
+  // Index of red within a 2x2 block, ordered top-left, top-right,
+  // bottom-left, bottom-right. Blue is on the opposite corner and green on
+  // the other two.
+  int red{0};
+  switch (_pattern)
+  {
+    case BayerPattern::kRggb:
+      red = 0;
+      break;
+    case BayerPattern::kBggr:
+      red = 3;
+      break;
+    case BayerPattern::kGbrg:
+      red = 2;
+      break;
+    case BayerPattern::kGrbg:
+      red = 1;
+      break;
+  }
+  const int blue = 3 - red;
+  const int green0 = (red == 0 || red == 3) ? 1 : 0;
+  const int green1 = 3 - green0;
+
+  const unsigned int evenWidth = _width & ~1u;
+  const unsigned int evenHeight = _height & ~1u;
+  for (unsigned int y = 0; y < evenHeight; y += 2)
+  {
+    const uint8_t *row0 = _src + y * _srcStep;
+    const uint8_t *row1 = row0 + _srcStep;
+    uint8_t *out0 = _dst + y * _dstStep;
+    uint8_t *out1 = out0 + _dstStep;
+    for (unsigned int x = 0; x < evenWidth; x += 2)
+    {
+      const uint8_t block[4] = {row0[x], row0[x + 1], row1[x], row1[x + 1]};
+      const uint8_t r = block[red];
+      const uint8_t g = static_cast<uint8_t>(
+          (block[green0] + block[green1] + 1) >> 1);
+      const uint8_t b = block[blue];
+
+      uint8_t *p = out0 + x * 3;
+      p[0] = r; p[1] = g; p[2] = b;
+      p[3] = r; p[4] = g; p[5] = b;
+      p = out1 + x * 3;
+      p[0] = r; p[1] = g; p[2] = b;
+      p[3] = r; p[4] = g; p[5] = b;
+    }
+
+    // Odd width, repeat last column
+    if (evenWidth != _width)
+    {
+      std::memcpy(out0 + evenWidth * 3, out0 + (evenWidth - 1) * 3, 3);
+      std::memcpy(out1 + evenWidth * 3, out1 + (evenWidth - 1) * 3, 3);
+    }
+  }
+
+  // Odd height, repeat last row
+  if (evenHeight != _height)
+  {
+    std::memcpy(_dst + evenHeight * _dstStep,
+        _dst + (evenHeight - 1) * _dstStep, _width * 3);
+  }
+}
+
+/////////////////////////////////////////////////
+bool ignition::gui::plugins::ConvertFrame(const ImageFramePtr &_frame,
+    QImage &_image, const DepthOptions &_options)
+{
+  if (!_frame)
+    return false;
+
+  const unsigned int width = _frame->width;
+  const unsigned int height = _frame->height;
+  const char *buffer = _frame->data.c_str();
+
+  // Formats which Qt can display directly are wrapped without copying. The
+  // image holds a reference to the frame until it's no longer used.
+  QImage::Format directFormat = QImage::Format_Invalid;
+  unsigned int pixelSize{1};
+  bool swapRgb{false};
+  switch (_frame->format)
+  {
+    case msgs::PixelFormatType::RGB_INT8:
+      directFormat = QImage::Format_RGB888;
+      pixelSize = 3;
+      break;
+    case msgs::PixelFormatType::BGR_INT8:
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+      directFormat = QImage::Format_BGR888;
+#else
+      directFormat = QImage::Format_RGB888;
+      swapRgb = true;
+#endif
+      pixelSize = 3;
+      break;
+    case msgs::PixelFormatType::RGBA_INT8:
+      directFormat = QImage::Format_RGBA8888;
+      pixelSize = 4;
+      break;
+    case msgs::PixelFormatType::BGRA_INT8:
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+      // ARGB32 is stored as BGRA in little endian machines
+      directFormat = QImage::Format_ARGB32;
+#else
+      directFormat = QImage::Format_RGBA8888;
+      swapRgb = true;
+#endif
+      pixelSize = 4;
+      break;
+    case msgs::PixelFormatType::L_INT16:
+      pixelSize = 2;
+      break;
+    case msgs::PixelFormatType::R_FLOAT32:
+      pixelSize = 4;
+      break;
+    case msgs::PixelFormatType::L_INT8:
+    case msgs::PixelFormatType::BAYER_RGGB8:
+    case msgs::PixelFormatType::BAYER_BGGR8:
+    case msgs::PixelFormatType::BAYER_GBRG8:
+    case msgs::PixelFormatType::BAYER_GRBG8:
+      break;
+    default:
+      ignwarn << "Unsupported image type: " << _frame->format << std::endl;
+      return false;
+  }
+
+  const unsigned int step = _frame->step > 0 ? _frame->step :
+      width * pixelSize;
+  if (width == 0 || height == 0 || step < width * pixelSize ||
+      _frame->data.size() < static_cast<size_t>(step) * height)
+  {
+    ignwarn << "Image data has [" << _frame->data.size()
+            << "] bytes, expected [" << step * height << "] for ["
+            << width << "x" << height << "] image" << std::endl;
+    return false;
+  }
+
+  if (directFormat != QImage::Format_Invalid)
+  {
+    _image = QImage(reinterpret_cast<const uchar *>(buffer), width, height,
+        step, directFormat,
+        [](void *_info)
+        {
+          delete static_cast<ImageFramePtr *>(_info);
+        },
+        new ImageFramePtr(_frame));
+
+    // Older Qt versions have no BGR formats, swapping makes a copy
+    if (swapRgb)
+      _image = _image.rgbSwapped();
+
+    return true;
+  }
+
+  // Bayer to RGB
+  BayerPattern pattern{BayerPattern::kRggb};
+  bool bayer{true};
+  switch (_frame->format)
+  {
+    case msgs::PixelFormatType::BAYER_RGGB8:
+      pattern = BayerPattern::kRggb;
+      break;
+    case msgs::PixelFormatType::BAYER_BGGR8:
+      pattern = BayerPattern::kBggr;
+      break;
+    case msgs::PixelFormatType::BAYER_GBRG8:
+      pattern = BayerPattern::kGbrg;
+      break;
+    case msgs::PixelFormatType::BAYER_GRBG8:
+      pattern = BayerPattern::kGrbg;
+      break;
+    default:
+      bayer = false;
+      break;
+  }
+
+  if (bayer)
+  {
+    if (width < 2 || height < 2)
+    {
+      ignwarn << "Bayer images must be at least 2x2." << std::endl;
+      return false;
+    }
+
+    prepareImage(_image, width, height, QImage::Format_RGB888);
+    BayerToRgb8(reinterpret_cast<const uint8_t *>(buffer), width, height,
+        step, pattern, _image.bits(), _image.bytesPerLine());
+    return true;
+  }
+
+  // Single channel images are converted row by row because QImage rows are
+  // aligned to 4 bytes and the source rows may be padded
+  if (_frame->format == msgs::PixelFormatType::L_INT8)
+  {
+    prepareImage(_image, width, height, QImage::Format_Grayscale8);
+    for (unsigned int y = 0; y < height; ++y)
+      std::memcpy(_image.scanLine(y), buffer + y * step, width);
+    return true;
+  }
+
+  if (_frame->format == msgs::PixelFormatType::L_INT16)
+  {
+    prepareImage(_image, width, height, QImage::Format_Grayscale8);
+    uint16_t min = std::numeric_limits<uint16_t>::max();
+    uint16_t max = std::numeric_limits<uint16_t>::lowest();
+    uint16_t rowMin{0};
+    uint16_t rowMax{0};
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      MinMax16(reinterpret_cast<const uint16_t *>(buffer + y * step), width,
+          rowMin, rowMax);
+      min = std::min(min, rowMin);
+      max = std::max(max, rowMax);
+    }
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      Gray16ToGray8(reinterpret_cast<const uint16_t *>(buffer + y * step),
+          width, min, max, _image.scanLine(y));
+    }
+    return true;
+  }
+
+  // R_FLOAT32
+  float min{0.0f};
+  float max{0.0f};
+  bool track{false};
+  switch (_options.rangeMode)
+  {
+    case DepthRangeMode::kFixed:
+      min = _options.min;
+      max = _options.max;
+      break;
+    case DepthRangeMode::kPercentile:
+      if (!DepthPercentiles(buffer, width, height, step,
+          _options.lowPercentile, _options.highPercentile, min, max))
+      {
+        min = 0.0f;
+        max = 1.0f;
+      }
+      break;
+    case DepthRangeMode::kAuto:
+    default:
+      // From 0 to the farthest sample. The farthest point is found while
+      // converting, and only if it's farther is the frame converted again.
+      if (DepthPercentiles(buffer, width, height, step, 100.0f, 100.0f,
+          min, max))
+      {
+        max = std::max(max, 0.0f);
+      }
+      min = 0.0f;
+      track = true;
+      break;
+  }
+
+  auto lut = ColorMapLut(_options.colorMap);
+  prepareImage(_image, width, height, nullptr == lut ?
+      QImage::Format_Grayscale8 : QImage::Format_RGB888);
+
+  float farthest = std::numeric_limits<float>::lowest();
+  float rowFarthest{0.0f};
+  auto convert = [&]()
+  {
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      auto row = reinterpret_cast<const float *>(buffer + y * step);
+      if (nullptr == lut)
+      {
+        DepthToGray8(row, width, min, max, _options.invert,
+            _image.scanLine(y), track ? &rowFarthest : nullptr);
+      }
+      else
+      {
+        DepthToRgb8(row, width, min, max, _options.invert, lut,
+            _image.scanLine(y), track ? &rowFarthest : nullptr);
+      }
+      if (track)
+        farthest = std::max(farthest, rowFarthest);
+    }
+  };
+
+  convert();
+  if (track && farthest > max)
+  {
+    max = farthest;
+    track = false;
+    convert();
+  }
+  return true;
+}
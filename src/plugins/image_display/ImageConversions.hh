@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_PLUGINS_IMAGECONVERSIONS_HH_
+#define IGNITION_GUI_PLUGINS_IMAGECONVERSIONS_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <ignition/msgs/image.pb.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include "ignition/gui/qt.h"
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Image data received from transport. It's shared between the
+  /// transport thread, the GUI thread and the images which point to it, so
+  /// the pixels are never copied after being received.
+  struct ImageFrame
+  {
+    /// \brief Pixel data.
+    std::string data;
+
+    /// \brief Image width in pixels.
+    unsigned int width{0};
+
+    /// \brief Image height in pixels.
+    unsigned int height{0};
+
+    /// \brief Row size in bytes.
+    unsigned int step{0};
+
+    /// \brief Pixel format.
+    msgs::PixelFormatType format{msgs::PixelFormatType::UNKNOWN_PIXEL_FORMAT};
+  };
+
+  /// \brief Shared pointer to an image frame.
+  using ImageFramePtr = std::shared_ptr<const ImageFrame>;
+
+  /// \brief How the displayed range of depth images is chosen.
+  enum class DepthRangeMode
+  {
+    /// \brief From 0 to the farthest finite value of each frame. The
+    /// farthest sample of the percentile grid is used as a first guess, and
+    /// the frame is only converted a second time if a farther point is found
+    /// while converting it.
+    kAuto,
+
+    /// \brief Fixed minimum and maximum.
+    kFixed,
+
+    /// \brief Percentiles of a subsampled grid of each frame, which ignores
+    /// outliers and is cheaper than scanning the whole frame.
+    kPercentile
+  };
+
+  /// \brief Color maps for depth images.
+  enum class ColorMap
+  {
+    /// \brief Grayscale.
+    kGray,
+
+    /// \brief Google's Turbo.
+    kTurbo,
+
+    /// \brief Matplotlib's Viridis.
+    kViridis
+  };
+
+  /// \brief Options for converting depth images.
+  struct DepthOptions
+  {
+    /// \brief How the range is chosen.
+    DepthRangeMode rangeMode{DepthRangeMode::kAuto};
+
+    /// \brief Minimum value for the fixed range.
+    float min{0.0f};
+
+    /// \brief Maximum value for the fixed range.
+    float max{10.0f};
+
+    /// \brief Lower percentile for the percentile range, from 0 to 100.
+    float lowPercentile{2.0f};
+
+    /// \brief Upper percentile for the percentile range, from 0 to 100.
+    float highPercentile{98.0f};
+
+    /// \brief Color map.
+    ColorMap colorMap{ColorMap::kGray};
+
+    /// \brief True to map the minimum to the end of the color map, so that
+    /// closer is brighter in grayscale.
+    bool invert{true};
+  };
+
+  /// \brief Convert a frame into an image which can be displayed.
+  ///
+  /// * RGB, BGR, RGBA and BGRA frames are wrapped without copying, the image
+  ///   holds a reference to the frame.
+  /// * L_INT8 and L_INT16 frames are converted to Grayscale8.
+  /// * R_FLOAT32 frames are converted according to the depth options, to
+  ///   Grayscale8 or to RGB888 for color maps, in a single pass.
+  /// * Bayer frames are converted to RGB888.
+  ///
+  /// This is safe to call outside of the GUI thread.
+  /// \param[in] _frame Frame to convert.
+  /// \param[in, out] _image Output image. If it already has the right size
+  /// and format and isn't shared, its memory is reused.
+  /// \param[in] _options Options for depth images.
+  /// \return True if the frame could be converted.
+  bool ConvertFrame(const ImageFramePtr &_frame, QImage &_image,
+      const DepthOptions &_options = DepthOptions());
+
+  /// \brief Get the lookup table of a color map.
+  /// \param[in] _colorMap Color map.
+  /// \return 256 RGB entries, or nullptr for grayscale.
+  const uint8_t *ColorMapLut(ColorMap _colorMap);
+
+  /// \brief Compute percentiles of the finite values of a depth image,
+  /// sampled on a grid of at most 64x64 points.
+  /// \param[in] _data Image data.
+  /// \param[in] _width Image width.
+  /// \param[in] _height Image height.
+  /// \param[in] _step Row size in bytes.
+  /// \param[in] _low Lower percentile, from 0 to 100. Values outside the
+  /// range are clamped, and the percentiles are swapped if _low is larger
+  /// than _high.
+  /// \param[in] _high Upper percentile, from 0 to 100.
+  /// \param[out] _min Value at the lower percentile.
+  /// \param[out] _max Value at the upper percentile.
+  /// \return False if there are no finite samples.
+  bool DepthPercentiles(const char *_data, unsigned int _width,
+      unsigned int _height, unsigned int _step, float _low, float _high,
+      float &_min, float &_max);
+
+  /// \brief Map depth values to colors using a lookup table, in a single
+  /// pass. Values outside the range are clamped and non-finite values map to
+  /// black.
+  /// \param[in] _src Source values.
+  /// \param[in] _count Number of values.
+  /// \param[in] _min Value mapped to the start of the table.
+  /// \param[in] _max Value mapped to the end of the table.
+  /// \param[in] _invert True to map _min to the end of the table instead.
+  /// \param[in] _lut 256 RGB entries.
+  /// \param[out] _dst Destination, must hold _count RGB values.
+  /// \param[out] _farthest If not null, set to the largest finite value, or
+  /// to the lowest float if there are none.
+  void DepthToRgb8(const float *_src, size_t _count, float _min, float _max,
+      bool _invert, const uint8_t *_lut, uint8_t *_dst,
+      float *_farthest = nullptr);
+
+  /// \brief Bayer filter patterns, named after the colors of the top-left
+  /// 2x2 block.
+  enum class BayerPattern
+  {
+    /// \brief Red, green, green, blue.
+    kRggb,
+
+    /// \brief Blue, green, green, red.
+    kBggr,
+
+    /// \brief Green, blue, red, green.
+    kGbrg,
+
+    /// \brief Green, red, blue, green.
+    kGrbg
+  };
+
+  /// \brief Scale 16 bit intensities to 8 bits, so that _min maps to 0 and
+  /// _max maps to 255. Values outside the range are clamped.
+  /// \param[in] _src Source values.
+  /// \param[in] _count Number of values.
+  /// \param[in] _min Value mapped to 0.
+  /// \param[in] _max Value mapped to 255.
+  /// \param[out] _dst Destination, must hold _count values.
+  void Gray16ToGray8(const uint16_t *_src, size_t _count, uint16_t _min,
+      uint16_t _max, uint8_t *_dst);
+
+  /// \brief Scale depth values to 8 bit intensities, so that _min maps to 0
+  /// and _max maps to 255, or the opposite if inverted, so closer is
+  /// brighter. Values outside the range are clamped and non-finite values map
+  /// to 0.
+  /// \param[in] _src Source values.
+  /// \param[in] _count Number of values.
+  /// \param[in] _min Value mapped to 0, or 255 if inverted.
+  /// \param[in] _max Value mapped to 255, or 0 if inverted.
+  /// \param[in] _invert True to invert the mapping.
+  /// \param[out] _dst Destination, must hold _count values.
+  /// \param[out] _farthest If not null, set to the largest finite value, or
+  /// to the lowest float if there are none.
+  void DepthToGray8(const float *_src, size_t _count, float _min, float _max,
+      bool _invert, uint8_t *_dst, float *_farthest = nullptr);
+
+  /// \brief Get the minimum and maximum values of 16 bit data.
+  /// \param[in] _src Source values.
+  /// \param[in] _count Number of values.
+  /// \param[out] _min Minimum value.
+  /// \param[out] _max Maximum value.
+  void MinMax16(const uint16_t *_src, size_t _count, uint16_t &_min,
+      uint16_t &_max);
+
+  /// \brief Demosaic a Bayer image into RGB. Each 2x2 block uses its red and
+  /// blue samples and the average of its green samples.
+  /// \param[in] _src Source image.
+  /// \param[in] _width Image width, at least 2.
+  /// \param[in] _height Image height, at least 2.
+  /// \param[in] _srcStep Source row size in bytes.
+  /// \param[in] _pattern Bayer pattern.
+  /// \param[out] _dst Destination RGB image.
+  /// \param[in] _dstStep Destination row size in bytes.
+  void BayerToRgb8(const uint8_t *_src, unsigned int _width,
+      unsigned int _height, unsigned int _srcStep, BayerPattern _pattern,
+      uint8_t *_dst, unsigned int _dstStep);
+}
+}
+}
+
+#endif
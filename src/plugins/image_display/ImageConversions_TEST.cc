@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "ImageConversions.hh"
+
+using namespace ignition;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(ImageConversionsTest, Gray16ToGray8)
+{
+  std::vector<uint16_t> src{100, 100, 200, 300, 50, 400};
+  std::vector<uint8_t> dst(src.size());
+
+  Gray16ToGray8(src.data(), src.size(), 100, 300, dst.data());
+  EXPECT_EQ(0u, dst[0]);
+  EXPECT_EQ(0u, dst[1]);
+  EXPECT_NEAR(127, dst[2], 1);
+  EXPECT_EQ(255u, dst[3]);
+
+  // Clamped
+  EXPECT_EQ(0u, dst[4]);
+  EXPECT_EQ(255u, dst[5]);
+
+  uint16_t min{0};
+  uint16_t max{0};
+  MinMax16(src.data(), src.size(), min, max);
+  EXPECT_EQ(50u, min);
+  EXPECT_EQ(400u, max);
+}
+
+/////////////////////////////////////////////////
+TEST(ImageConversionsTest, DepthToGray8)
+{
+  // More than 8 values, so both vectorized and scalar paths are used
+  const float inf = std::numeric_limits<float>::infinity();
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> src{0.0f, 5.0f, 10.0f, 20.0f, -1.0f, inf, nan, 2.5f,
+      0.0f, 10.0f, nan};
+  std::vector<uint8_t> dst(src.size());
+
+  float farthest{0.0f};
+  DepthToGray8(src.data(), src.size(), 0.0f, 10.0f, true, dst.data(),
+      &farthest);
+  EXPECT_FLOAT_EQ(20.0f, farthest);
+
+  // Closer is brighter
+  EXPECT_EQ(255u, dst[0]);
+  EXPECT_NEAR(127, dst[1], 1);
+  EXPECT_EQ(0u, dst[2]);
+  EXPECT_EQ(0u, dst[3]);
+  EXPECT_EQ(255u, dst[4]);
+  EXPECT_EQ(0u, dst[5]);
+  EXPECT_EQ(0u, dst[6]);
+  EXPECT_NEAR(191, dst[7], 1);
+  EXPECT_EQ(255u, dst[8]);
+  EXPECT_EQ(0u, dst[9]);
+  EXPECT_EQ(0u, dst[10]);
+
+  DepthToGray8(&src[5], 2, 0.0f, 10.0f, true, dst.data(), &farthest);
+  EXPECT_FLOAT_EQ(std::numeric_limits<float>::lowest(), farthest);
+
+  // Not inverted, non-finite values are still 0
+  DepthToGray8(src.data(), src.size(), 0.0f, 10.0f, false, dst.data());
+  EXPECT_EQ(0u, dst[0]);
+  EXPECT_EQ(255u, dst[2]);
+  EXPECT_EQ(255u, dst[3]);
+  EXPECT_EQ(0u, dst[4]);
+  EXPECT_EQ(0u, dst[5]);
+  EXPECT_EQ(0u, dst[6]);
+  EXPECT_EQ(255u, dst[9]);
+  EXPECT_EQ(0u, dst[10]);
+}
+
+/////////////////////////////////////////////////
+TEST(ImageConversionsTest, ColorMap)
+{
+  EXPECT_EQ(nullptr, ColorMapLut(ColorMap::kGray));
+
+  // Viridis goes from dark purple to yellow
+  auto viridis = ColorMapLut(ColorMap::kViridis);
+  ASSERT_NE(nullptr, viridis);
+  EXPECT_NEAR(68, viridis[0], 3);
+  EXPECT_NEAR(1, viridis[1], 3);
+  EXPECT_NEAR(84, viridis[2], 3);
+  EXPECT_NEAR(253, viridis[255 * 3], 3);
+  EXPECT_NEAR(231, viridis[255 * 3 + 1], 3);
+  EXPECT_NEAR(37, viridis[255 * 3 + 2], 5);
+
+  // Turbo goes from blue to dark red
+  auto turbo = ColorMapLut(ColorMap::kTurbo);
+  ASSERT_NE(nullptr, turbo);
+  EXPECT_LT(turbo[25 * 3], turbo[25 * 3 + 2]);
+  EXPECT_GT(turbo[255 * 3], turbo[255 * 3 + 2]);
+
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> src{0.0f, 10.0f, 20.0f, nan};
+  std::vector<uint8_t> dst(src.size() * 3);
+  float farthest{0.0f};
+  DepthToRgb8(src.data(), src.size(), 0.0f, 10.0f, false, viridis,
+      dst.data(), &farthest);
+  EXPECT_FLOAT_EQ(20.0f, farthest);
+  for (unsigned int c = 0; c < 3; ++c)
+  {
+    EXPECT_EQ(viridis[c], dst[c]);
+    EXPECT_EQ(viridis[255 * 3 + c], dst[3 + c]);
+    EXPECT_EQ(viridis[255 * 3 + c], dst[6 + c]);
+    EXPECT_EQ(0u, dst[9 + c]);
+  }
+
+  // Inverted
+  DepthToRgb8(src.data(), src.size(), 0.0f, 10.0f, true, viridis,
+      dst.data());
+  for (unsigned int c = 0; c < 3; ++c)
+  {
+    EXPECT_EQ(viridis[255 * 3 + c], dst[c]);
+    EXPECT_EQ(viridis[c], dst[3 + c]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ImageConversionsTest, DepthPercentiles)
+{
+  // 100x100 ramp with a few outliers
+  const unsigned int size = 100;
+  std::vector<float> src(size * size);
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src[i] = static_cast<float>(i % size);
+  src[0] = 1e6f;
+  src[1] = std::numeric_limits<float>::infinity();
+
+  float min{0.0f};
+  float max{0.0f};
+  EXPECT_TRUE(DepthPercentiles(reinterpret_cast<const char *>(src.data()),
+      size, size, size * sizeof(float), 5.0f, 95.0f, min, max));
+  EXPECT_NEAR(5.0f, min, 3.0f);
+  EXPECT_NEAR(95.0f, max, 3.0f);
+
+  // Inverted percentiles are swapped
+  EXPECT_TRUE(DepthPercentiles(reinterpret_cast<const char *>(src.data()),
+      size, size, size * sizeof(float), 95.0f, 5.0f, min, max));
+  EXPECT_NEAR(5.0f, min, 3.0f);
+  EXPECT_NEAR(95.0f, max, 3.0f);
+
+  // Out of range percentiles are clamped
+  EXPECT_TRUE(DepthPercentiles(reinterpret_cast<const char *>(src.data()),
+      size, size, size * sizeof(float), -10.0f,
+      std::numeric_limits<float>::quiet_NaN(), min, max));
+  EXPECT_FLOAT_EQ(min, max);
+  EXPECT_NEAR(0.0f, min, 3.0f);
+
+  // No finite values
+  std::vector<float> nans(4, std::numeric_limits<float>::quiet_NaN());
+  EXPECT_FALSE(DepthPercentiles(reinterpret_cast<const char *>(nans.data()),
+      2, 2, 2 * sizeof(float), 5.0f, 95.0f, min, max));
+}
+
+/////////////////////////////////////////////////
+TEST(ImageConversionsTest, BayerToRgb8)
+{
+  // 3x3 RGGB image, the last row and column repeat the previous ones
+  std::vector<uint8_t> src{
+      10, 20, 0,
+      40, 30, 0,
+       0,  0, 0};
+  std::vector<uint8_t> dst(3 * 3 * 3);
+
+  BayerToRgb8(src.data(), 3, 3, 3, BayerPattern::kRggb, dst.data(), 9);
+  for (unsigned int i = 0; i < 9; ++i)
+  {
+    EXPECT_EQ(10u, dst[i * 3]) << i;
+    EXPECT_EQ(30u, dst[i * 3 + 1]) << i;
+    EXPECT_EQ(30u, dst[i * 3 + 2]) << i;
+  }
+
+  // 2x2 BGGR image
+  BayerToRgb8(src.data(), 2, 2, 3, BayerPattern::kBggr, dst.data(), 6);
+  EXPECT_EQ(30u, dst[0]);
+  EXPECT_EQ(30u, dst[1]);
+  EXPECT_EQ(10u, dst[2]);
+}
+
+/////////////////////////////////////////////////
+TEST(ImageConversionsTest, ConvertFrame)
+{
+  QImage image;
+
+  // Null frame
+  EXPECT_FALSE(ConvertFrame(nullptr, image));
+
+  // Not enough data
+  auto frame = std::make_shared<ImageFrame>();
+  frame->width = 4;
+  frame->height = 2;
+  frame->format = msgs::PixelFormatType::RGB_INT8;
+  frame->data = std::string(10, 0);
+  EXPECT_FALSE(ConvertFrame(frame, image));
+
+  // RGB is wrapped without copying
+  frame->data = std::string(4 * 2 * 3, 50);
+  EXPECT_TRUE(ConvertFrame(frame, image));
+  EXPECT_EQ(QImage::Format_RGB888, image.format());
+  EXPECT_EQ(4, image.width());
+  EXPECT_EQ(2, image.height());
+  EXPECT_EQ(reinterpret_cast<const uchar *>(frame->data.data()),
+      image.constBits());
+
+  // The image keeps the frame alive
+  std::weak_ptr<const ImageFrame> weakFrame = frame;
+  frame.reset();
+  EXPECT_FALSE(weakFrame.expired());
+  image = QImage();
+  EXPECT_TRUE(weakFrame.expired());
+
+  // 16 bit with padded rows is normalized into a grayscale image
+  frame = std::make_shared<ImageFrame>();
+  frame->width = 3;
+  frame->height = 2;
+  frame->step = 8;
+  frame->format = msgs::PixelFormatType::L_INT16;
+  std::vector<uint16_t> values{
+      0, 1000, 2000, 0xffff,
+      500, 1500, 1000, 0xffff};
+  frame->data = std::string(reinterpret_cast<const char *>(values.data()),
+      values.size() * sizeof(uint16_t));
+
+  EXPECT_TRUE(ConvertFrame(frame, image));
+  EXPECT_EQ(QImage::Format_Grayscale8, image.format());
+  EXPECT_EQ(0u, image.scanLine(0)[0]);
+  EXPECT_EQ(255u, image.scanLine(0)[2]);
+  EXPECT_NEAR(191, image.scanLine(1)[1], 1);
+
+  // Same size and format reuses the memory
+  auto bits = image.constBits();
+  EXPECT_TRUE(ConvertFrame(frame, image));
+  EXPECT_EQ(bits, image.constBits());
+
+  // Depth with a color map and fixed range
+  frame = std::make_shared<ImageFrame>();
+  frame->width = 2;
+  frame->height = 1;
+  frame->format = msgs::PixelFormatType::R_FLOAT32;
+  std::vector<float> depths{1.0f, 3.0f};
+  frame->data = std::string(reinterpret_cast<const char *>(depths.data()),
+      depths.size() * sizeof(float));
+
+  DepthOptions options;
+  options.rangeMode = DepthRangeMode::kFixed;
+  options.min = 1.0f;
+  options.max = 3.0f;
+  options.colorMap = ColorMap::kTurbo;
+  options.invert = false;
+  EXPECT_TRUE(ConvertFrame(frame, image, options));
+  EXPECT_EQ(QImage::Format_RGB888, image.format());
+  auto turbo = ColorMapLut(ColorMap::kTurbo);
+  for (unsigned int c = 0; c < 3; ++c)
+  {
+    EXPECT_EQ(turbo[c], image.constScanLine(0)[c]);
+    EXPECT_EQ(turbo[255 * 3 + c], image.constScanLine(0)[3 + c]);
+  }
+
+  // Default is grayscale, from 0 to the farthest point, inverted
+  EXPECT_TRUE(ConvertFrame(frame, image));
+  EXPECT_EQ(QImage::Format_Grayscale8, image.format());
+  EXPECT_NEAR(170, image.constScanLine(0)[0], 1);
+  EXPECT_EQ(0u, image.constScanLine(0)[1]);
+
+  // The farthest point is found even if it isn't sampled
+  frame = std::make_shared<ImageFrame>();
+  frame->width = 200;
+  frame->height = 1;
+  frame->format = msgs::PixelFormatType::R_FLOAT32;
+  depths.assign(frame->width, 10.0f);
+  depths[1] = 100.0f;
+  frame->data = std::string(reinterpret_cast<const char *>(depths.data()),
+      depths.size() * sizeof(float));
+  EXPECT_TRUE(ConvertFrame(frame, image));
+  EXPECT_NEAR(229, image.constScanLine(0)[0], 1);
+  EXPECT_EQ(0u, image.constScanLine(0)[1]);
+
+  // Unsupported
+  frame = std::make_shared<ImageFrame>();
+  frame->width = 1;
+  frame->height = 1;
+  frame->format = msgs::PixelFormatType::RGB_FLOAT32;
+  frame->data = std::string(12, 0);
+  EXPECT_FALSE(ConvertFrame(frame, image));
+}
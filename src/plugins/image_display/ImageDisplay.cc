@@ -20,18 +20,25 @@
 #include <QQuickImageProvider>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
-#include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <ignition/common/Console.hh>
-#include <ignition/common/Image.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/transport/Node.hh>
 
 #include "ignition/gui/Application.hh"
 
+#include "ImageConversions.hh"
+
 namespace ignition
 {
 namespace gui
@@ -48,9 +55,10 @@ namespace plugins
     public: QImage requestImage(const QString &, QSize *,
         const QSize &) override
     {
+      std::lock_guard<std::mutex> lock(this->mutex);
       if (!this->img.isNull())
       {
-        // Must return a copy
+        // Must return a copy, which is shallow and keeps the frame alive
         QImage copy(this->img);
         return copy;
       }
@@ -63,10 +71,14 @@ namespace plugins
 
     public: void SetImage(const QImage &_image)
     {
+      std::lock_guard<std::mutex> lock(this->mutex);
       this->img = _image;
     }
 
     private: QImage img;
+
+    /// \brief Protects the image, which is requested from the QML thread.
+    private: std::mutex mutex;
   };
 
   class ImageDisplayPrivate
@@ -74,15 +86,79 @@ namespace plugins
     /// \brief List of topics publishing image messages.
     public: QStringList topicList;
 
-    /// \brief Holds data to set as the next image
-    public: msgs::Image imageMsg;
+    /// \brief Convert frames from the mailbox until stopped. Runs on the
+    /// worker thread.
+    /// \param[in] _display Plugin which displays converted images.
+    public: void ConvertLoop(ImageDisplay *_display);
+
+    /// \brief Single-slot mailbox with the latest frame received. A new
+    /// frame replaces the previous one if it hasn't been converted yet.
+    public: ImageFramePtr mailbox;
+
+    /// \brief Latest converted image, waiting to be displayed.
+    public: QImage image;
+
+    /// \brief Images which conversions write into. They're alternated, so
+    /// one can be reused while the other is being displayed. Only accessed
+    /// by the worker thread.
+    public: QImage buffers[2];
+
+    /// \brief Index of the next buffer to write into.
+    public: unsigned int nextBuffer{0};
+
+    /// \brief True from the moment a frame is taken for conversion until
+    /// the resulting image has been displayed. No other frame is converted
+    /// meanwhile.
+    public: bool displayPending{false};
+
+    /// \brief Set to stop the worker thread.
+    public: bool stop{false};
+
+    /// \brief Options for depth images.
+    public: DepthOptions depthOptions;
+
+    /// \brief Protects the mailbox, image, flags and options.
+    public: std::mutex mutex;
+
+    /// \brief Wakes up the worker thread.
+    public: std::condition_variable cv;
+
+    /// \brief Thread which converts frames.
+    public: std::thread worker;
+
+    /// \brief Number of frames received.
+    public: std::atomic<uint64_t> receivedCount{0};
+
+    /// \brief Number of frames converted.
+    public: std::atomic<uint64_t> convertedCount{0};
+
+    /// \brief Number of frames dropped without being converted.
+    public: std::atomic<uint64_t> droppedCount{0};
+
+    /// \brief Counts at the last rate update, in the same order as above.
+    public: uint64_t lastCounts[3]{0, 0, 0};
+
+    /// \brief Time of the last rate update.
+    public: std::chrono::steady_clock::time_point lastRateTime;
+
+    /// \brief Frames received per second.
+    public: double receivedFps{0.0};
+
+    /// \brief Frames converted per second.
+    public: double convertedFps{0.0};
+
+    /// \brief Frames dropped per second.
+    public: double droppedFps{0.0};
+
+    /// \brief Timer to update rates.
+    public: QTimer *rateTimer{nullptr};
+
+    /// \brief Displayed topic, kept to resubscribe when activated.
+    public: std::string topic;
 
     /// \brief Node for communication.
     public: transport::Node node;
 
-    /// \brief Mutex for accessing image data
-    public: std::recursive_mutex imageMutex;
-
     /// \brief To provide images for QML.
     public: ImageProvider *provider{nullptr};
   };
@@ -98,11 +174,30 @@ using namespace plugins;
 ImageDisplay::ImageDisplay()
   : Plugin(), dataPtr(new ImageDisplayPrivate)
 {
+  this->dataPtr->worker = std::thread(&ImageDisplayPrivate::ConvertLoop,
+      this->dataPtr.get(), this);
+
+  this->dataPtr->lastRateTime = std::chrono::steady_clock::now();
+  this->dataPtr->rateTimer = new QTimer(this);
+  this->connect(this->dataPtr->rateTimer, &QTimer::timeout,
+      this, &ImageDisplay::UpdateRates);
 }
 
 /////////////////////////////////////////////////
 ImageDisplay::~ImageDisplay()
 {
+  // Stop receiving frames before stopping the worker
+  for (const auto &sub : this->dataPtr->node.SubscribedTopics())
+    this->dataPtr->node.Unsubscribe(sub);
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->cv.notify_all();
+  if (this->dataPtr->worker.joinable())
+    this->dataPtr->worker.join();
+
   App()->Engine()->removeImageProvider(
       this->CardItem()->objectName() + "imagedisplay");
 }
@@ -114,6 +209,9 @@ void ImageDisplay::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
   if (this->title.empty())
     this->title = "Image display";
 
+  // Only start once loaded, which lazy plugins defer until they're shown
+  this->dataPtr->rateTimer->start(1000);
+
   std::string topic;
   bool topicPicker = true;
 
@@ -125,6 +223,60 @@ void ImageDisplay::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
     if (auto pickerElem = _pluginElem->FirstChildElement("topic_picker"))
       pickerElem->QueryBoolText(&topicPicker);
+
+    // Depth images
+    DepthOptions options;
+    if (auto elem = _pluginElem->FirstChildElement("range_mode"))
+    {
+      std::string mode = elem->GetText() ? elem->GetText() : "";
+      if (mode == "auto")
+        options.rangeMode = DepthRangeMode::kAuto;
+      else if (mode == "fixed")
+        options.rangeMode = DepthRangeMode::kFixed;
+      else if (mode == "percentile")
+        options.rangeMode = DepthRangeMode::kPercentile;
+      else
+        ignwarn << "Unknown range mode [" << mode << "], using auto.\n";
+    }
+
+    if (auto elem = _pluginElem->FirstChildElement("min_range"))
+      elem->QueryFloatText(&options.min);
+
+    if (auto elem = _pluginElem->FirstChildElement("max_range"))
+      elem->QueryFloatText(&options.max);
+
+    if (auto elem = _pluginElem->FirstChildElement("low_percentile"))
+      elem->QueryFloatText(&options.lowPercentile);
+
+    if (auto elem = _pluginElem->FirstChildElement("high_percentile"))
+      elem->QueryFloatText(&options.highPercentile);
+
+    if (auto elem = _pluginElem->FirstChildElement("colormap"))
+    {
+      std::string colorMap = elem->GetText() ? elem->GetText() : "";
+      if (colorMap == "gray")
+        options.colorMap = ColorMap::kGray;
+      else if (colorMap == "turbo")
+        options.colorMap = ColorMap::kTurbo;
+      else if (colorMap == "viridis")
+        options.colorMap = ColorMap::kViridis;
+      else
+        ignwarn << "Unknown colormap [" << colorMap << "], using gray.\n";
+    }
+
+    if (auto elem = _pluginElem->FirstChildElement("invert"))
+      elem->QueryBoolText(&options.invert);
+
+    if (options.rangeMode == DepthRangeMode::kFixed &&
+        options.min >= options.max)
+    {
+      ignwarn << "Invalid fixed range [" << options.min << ", "
+              << options.max << "], using auto.\n";
+      options.rangeMode = DepthRangeMode::kAuto;
+    }
+
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->depthOptions = options;
   }
 
   if (topic.empty() && !topicPicker)
@@ -148,86 +300,135 @@ void ImageDisplay::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 /////////////////////////////////////////////////
 void ImageDisplay::ProcessImage()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
+  QImage image;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    image.swap(this->dataPtr->image);
+  }
 
-  unsigned int height = this->dataPtr->imageMsg.height();
-  unsigned int width = this->dataPtr->imageMsg.width();
-  QImage::Format qFormat = QImage::Format_RGB888;
+  if (!image.isNull() && nullptr != this->dataPtr->provider)
+  {
+    this->dataPtr->provider->SetImage(image);
+    this->newImage();
+  }
 
-  QImage image = QImage(width, height, qFormat);
+  // Let the worker convert the next frame
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->displayPending = false;
+  }
+  this->dataPtr->cv.notify_one();
+}
 
-  common::Image output;
-  switch (this->dataPtr->imageMsg.pixel_format_type())
+/////////////////////////////////////////////////
+void ImageDisplayPrivate::ConvertLoop(ImageDisplay *_display)
+{
+  while (true)
   {
-    case msgs::PixelFormatType::RGB_INT8:
-      // copy image data buffer directly to QImage
-      image = QImage(reinterpret_cast<const uchar *>(
-          this->dataPtr->imageMsg.data().c_str()), width, height, qFormat);
-      break;
-    // for other cases, convert to RGB common::Image
-    case msgs::PixelFormatType::R_FLOAT32:
-      // specify custom min max and also flip the pixel values
-      // i.e. darker pixels = higher values and brighter pixels = lower values
-      common::Image::ConvertToRGBImage<float>(
-          this->dataPtr->imageMsg.data().c_str(), width, height, output,
-          0.0f, std::numeric_limits<float>::lowest(), true);
-      break;
-    case msgs::PixelFormatType::L_INT16:
-      common::Image::ConvertToRGBImage<uint16_t>(
-          this->dataPtr->imageMsg.data().c_str(), width, height, output);
-       break;
-    case msgs::PixelFormatType::L_INT8:
-      common::Image::ConvertToRGBImage<uint8_t>(
-          this->dataPtr->imageMsg.data().c_str(), width, height, output);
-      break;
-    default:
+    ImageFramePtr frame;
+    DepthOptions options;
     {
-      ignwarn << "Unsupported image type: "
-              << this->dataPtr->imageMsg.pixel_format_type() << std::endl;
-      return;
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->cv.wait(lock, [this]
+      {
+        return this->stop || (this->mailbox && !this->displayPending);
+      });
+
+      if (this->stop)
+        return;
+
+      frame.swap(this->mailbox);
+      options = this->depthOptions;
+      this->displayPending = true;
     }
-  }
-  common::Image::PixelFormatType pixelFormat =
-      common::Image::ConvertPixelFormat(
-      msgs::ConvertPixelFormatType(
-      this->dataPtr->imageMsg.pixel_format_type()));
 
+    auto &buffer = this->buffers[this->nextBuffer];
+    this->nextBuffer = 1 - this->nextBuffer;
 
-  // if not rgb, copy values from common::Image to QImage
-  if (pixelFormat != common::Image::PixelFormatType::RGB_INT8)
-  {
-    unsigned int outputSize = 0;
-    unsigned char *data = nullptr;
-    output.Data(&data, outputSize);
+    bool converted = ConvertFrame(frame, buffer, options);
 
-    for (unsigned int j = 0; j < height; ++j)
     {
-      for (unsigned int i = 0; i < width; ++i)
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (!converted)
       {
-        unsigned int idx = j*width*3 + i * 3;
-        int r = data[idx];
-        int g = data[idx + 1];
-        int b = data[idx + 2];
-        QRgb value = qRgb(r, g, b);
-        image.setPixel(i, j, value);
+        this->displayPending = false;
+        continue;
       }
+      this->image = buffer;
     }
+    this->convertedCount++;
 
-    delete [] data;
+    // Display on the main thread
+    QMetaObject::invokeMethod(_display, "ProcessImage",
+        Qt::QueuedConnection);
   }
-
-  this->dataPtr->provider->SetImage(image);
-  this->newImage();
 }
 
 /////////////////////////////////////////////////
 void ImageDisplay::OnImageMsg(const msgs::Image &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
-  this->dataPtr->imageMsg = _msg;
+  // The message is owned by transport, so its data is copied once into a
+  // shared frame. From here on, the pixels are only referenced.
+  auto frame = std::make_shared<ImageFrame>();
+  frame->data = _msg.data();
+  frame->width = _msg.width();
+  frame->height = _msg.height();
+  frame->step = _msg.step();
+  frame->format = _msg.pixel_format_type();
+
+  this->dataPtr->receivedCount++;
+
+  // Replace the frame in the mailbox, dropping it if it wasn't converted
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->mailbox)
+      this->dataPtr->droppedCount++;
+    this->dataPtr->mailbox = std::move(frame);
+  }
+  this->dataPtr->cv.notify_one();
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::UpdateRates()
+{
+  auto now = std::chrono::steady_clock::now();
+  double dt = std::chrono::duration<double>(
+      now - this->dataPtr->lastRateTime).count();
+  if (dt <= 0.0)
+    return;
+
+  uint64_t counts[3] = {
+      this->dataPtr->receivedCount,
+      this->dataPtr->convertedCount,
+      this->dataPtr->droppedCount};
 
-  // Signal to main thread that the image changed
-  QMetaObject::invokeMethod(this, "ProcessImage");
+  this->dataPtr->receivedFps = (counts[0] - this->dataPtr->lastCounts[0]) / dt;
+  this->dataPtr->convertedFps =
+      (counts[1] - this->dataPtr->lastCounts[1]) / dt;
+  this->dataPtr->droppedFps = (counts[2] - this->dataPtr->lastCounts[2]) / dt;
+
+  std::copy(counts, counts + 3, this->dataPtr->lastCounts);
+  this->dataPtr->lastRateTime = now;
+
+  this->RatesChanged();
+}
+
+/////////////////////////////////////////////////
+double ImageDisplay::ReceivedFps() const
+{
+  return this->dataPtr->receivedFps;
+}
+
+/////////////////////////////////////////////////
+double ImageDisplay::ConvertedFps() const
+{
+  return this->dataPtr->convertedFps;
+}
+
+/////////////////////////////////////////////////
+double ImageDisplay::DroppedFps() const
+{
+  return this->dataPtr->droppedFps;
 }
 
 /////////////////////////////////////////////////
@@ -242,6 +443,12 @@ void ImageDisplay::OnTopic(const QString _topic)
   for (auto sub : subs)
     this->dataPtr->node.Unsubscribe(sub);
 
+  this->dataPtr->topic = topic;
+
+  // Subscribe once activated
+  if (!this->Active())
+    return;
+
   // Subscribe to new topic
   if (!this->dataPtr->node.Subscribe(topic, &ImageDisplay::OnImageMsg,
       this))
@@ -250,6 +457,28 @@ void ImageDisplay::OnTopic(const QString _topic)
   }
 }
 
+/////////////////////////////////////////////////
+void ImageDisplay::OnActivate()
+{
+  // Rates are measured from now on, not over the inactive period
+  this->dataPtr->lastCounts[0] = this->dataPtr->receivedCount;
+  this->dataPtr->lastCounts[1] = this->dataPtr->convertedCount;
+  this->dataPtr->lastCounts[2] = this->dataPtr->droppedCount;
+  this->dataPtr->lastRateTime = std::chrono::steady_clock::now();
+  this->dataPtr->rateTimer->start(1000);
+  if (!this->dataPtr->topic.empty())
+    this->OnTopic(QString::fromStdString(this->dataPtr->topic));
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::OnDeactivate()
+{
+  // No frames are received or converted while inactive
+  this->dataPtr->rateTimer->stop();
+  for (const auto &sub : this->dataPtr->node.SubscribedTopics())
+    this->dataPtr->node.Unsubscribe(sub);
+}
+
 /////////////////////////////////////////////////
 void ImageDisplay::OnRefresh()
 {
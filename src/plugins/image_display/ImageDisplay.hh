@@ -44,6 +44,28 @@ namespace plugins
   /// \<topic\> : Set the topic to receive image messages.
   /// \<topic_picker\> : Whether to show the topic picker, true by default. If
   ///                    this is false, a \<topic\> must be specified.
+  ///
+  /// The following apply to `R_FLOAT32` depth images:
+  ///
+  /// \<range_mode\> : How the displayed range is chosen, one of:
+  ///                  * `auto`: From 0 to the farthest point of each frame
+  ///                    (default).
+  ///                  * `fixed`: From \<min_range\> to \<max_range\>.
+  ///                  * `percentile`: From \<low_percentile\> to
+  ///                    \<high_percentile\> of a subsampled grid of each
+  ///                    frame.
+  /// \<min_range\> : Minimum of the fixed range, defaults to 0.
+  /// \<max_range\> : Maximum of the fixed range, defaults to 10.
+  /// \<low_percentile\> : Lower percentile, from 0 to 100, defaults to 2.
+  /// \<high_percentile\> : Upper percentile, from 0 to 100, defaults to 98.
+  ///                       Swapped with \<low_percentile\> if it's lower.
+  /// \<colormap\> : `gray` (default), `turbo` or `viridis`.
+  /// \<invert\> : True to map closer points to the end of the color map,
+  ///              i.e. closer is brighter in gray. Defaults to true.
+  ///
+  /// Frames are converted on a worker thread, which only keeps the latest
+  /// frame and only converts it once the previous image has been displayed.
+  /// Older frames are dropped.
   class ImageDisplay : public Plugin
   {
     Q_OBJECT
@@ -56,6 +78,27 @@ namespace plugins
       NOTIFY TopicListChanged
     )
 
+    /// \brief Frames received per second
+    Q_PROPERTY(
+      double receivedFps
+      READ ReceivedFps
+      NOTIFY RatesChanged
+    )
+
+    /// \brief Frames converted per second
+    Q_PROPERTY(
+      double convertedFps
+      READ ConvertedFps
+      NOTIFY RatesChanged
+    )
+
+    /// \brief Frames dropped per second, without being converted
+    Q_PROPERTY(
+      double droppedFps
+      READ DroppedFps
+      NOTIFY RatesChanged
+    )
+
     /// \brief Constructor
     public: ImageDisplay();
 
@@ -65,6 +108,12 @@ namespace plugins
     // Documentation inherited
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem);
 
+    // Documentation inherited
+    protected: void OnActivate() override;
+
+    // Documentation inherited
+    protected: void OnDeactivate() override;
+
     /// \brief Callback when refresh button is pressed.
     public slots: void OnRefresh();
 
@@ -84,12 +133,34 @@ namespace plugins
     /// \brief Notify that topic list has changed
     signals: void TopicListChanged();
 
+    /// \brief Get the number of frames received per second.
+    /// \return Received frame rate.
+    public: Q_INVOKABLE double ReceivedFps() const;
+
+    /// \brief Get the number of frames converted per second. Only the
+    /// latest frame is converted once the previous one has been displayed.
+    /// \return Converted frame rate.
+    public: Q_INVOKABLE double ConvertedFps() const;
+
+    /// \brief Get the number of frames dropped per second, because a newer
+    /// frame arrived before they could be converted.
+    /// \return Dropped frame rate.
+    public: Q_INVOKABLE double DroppedFps() const;
+
+    /// \brief Notify that the frame rates have been updated.
+    signals: void RatesChanged();
+
     /// \brief Notify that a new image has been received.
     signals: void newImage();
 
-    /// \brief Callback in main thread when image changes
+    /// \brief Callback in main thread when a converted image is ready to be
+    /// displayed
     private slots: void ProcessImage();
 
+    /// \brief Update the frame rates, called periodically on the main
+    /// thread.
+    private slots: void UpdateRates();
+
     /// \brief Subscriber callback when new image is received
     /// \param[in] _msg New image
     private: void OnImageMsg(const ignition::msgs::Image &_msg);
@@ -97,5 +97,22 @@ Rectangle {
         source = "image://" + uniqueName + "/" + Math.random().toString(36).substr(2, 5);
       }
     }
+    Label {
+      id: rates
+      Layout.fillWidth: true
+      font.pointSize: 8
+      text: "Received: " + ImageDisplay.receivedFps.toFixed(1) +
+            " fps | Converted: " + ImageDisplay.convertedFps.toFixed(1) +
+            " fps | Dropped: " + ImageDisplay.droppedFps.toFixed(1) + " fps"
+      ToolTip.visible: ratesMouseArea.containsMouse
+      ToolTip.delay: tooltipDelay
+      ToolTip.timeout: tooltipTimeout
+      ToolTip.text: qsTr("Frames are dropped when they arrive faster than they can be displayed")
+      MouseArea {
+        id: ratesMouseArea
+        anchors.fill: parent
+        hoverEnabled: true
+      }
+    }
   }
 }
@@ -22,7 +22,6 @@
 
 #include <ignition/gui/Application.hh>
 #include <ignition/gui/GuiEvents.hh>
-#include <ignition/gui/MainWindow.hh>
 
 #include <ignition/plugin/Register.hh>
 
@@ -43,6 +42,18 @@ class ignition::gui::plugins::InteractiveViewControlPrivate
   /// \brief Perform rendering calls in the rendering thread.
   public: void OnRender();
 
+  /// \brief Start a new drag when the mouse is pressed on the scene.
+  /// \param[in] _mouse Mouse event.
+  public: void OnPress(const common::MouseEvent &_mouse);
+
+  /// \brief Accumulate the distance dragged on the scene.
+  /// \param[in] _mouse Mouse event.
+  public: void OnDrag(const common::MouseEvent &_mouse);
+
+  /// \brief Accumulate the distance scrolled on the scene.
+  /// \param[in] _mouse Mouse event.
+  public: void OnScroll(const common::MouseEvent &_mouse);
+
   /// \brief Callback for camera view controller request
   /// \param[in] _msg Request message to set the camera view controller
   /// \param[in] _res Response data
@@ -100,6 +111,41 @@ using namespace ignition;
 using namespace gui;
 using namespace plugins;
 
+/////////////////////////////////////////////////
+void InteractiveViewControlPrivate::OnPress(const common::MouseEvent &_mouse)
+{
+  this->mouseDirty = true;
+
+  this->drag = math::Vector2d::Zero;
+  this->mouseEvent = _mouse;
+}
+
+/////////////////////////////////////////////////
+void InteractiveViewControlPrivate::OnDrag(const common::MouseEvent &_mouse)
+{
+  this->mouseDirty = true;
+
+  auto dragStart = this->mouseEvent.Pos();
+  auto dragInt = _mouse.Pos() - dragStart;
+  auto dragDistance = math::Vector2d(dragInt.X(), dragInt.Y());
+
+  this->drag += dragDistance;
+
+  this->mouseEvent = _mouse;
+}
+
+/////////////////////////////////////////////////
+void InteractiveViewControlPrivate::OnScroll(const common::MouseEvent &_mouse)
+{
+  this->mouseDirty = true;
+
+  this->drag += math::Vector2d(
+    _mouse.Scroll().X(),
+    _mouse.Scroll().Y());
+
+  this->mouseEvent = _mouse;
+}
+
 /////////////////////////////////////////////////
 void InteractiveViewControlPrivate::OnRender()
 {
@@ -265,70 +311,37 @@ void InteractiveViewControl::LoadConfig(
   ignmsg << "Camera view controller topic advertised on ["
          << this->dataPtr->cameraViewControlService << "]" << std::endl;
 
-  ignition::gui::App()->findChild<
-    ignition::gui::MainWindow *>()->installEventFilter(this);
-}
-
-/////////////////////////////////////////////////
-bool InteractiveViewControl::eventFilter(QObject *_obj, QEvent *_event)
-{
-  if (_event->type() == events::Render::kType)
-  {
-    this->dataPtr->OnRender();
-  }
-  else if (_event->type() == events::LeftClickOnScene::kType)
-  {
-    auto leftClickOnScene =
-      reinterpret_cast<ignition::gui::events::LeftClickOnScene *>(_event);
-    this->dataPtr->mouseDirty = true;
-
-    this->dataPtr->drag = math::Vector2d::Zero;
-    this->dataPtr->mouseEvent = leftClickOnScene->Mouse();
-  }
-  else if (_event->type() == events::MousePressOnScene::kType)
-  {
-    auto pressOnScene =
-      reinterpret_cast<ignition::gui::events::MousePressOnScene *>(_event);
-    this->dataPtr->mouseDirty = true;
-
-    this->dataPtr->drag = math::Vector2d::Zero;
-    this->dataPtr->mouseEvent = pressOnScene->Mouse();
-  }
-  else if (_event->type() == events::DragOnScene::kType)
-  {
-    auto dragOnScene =
-      reinterpret_cast<ignition::gui::events::DragOnScene *>(_event);
-    this->dataPtr->mouseDirty = true;
-
-    auto dragStart = this->dataPtr->mouseEvent.Pos();
-    auto dragInt = dragOnScene->Mouse().Pos() - dragStart;
-    auto dragDistance = math::Vector2d(dragInt.X(), dragInt.Y());
-
-    this->dataPtr->drag += dragDistance;
+  this->AddRenderHook(RenderPhase::kRender,
+      "InteractiveViewControl::OnRender",
+      [this]() {this->dataPtr->OnRender();});
 
-    this->dataPtr->mouseEvent = dragOnScene->Mouse();
-  }
-  else if (_event->type() == events::ScrollOnScene::kType)
-  {
-    auto scrollOnScene =
-      reinterpret_cast<ignition::gui::events::ScrollOnScene *>(_event);
-    this->dataPtr->mouseDirty = true;
-
-    this->dataPtr->drag += math::Vector2d(
-      scrollOnScene->Mouse().Scroll().X(),
-      scrollOnScene->Mouse().Scroll().Y());
-
-    this->dataPtr->mouseEvent = scrollOnScene->Mouse();
-  }
-  else if (_event->type() == ignition::gui::events::BlockOrbit::kType)
-  {
-    auto blockOrbit = reinterpret_cast<ignition::gui::events::BlockOrbit *>(
-      _event);
-    this->dataPtr->blockOrbit = blockOrbit->Block();
-  }
-
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+  // Scene events are published from the render thread, so they're delivered
+  // directly, in the same thread as OnRender
+  this->SubscribeEvent<events::LeftClickOnScene>(
+      [this](const events::LeftClickOnScene &_event)
+      {
+        this->dataPtr->OnPress(_event.Mouse());
+      });
+  this->SubscribeEvent<events::MousePressOnScene>(
+      [this](const events::MousePressOnScene &_event)
+      {
+        this->dataPtr->OnPress(_event.Mouse());
+      });
+  this->SubscribeEvent<events::DragOnScene>(
+      [this](const events::DragOnScene &_event)
+      {
+        this->dataPtr->OnDrag(_event.Mouse());
+      });
+  this->SubscribeEvent<events::ScrollOnScene>(
+      [this](const events::ScrollOnScene &_event)
+      {
+        this->dataPtr->OnScroll(_event.Mouse());
+      });
+  this->SubscribeEvent<events::BlockOrbit>(
+      [this](const events::BlockOrbit &_event)
+      {
+        this->dataPtr->blockOrbit = _event.Block();
+      });
 }
 
 // Register this plugin
@@ -63,9 +63,6 @@ namespace plugins
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         override;
 
-    // Documentation inherited
-    private: bool eventFilter(QObject *_obj, QEvent *_event) override;
-
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<InteractiveViewControlPrivate> dataPtr;
@@ -16,9 +16,13 @@
 */
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <list>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Profiler.hh>
@@ -49,6 +53,29 @@
 
 #include "MarkerManager.hh"
 
+/// \brief Points and colors unpacked from a packed marker buffer.
+struct PackedPoints
+{
+  /// \brief Interleaved XYZ coordinates, 3 floats per point.
+  std::vector<float> xyz;
+
+  /// \brief Interleaved RGBA colors, 4 floats per point. Empty if the buffer
+  /// didn't carry colors.
+  std::vector<float> rgba;
+};
+
+/// \brief Marker received through the packed topic. The metadata is kept in
+/// a point-less marker message so it can go through the same processing as
+/// regular markers.
+struct PackedMarker
+{
+  /// \brief Marker metadata, without points.
+  ignition::msgs::Marker marker;
+
+  /// \brief Marker points.
+  PackedPoints points;
+};
+
 /// \brief Private data class for MarkerManager
 class ignition::gui::plugins::MarkerManagerPrivate
 {
@@ -60,8 +87,11 @@ class ignition::gui::plugins::MarkerManagerPrivate
 
   /// \brief Processes a marker message.
   /// \param[in] _msg The message data.
+  /// \param[in] _points Optional packed points which override the message's
+  /// points.
   /// \return True if the marker was processed successfully.
-  public: bool ProcessMarkerMsg(const ignition::msgs::Marker &_msg);
+  public: bool ProcessMarkerMsg(const ignition::msgs::Marker &_msg,
+              const PackedPoints *_points = nullptr);
 
   /// \brief Services callback that returns a list of markers.
   /// \param[out] _rep Service reply
@@ -79,6 +109,18 @@ class ignition::gui::plugins::MarkerManagerPrivate
   public: bool OnMarkerMsgArray(const ignition::msgs::Marker_V &_req,
               ignition::msgs::Boolean &_res);
 
+  /// \brief Callback that receives packed marker buffers.
+  /// \param[in] _msg Packed buffer with float32 x, y, z and optional r, g, b,
+  /// a fields. Marker metadata is passed through the header.
+  public: void OnPackedMarkerMsg(const ignition::msgs::PointCloudPacked &_msg);
+
+  /// \brief Unpack a packed marker message.
+  /// \param[in] _msg Packed marker message.
+  /// \param[out] _packed Unpacked marker.
+  /// \return True if the message could be unpacked.
+  public: bool UnpackMarkerMsg(const ignition::msgs::PointCloudPacked &_msg,
+              PackedMarker &_packed) const;
+
   /// \brief Subscriber callback when new world statistics are received
   public: void OnWorldStatsMsg(const ignition::msgs::WorldStatistics &_msg);
 
@@ -91,8 +133,11 @@ class ignition::gui::plugins::MarkerManagerPrivate
   /// \brief Sets Marker from marker message.
   /// \param[in] _msg The message data.
   /// \param[out] _markerPtr The message pointer to set.
+  /// \param[in] _points Optional packed points which override the message's
+  /// points.
   public: void SetMarker(const ignition::msgs::Marker &_msg,
-                         const rendering::MarkerPtr &_markerPtr);
+                         const rendering::MarkerPtr &_markerPtr,
+                         const PackedPoints *_points = nullptr);
 
   /// \brief Converts an ignition msg material to ignition rendering
   //         material.
@@ -116,6 +161,15 @@ class ignition::gui::plugins::MarkerManagerPrivate
   /// \brief List of marker message to process.
   public: std::list<ignition::msgs::Marker> markerMsgs;
 
+  /// \brief List of packed markers to process. Only the latest update of
+  /// each marker is kept, so it's bounded by the number of markers rather
+  /// than by how far rendering falls behind.
+  public: std::list<PackedMarker> packedMarkers;
+
+  /// \brief Number of packed markers which were replaced by a newer update
+  /// of the same marker before being rendered.
+  public: uint64_t packedDroppedCount{0};
+
   /// \brief Map of visuals
   public: std::map<std::string,
       std::map<uint64_t, ignition::rendering::VisualPtr>> visuals;
@@ -138,6 +192,9 @@ class ignition::gui::plugins::MarkerManagerPrivate
   /// \brief True to print console warnings if the user tries to perform an
   /// action with an inexistent marker.
   public: bool warnOnActionFailure{true};
+
+  /// \brief Plugin which owns this, used to record handler statistics
+  public: Plugin *plugin{nullptr};
 };
 
 using namespace ignition;
@@ -189,6 +246,16 @@ void MarkerManagerPrivate::Initialize()
   }
 
   igndbg << "Advertise " << this->topicName << "_array.\n";
+
+  // Subscribe to packed markers
+  if (!this->node.Subscribe(this->topicName + "/packed",
+        &MarkerManagerPrivate::OnPackedMarkerMsg, this))
+  {
+    ignerr << "Unable to subscribe to the " << this->topicName
+           << "/packed topic.\n";
+  }
+
+  igndbg << "Subscribe to " << this->topicName << "/packed.\n";
 }
 
 /////////////////////////////////////////////////
@@ -204,6 +271,10 @@ void MarkerManagerPrivate::OnRender()
   }
 
   std::lock_guard<std::mutex> lock(this->mutex);
+  this->plugin->RecordQueueDepth("Marker messages", this->markerMsgs.size());
+  this->plugin->RecordQueueDepth("Packed markers",
+      this->packedMarkers.size());
+
   // Process the marker messages.
   for (auto markerIter = this->markerMsgs.begin();
        markerIter != this->markerMsgs.end();)
@@ -212,6 +283,13 @@ void MarkerManagerPrivate::OnRender()
     this->markerMsgs.erase(markerIter++);
   }
 
+  // Process the packed markers.
+  for (const auto &packed : this->packedMarkers)
+  {
+    this->ProcessMarkerMsg(packed.marker, &packed.points);
+  }
+  this->packedMarkers.clear();
+
   // Erase any markers that have a lifetime.
   for (auto mit = this->visuals.begin();
        mit != this->visuals.end();)
@@ -270,6 +348,7 @@ bool MarkerManagerPrivate::OnList(ignition::msgs::Marker_V &_rep)
 /////////////////////////////////////////////////
 void MarkerManagerPrivate::OnMarkerMsg(const ignition::msgs::Marker &_req)
 {
+  IGN_GUI_PROFILE_HANDLER(this->plugin, "MarkerManager::OnMarkerMsg");
   std::lock_guard<std::mutex> lock(this->mutex);
   this->markerMsgs.push_back(_req);
 }
@@ -278,6 +357,7 @@ void MarkerManagerPrivate::OnMarkerMsg(const ignition::msgs::Marker &_req)
 bool MarkerManagerPrivate::OnMarkerMsgArray(
     const ignition::msgs::Marker_V&_req, ignition::msgs::Boolean &_res)
 {
+  IGN_GUI_PROFILE_HANDLER(this->plugin, "MarkerManager::OnMarkerMsgArray");
   std::lock_guard<std::mutex> lock(this->mutex);
   std::copy(_req.marker().begin(), _req.marker().end(),
             std::back_inserter(this->markerMsgs));
@@ -285,8 +365,271 @@ bool MarkerManagerPrivate::OnMarkerMsgArray(
   return true;
 }
 
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::OnPackedMarkerMsg(
+    const ignition::msgs::PointCloudPacked &_msg)
+{
+  IGN_GUI_PROFILE_HANDLER(this->plugin, "MarkerManager::OnPackedMarkerMsg");
+
+  // Unpack outside of the lock, so the render thread isn't blocked by large
+  // buffers
+  PackedMarker packed;
+  if (!this->UnpackMarkerMsg(_msg, packed))
+    return;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // Each update carries the whole marker, so a pending update of the same
+  // marker can be replaced, unless it's deleted in between
+  if (packed.marker.action() == ignition::msgs::Marker::ADD_MODIFY)
+  {
+    const auto &ns = packed.marker.ns();
+    for (auto it = this->packedMarkers.rbegin();
+        it != this->packedMarkers.rend(); ++it)
+    {
+      const auto &pending = it->marker;
+      if (pending.action() == ignition::msgs::Marker::DELETE_ALL &&
+          (pending.ns().empty() || pending.ns() == ns))
+      {
+        break;
+      }
+
+      if (pending.ns() != ns || pending.id() != packed.marker.id())
+        continue;
+
+      if (pending.action() != ignition::msgs::Marker::ADD_MODIFY)
+        break;
+
+      *it = std::move(packed);
+      if (this->packedDroppedCount++ == 0)
+      {
+        ignwarn << "Packed markers are arriving faster than they're "
+                << "rendered, only the latest update of each marker will be "
+                << "rendered." << std::endl;
+      }
+      return;
+    }
+  }
+
+  this->packedMarkers.push_back(std::move(packed));
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::UnpackMarkerMsg(
+    const ignition::msgs::PointCloudPacked &_msg, PackedMarker &_packed) const
+{
+  auto &marker = _packed.marker;
+  marker.set_action(ignition::msgs::Marker::ADD_MODIFY);
+  marker.set_type(ignition::msgs::Marker::POINTS);
+
+  // Metadata
+  std::string shmKey;
+  double size{0.0};
+  try
+  {
+    for (const auto &data : _msg.header().data())
+    {
+      if (data.value().empty())
+        continue;
+
+      const auto &key = data.key();
+      const auto &value = data.value(0);
+      if (key == "ns")
+      {
+        marker.set_ns(value);
+      }
+      else if (key == "id")
+      {
+        marker.set_id(std::stoull(value));
+      }
+      else if (key == "action")
+      {
+        if (value == "delete_marker")
+          marker.set_action(ignition::msgs::Marker::DELETE_MARKER);
+        else if (value == "delete_all")
+          marker.set_action(ignition::msgs::Marker::DELETE_ALL);
+      }
+      else if (key == "type")
+      {
+        if (value == "line_list")
+          marker.set_type(ignition::msgs::Marker::LINE_LIST);
+        else if (value == "line_strip")
+          marker.set_type(ignition::msgs::Marker::LINE_STRIP);
+        else if (value == "triangle_fan")
+          marker.set_type(ignition::msgs::Marker::TRIANGLE_FAN);
+        else if (value == "triangle_list")
+          marker.set_type(ignition::msgs::Marker::TRIANGLE_LIST);
+        else if (value == "triangle_strip")
+          marker.set_type(ignition::msgs::Marker::TRIANGLE_STRIP);
+        else if (value != "points")
+        {
+          ignerr << "Unsupported packed marker type [" << value << "]"
+                 << std::endl;
+          return false;
+        }
+      }
+      else if (key == "size")
+      {
+        size = std::stod(value);
+      }
+      else if (key == "lifetime")
+      {
+        auto lifetime = std::chrono::duration_cast<
+            std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(std::stod(value)));
+        auto secNsec = math::durationToSecNsec(lifetime);
+        marker.mutable_lifetime()->set_sec(secNsec.first);
+        marker.mutable_lifetime()->set_nsec(secNsec.second);
+      }
+      else if (key == "shm_key")
+      {
+        shmKey = value;
+      }
+    }
+  }
+  catch(const std::exception &_e)
+  {
+    ignerr << "Failed to parse packed marker header: " << _e.what()
+           << std::endl;
+    return false;
+  }
+
+  // Size is only meaningful for points, other types would scale the visual
+  if (size > 0.0 && marker.type() == ignition::msgs::Marker::POINTS)
+    ignition::msgs::Set(marker.mutable_scale(), math::Vector3d::One * size);
+
+  // Nothing else to unpack for removals
+  if (marker.action() != ignition::msgs::Marker::ADD_MODIFY)
+    return true;
+
+  if (_msg.is_bigendian())
+  {
+    ignerr << "Big endian packed markers are not supported." << std::endl;
+    return false;
+  }
+
+  // Field offsets, -1 if not present
+  int offsets[7] = {-1, -1, -1, -1, -1, -1, -1};
+  static const char *kFieldNames[7] = {"x", "y", "z", "r", "g", "b", "a"};
+  for (const auto &field : _msg.field())
+  {
+    if (field.datatype() != ignition::msgs::PointCloudPacked::Field::FLOAT32)
+      continue;
+
+    for (int i = 0; i < 7; ++i)
+    {
+      if (field.name() == kFieldNames[i])
+        offsets[i] = static_cast<int>(field.offset());
+    }
+  }
+
+  if (offsets[0] < 0 || offsets[1] < 0 || offsets[2] < 0)
+  {
+    ignerr << "Packed marker is missing float32 x, y or z fields."
+           << std::endl;
+    return false;
+  }
+  bool hasColor = offsets[3] >= 0 && offsets[4] >= 0 && offsets[5] >= 0;
+
+  // Fields fit in the step, so it's at least the size of x, y and z
+  const size_t pointStep = _msg.point_step();
+  for (int i = 0; i < 7; ++i)
+  {
+    if (offsets[i] >= 0 &&
+        static_cast<size_t>(offsets[i]) + sizeof(float) > pointStep)
+    {
+      ignerr << "Packed marker field [" << kFieldNames[i]
+             << "] is outside of the point step." << std::endl;
+      return false;
+    }
+  }
+
+  // Sizes come from the network, so they're checked without multiplying
+  // them, which could wrap around
+  const size_t width = _msg.width();
+  const size_t height = std::max(_msg.height(), 1u);
+  if (width > std::numeric_limits<size_t>::max() / height)
+  {
+    ignerr << "Packed marker has too many points [" << width << "x"
+           << height << "]." << std::endl;
+    return false;
+  }
+  const size_t pointCount = width * height;
+
+  // Checks that the buffer holds all points before anything is allocated
+  auto checkSize = [&](size_t _bytes, const std::string &_source)
+  {
+    if (pointCount <= _bytes / pointStep)
+      return true;
+
+    ignerr << _source << " has [" << _bytes << "] bytes, expected ["
+           << pointCount << "] points of [" << pointStep << "] bytes."
+           << std::endl;
+    return false;
+  };
+
+  auto unpack = [&](const char *_data)
+  {
+    _packed.points.xyz.resize(pointCount * 3);
+    if (hasColor)
+      _packed.points.rgba.resize(pointCount * 4);
+
+    for (size_t p = 0; p < pointCount; ++p)
+    {
+      const char *point = _data + p * pointStep;
+      for (int i = 0; i < 3; ++i)
+      {
+        std::memcpy(&_packed.points.xyz[p * 3 + i], point + offsets[i],
+            sizeof(float));
+      }
+
+      if (!hasColor)
+        continue;
+
+      for (int i = 0; i < 4; ++i)
+      {
+        float &c = _packed.points.rgba[p * 4 + i];
+        if (offsets[3 + i] >= 0)
+          std::memcpy(&c, point + offsets[3 + i], sizeof(float));
+        else
+          c = 1.0f;
+      }
+    }
+  };
+
+  // Points on shared memory, publisher is on the same host
+  if (!shmKey.empty())
+  {
+    QSharedMemory shm(QString::fromStdString(shmKey));
+    if (!shm.attach(QSharedMemory::ReadOnly))
+    {
+      ignerr << "Failed to attach to shared memory [" << shmKey << "]: "
+             << shm.errorString().toStdString() << std::endl;
+      return false;
+    }
+
+    if (!checkSize(static_cast<size_t>(std::max(shm.size(), 0)),
+        "Shared memory [" + shmKey + "]"))
+    {
+      return false;
+    }
+
+    shm.lock();
+    unpack(static_cast<const char *>(shm.constData()));
+    shm.unlock();
+    return true;
+  }
+
+  if (!checkSize(_msg.data().size(), "Packed marker data"))
+    return false;
+
+  unpack(_msg.data().data());
+  return true;
+}
+
 //////////////////////////////////////////////////
-bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
+bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg,
+    const PackedPoints *_points)
 {
   // Get the namespace, if it exists. Otherwise, use the global namespace
   std::string ns;
@@ -343,7 +686,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
         this->SetVisual(_msg, visualIter->second);
 
         // Set the marker values from the Marker Message
-        this->SetMarker(_msg, markerPtr);
+        this->SetMarker(_msg, markerPtr, _points);
 
         visualIter->second->AddGeometry(markerPtr);
       }
@@ -365,7 +708,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
       this->SetVisual(_msg, visualPtr);
 
       // Set the marker values from the Marker Message
-      this->SetMarker(_msg, markerPtr);
+      this->SetMarker(_msg, markerPtr, _points);
 
       // Add populated marker to the visual
       visualPtr->AddGeometry(markerPtr);
@@ -502,7 +845,8 @@ void MarkerManagerPrivate::SetVisual(const ignition::msgs::Marker &_msg,
 
 /////////////////////////////////////////////////
 void MarkerManagerPrivate::SetMarker(const ignition::msgs::Marker &_msg,
-                           const rendering::MarkerPtr &_markerPtr)
+                           const rendering::MarkerPtr &_markerPtr,
+                           const PackedPoints *_points)
 {
   _markerPtr->SetLayer(_msg.layer());
 
@@ -534,7 +878,7 @@ void MarkerManagerPrivate::SetMarker(const ignition::msgs::Marker &_msg,
   }
 
   // Assume the presence of points means we clear old ones
-  if (_msg.point().size() > 0)
+  if (_msg.point().size() > 0 || nullptr != _points)
   {
     _markerPtr->ClearPoints();
   }
@@ -545,6 +889,26 @@ void MarkerManagerPrivate::SetMarker(const ignition::msgs::Marker &_msg,
       _msg.material().diffuse().b(),
       _msg.material().diffuse().a());
 
+  // Set packed points, with per-point colors if available
+  if (nullptr != _points)
+  {
+    if (!_msg.has_material())
+      color = math::Color::White;
+
+    const bool hasColor = !_points->rgba.empty();
+    const size_t count = _points->xyz.size() / 3;
+    for (size_t i = 0; i < count; ++i)
+    {
+      const float *p = &_points->xyz[i * 3];
+      if (hasColor)
+      {
+        const float *c = &_points->rgba[i * 4];
+        color.Set(c[0], c[1], c[2], c[3]);
+      }
+      _markerPtr->AddPoint(math::Vector3d(p[0], p[1], p[2]), color);
+    }
+  }
+
   // Set Marker Points
   for (int i = 0; i < _msg.point().size(); ++i)
   {
@@ -641,6 +1005,7 @@ ignition::rendering::MarkerType MarkerManagerPrivate::MsgToType(
 void MarkerManagerPrivate::OnWorldStatsMsg(
   const ignition::msgs::WorldStatistics &_msg)
 {
+  IGN_GUI_PROFILE_HANDLER(this->plugin, "MarkerManager::OnWorldStatsMsg");
   std::lock_guard<std::mutex> lock(this->mutex);
   std::chrono::steady_clock::duration timePoint;
   if (_msg.has_sim_time())
@@ -663,11 +1028,19 @@ void MarkerManagerPrivate::OnWorldStatsMsg(
 MarkerManager::MarkerManager()
   : Plugin(), dataPtr(new MarkerManagerPrivate)
 {
+  this->dataPtr->plugin = this;
 }
 
 /////////////////////////////////////////////////
 MarkerManager::~MarkerManager()
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->packedDroppedCount > 0)
+  {
+    igndbg << "Dropped [" << this->dataPtr->packedDroppedCount
+           << "] packed marker updates which were replaced before being "
+           << "rendered." << std::endl;
+  }
 }
 
 /////////////////////////////////////////////////
@@ -758,18 +1131,8 @@ void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
     }
   }
 
-  App()->findChild<MainWindow *>()->installEventFilter(this);
-}
-
-/////////////////////////////////////////////////
-bool MarkerManager::eventFilter(QObject *_obj, QEvent *_event)
-{
-  if (_event->type() == events::Render::kType)
-  {
-    this->dataPtr->OnRender();
-  }
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+  this->AddRenderHook(RenderPhase::kRender, "MarkerManager::OnRender",
+      [this]() {this->dataPtr->OnRender();});
 }
 
 // Register this plugin
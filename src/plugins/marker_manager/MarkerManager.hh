@@ -33,6 +33,27 @@ namespace plugins
   /// \brief This plugin will be in charge of handeling the markers in the
   /// scene. It will allow to add, modify or remove markers.
   ///
+  /// Besides the `ignition.msgs.Marker` services, large point sets can be
+  /// published as `ignition.msgs.PointCloudPacked` on `<topic_name>/packed`.
+  /// Each point must have float32 `x`, `y` and `z` fields, and may have
+  /// float32 `r`, `g`, `b` and `a` fields for per-point colors. Marker
+  /// metadata is passed as header key-value pairs:
+  ///
+  /// * `ns`: Namespace.
+  /// * `id`: Marker ID within the namespace.
+  /// * `action`: `add_modify` (default), `delete_marker` or `delete_all`.
+  /// * `type`: `points` (default), `line_list`, `line_strip`,
+  ///   `triangle_fan`, `triangle_list` or `triangle_strip`.
+  /// * `size`: Point size, only used by `points`.
+  /// * `lifetime`: Lifetime in seconds, 0 for infinite.
+  /// * `shm_key`: Key of a `QSharedMemory` segment holding the point buffer,
+  ///   used instead of the message's `data` when the publisher is on the same
+  ///   host. The publisher owns the segment and must keep it alive until the
+  ///   message is processed.
+  ///
+  /// If packed updates of a marker arrive faster than they're rendered, only
+  /// the latest one is rendered.
+  ///
   /// ## Parameters
   ///
   /// * `<topic_name>`: Options. Name of topic for marker service. Defaults
@@ -53,9 +74,6 @@ namespace plugins
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         override;
 
-    // Documentation inherited
-    private: bool eventFilter(QObject *_obj, QEvent *_event) override;
-
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<MarkerManagerPrivate> dataPtr;
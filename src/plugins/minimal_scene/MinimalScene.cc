@@ -51,6 +51,7 @@
 #include "ignition/gui/GuiEvents.hh"
 #include "ignition/gui/Helpers.hh"
 #include "ignition/gui/MainWindow.hh"
+#include "ignition/gui/RenderHooks.hh"
 
 Q_DECLARE_METATYPE(ignition::gui::plugins::RenderSync*)
 
@@ -92,6 +93,10 @@ class ignition::gui::plugins::IgnRenderer::Implementation
 
   /// \brief View control focus target
   public: math::Vector3d target;
+
+  /// \brief Main window, which receives scene events. It's looked up once
+  /// instead of on every event.
+  public: MainWindow *mainWindow{nullptr};
 };
 
 /// \brief Qt and Ogre rendering is happening in different threads
@@ -305,21 +310,22 @@ void IgnRenderer::Render(RenderSync *_renderSync)
   // view control
   this->HandleMouseEvent();
 
-  if (ignition::gui::App())
+  // Plugins which registered hooks, then plugins which filter events
+  runRenderHooks(RenderPhase::kPreRender);
+  if (nullptr != this->dataPtr->mainWindow)
   {
-    ignition::gui::App()->sendEvent(
-        ignition::gui::App()->findChild<ignition::gui::MainWindow *>(),
-        new gui::events::PreRender());
+    gui::events::PreRender event;
+    App()->sendEvent(this->dataPtr->mainWindow, &event);
   }
 
   // update and render to texture
   this->dataPtr->camera->Update();
 
-  if (ignition::gui::App())
+  runRenderHooks(RenderPhase::kRender);
+  if (nullptr != this->dataPtr->mainWindow)
   {
-    ignition::gui::App()->sendEvent(
-        ignition::gui::App()->findChild<ignition::gui::MainWindow *>(),
-        new gui::events::Render());
+    gui::events::Render event;
+    App()->sendEvent(this->dataPtr->mainWindow, &event);
   }
   _renderSync->ReleaseQtThreadFromBlock(lock);
 }
@@ -371,7 +377,7 @@ void IgnRenderer::BroadcastDrop()
     return;
   events::DropOnScene dropOnSceneEvent(
     this->dataPtr->dropText, this->dataPtr->mouseDropPos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &dropOnSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &dropOnSceneEvent);
   this->dataPtr->dropDirty = false;
 }
 
@@ -384,14 +390,14 @@ void IgnRenderer::BroadcastHoverPos()
   auto pos = this->ScreenToScene(this->dataPtr->mouseHoverPos);
 
   events::HoverToScene hoverToSceneEvent(pos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &hoverToSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &hoverToSceneEvent);
 
   common::MouseEvent hoverMouseEvent = this->dataPtr->mouseEvent;
   hoverMouseEvent.SetPos(this->dataPtr->mouseHoverPos);
   hoverMouseEvent.SetDragging(false);
   hoverMouseEvent.SetType(common::MouseEvent::MOVE);
   events::HoverOnScene hoverOnSceneEvent(hoverMouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &hoverOnSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &hoverOnSceneEvent);
 
   this->dataPtr->hoverDirty = false;
 }
@@ -407,7 +413,7 @@ void IgnRenderer::BroadcastDrag()
     return;
 
   events::DragOnScene dragEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &dragEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &dragEvent);
 
   this->dataPtr->mouseDirty = false;
 }
@@ -425,10 +431,10 @@ void IgnRenderer::BroadcastLeftClick()
   auto pos = this->ScreenToScene(this->dataPtr->mouseEvent.Pos());
 
   events::LeftClickToScene leftClickToSceneEvent(pos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &leftClickToSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &leftClickToSceneEvent);
 
   events::LeftClickOnScene leftClickOnSceneEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &leftClickOnSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &leftClickOnSceneEvent);
 
   this->dataPtr->mouseDirty = false;
 }
@@ -446,10 +452,10 @@ void IgnRenderer::BroadcastRightClick()
   auto pos = this->ScreenToScene(this->dataPtr->mouseEvent.Pos());
 
   events::RightClickToScene rightClickToSceneEvent(pos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &rightClickToSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &rightClickToSceneEvent);
 
   events::RightClickOnScene rightClickOnSceneEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &rightClickOnSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &rightClickOnSceneEvent);
 
   this->dataPtr->mouseDirty = false;
 }
@@ -464,7 +470,7 @@ void IgnRenderer::BroadcastMousePress()
     return;
 
   events::MousePressOnScene event(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &event);
+  App()->sendEvent(this->dataPtr->mainWindow, &event);
 
   this->dataPtr->mouseDirty = false;
 }
@@ -479,7 +485,7 @@ void IgnRenderer::BroadcastScroll()
     return;
 
   events::ScrollOnScene scrollOnSceneEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &scrollOnSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &scrollOnSceneEvent);
 
   this->dataPtr->mouseDirty = false;
 }
@@ -491,7 +497,7 @@ void IgnRenderer::BroadcastKeyRelease()
     return;
 
   events::KeyReleaseOnScene keyRelease(this->dataPtr->keyEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &keyRelease);
+  App()->sendEvent(this->dataPtr->mainWindow, &keyRelease);
 
   this->dataPtr->keyEvent.SetType(common::KeyEvent::NO_EVENT);
 }
@@ -503,7 +509,7 @@ void IgnRenderer::BroadcastKeyPress()
     return;
 
   events::KeyPressOnScene keyPress(this->dataPtr->keyEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &keyPress);
+  App()->sendEvent(this->dataPtr->mainWindow, &keyPress);
 
   this->dataPtr->keyEvent.SetType(common::KeyEvent::NO_EVENT);
 }
@@ -514,11 +520,13 @@ void IgnRenderer::Initialize()
   if (this->initialized)
     return;
 
+  this->dataPtr->mainWindow =
+      ignition::gui::App()->findChild<ignition::gui::MainWindow *>();
+
   std::map<std::string, std::string> params;
   params["useCurrentGLContext"] = "1";
   params["winID"] = std::to_string(
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->
-      QuickWindow()->winId());
+    this->dataPtr->mainWindow->QuickWindow()->winId());
   auto engine = rendering::engine(this->engineName, params);
   if (!engine)
   {
@@ -32,6 +32,18 @@ void TransportPlotting::LoadConfig(const tinyxml2::XMLElement *)
     this->title = "Transport plotting";
 }
 
+//////////////////////////////////////////
+void TransportPlotting::OnActivate()
+{
+  this->dataPtr->SetPaused(false);
+}
+
+//////////////////////////////////////////
+void TransportPlotting::OnDeactivate()
+{
+  this->dataPtr->SetPaused(true);
+}
+
 //////////////////////////////////////////
 TransportPlotting::TransportPlotting() : Plugin(),
     dataPtr(new PlottingInterface)
@@ -45,6 +45,12 @@ class TransportPlotting : public ignition::gui::Plugin
   // Documentation inherited
   public: void LoadConfig(const tinyxml2::XMLElement *) override;
 
+  // Documentation inherited
+  protected: void OnActivate() override;
+
+  // Documentation inherited
+  protected: void OnDeactivate() override;
+
   /// \brief Interface with the UI to Handle Transport Plotting
   IGN_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
   private: std::unique_ptr<PlottingInterface> dataPtr;
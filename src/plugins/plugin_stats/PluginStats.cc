@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/plugin/Register.hh>
+
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/Instrumentation.hh"
+#include "ignition/gui/MainWindow.hh"
+
+#include "PluginStats.hh"
+
+#define PLUGIN_ROLE 51
+#define NAME_ROLE 52
+#define DETAILS_ROLE 53
+#define QUEUE_ROLE 54
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Model with one row per handler and queue
+  class PluginStatsModel : public QStandardItemModel
+  {
+    /// \brief roles and names of the model
+    public: QHash<int, QByteArray> roleNames() const override
+    {
+      QHash<int, QByteArray> roles;
+      roles[PLUGIN_ROLE] = "plugin";
+      roles[NAME_ROLE] = "name";
+      roles[DETAILS_ROLE] = "details";
+      roles[QUEUE_ROLE] = "queue";
+      return roles;
+    }
+  };
+
+  class PluginStatsPrivate
+  {
+    /// \brief Model with all handlers and queues
+    public: PluginStatsModel *model{nullptr};
+
+    /// \brief Handler statistics at the last update, by plugin and handler
+    /// name, used to compute the values over the last interval
+    public: std::map<std::pair<const Plugin *, std::string>, HandlerStats>
+        lastStats;
+
+    /// \brief Time of the last update
+    public: std::chrono::steady_clock::time_point lastUpdate;
+
+    /// \brief Timer to update the statistics
+    public: QTimer *timer{nullptr};
+  };
+}
+}
+}
+
+using namespace ignition;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+PluginStats::PluginStats()
+  : Plugin(), dataPtr(new PluginStatsPrivate)
+{
+  acquireInstrumentation();
+
+  this->dataPtr->model = new PluginStatsModel();
+  this->dataPtr->model->setParent(this);
+
+  App()->Engine()->rootContext()->setContextProperty("PluginStatsModel",
+      this->dataPtr->model);
+
+  this->dataPtr->lastUpdate = std::chrono::steady_clock::now();
+  this->dataPtr->timer = new QTimer(this);
+  this->connect(this->dataPtr->timer, &QTimer::timeout,
+      this, &PluginStats::Update);
+}
+
+/////////////////////////////////////////////////
+PluginStats::~PluginStats()
+{
+  releaseInstrumentation();
+}
+
+/////////////////////////////////////////////////
+void PluginStats::LoadConfig(const tinyxml2::XMLElement *)
+{
+  if (this->title.empty())
+    this->title = "Plugin stats";
+
+  // Only start once loaded, which lazy plugins defer until they're shown
+  this->dataPtr->timer->start(1000);
+}
+
+/////////////////////////////////////////////////
+void PluginStats::OnActivate()
+{
+  this->dataPtr->timer->start(1000);
+}
+
+/////////////////////////////////////////////////
+void PluginStats::OnDeactivate()
+{
+  // Statistics keep being collected, they're only displayed while active
+  this->dataPtr->timer->stop();
+}
+
+/////////////////////////////////////////////////
+QStandardItemModel *PluginStats::Model()
+{
+  return this->dataPtr->model;
+}
+
+/////////////////////////////////////////////////
+void PluginStats::Update()
+{
+  auto win = App()->findChild<MainWindow *>();
+  if (!win)
+    return;
+
+  auto now = std::chrono::steady_clock::now();
+  double interval = std::chrono::duration<double>(
+      now - this->dataPtr->lastUpdate).count();
+  this->dataPtr->lastUpdate = now;
+
+  /// \brief A row to display
+  struct Row
+  {
+    /// \brief Plugin title
+    std::string plugin;
+
+    /// \brief Handler or queue name
+    std::string name;
+
+    /// \brief Formatted statistics
+    std::string details;
+
+    /// \brief Share of the interval spent in the handler, used for sorting
+    double busy{0.0};
+  };
+  std::vector<Row> handlers;
+  std::vector<Row> queues;
+
+  std::map<std::pair<const Plugin *, std::string>, HandlerStats> stats;
+  for (auto plugin : win->findChildren<Plugin *>())
+  {
+    for (const auto &handler : plugin->HandlerStatistics())
+    {
+      auto key = std::make_pair(plugin, handler.name);
+
+      // Only consider what happened since the last update
+      auto delta = handler;
+      auto last = this->dataPtr->lastStats.find(key);
+      if (last != this->dataPtr->lastStats.end())
+      {
+        delta.count -= std::min(delta.count, last->second.count);
+        delta.total -= std::min(delta.total, last->second.total);
+      }
+      stats[key] = handler;
+
+      double totalMs = std::chrono::duration<double, std::milli>(
+          delta.total).count();
+      double meanMs = delta.count > 0 ? totalMs / delta.count : 0.0;
+      double maxMs = std::chrono::duration<double, std::milli>(
+          handler.max).count();
+
+      Row row;
+      row.plugin = plugin->Title();
+      row.name = handler.name;
+      row.busy = interval > 0.0 ? totalMs / (interval * 1000.0) : 0.0;
+
+      std::ostringstream details;
+      details << std::fixed << std::setprecision(1)
+              << (interval > 0.0 ? delta.count / interval : 0.0) << " Hz, "
+              << std::setprecision(3) << meanMs << " ms mean, "
+              << maxMs << " ms max, "
+              << std::setprecision(1) << row.busy * 100.0 << "% busy";
+      row.details = details.str();
+      handlers.push_back(row);
+    }
+
+    for (const auto &queue : plugin->QueueStatistics())
+    {
+      Row row;
+      row.plugin = plugin->Title();
+      row.name = queue.name;
+      row.details = std::to_string(queue.depth) + " pending, " +
+          std::to_string(queue.maxDepth) + " max";
+      queues.push_back(row);
+    }
+  }
+  this->dataPtr->lastStats = std::move(stats);
+
+  // Busiest handlers first
+  std::stable_sort(handlers.begin(), handlers.end(),
+      [](const Row &_a, const Row &_b) {return _a.busy > _b.busy;});
+
+  this->dataPtr->model->clear();
+  auto root = this->dataPtr->model->invisibleRootItem();
+  auto addRows = [&](const std::vector<Row> &_rows, bool _queue)
+  {
+    for (const auto &row : _rows)
+    {
+      auto item = new QStandardItem(QString::fromStdString(row.name));
+      item->setData(QString::fromStdString(row.plugin), PLUGIN_ROLE);
+      item->setData(QString::fromStdString(row.name), NAME_ROLE);
+      item->setData(QString::fromStdString(row.details), DETAILS_ROLE);
+      item->setData(_queue, QUEUE_ROLE);
+      root->appendRow(item);
+    }
+  };
+  addRows(handlers, false);
+  addRows(queues, true);
+}
+
+// Register this plugin
+IGNITION_ADD_PLUGIN(ignition::gui::plugins::PluginStats,
+                    ignition::gui::Plugin)
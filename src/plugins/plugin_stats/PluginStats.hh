@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_PLUGINS_PLUGINSTATS_HH_
+#define IGNITION_GUI_PLUGINS_PLUGINSTATS_HH_
+
+#include <memory>
+
+#include "ignition/gui/Plugin.hh"
+
+#ifndef _WIN32
+#  define PluginStats_EXPORTS_API
+#else
+#  if (defined(PluginStats_EXPORTS))
+#    define PluginStats_EXPORTS_API __declspec(dllexport)
+#  else
+#    define PluginStats_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  class PluginStatsPrivate;
+
+  /// \brief Overlay which shows how long the handlers of all loaded plugins
+  /// take and how much work is pending in their queues, as recorded through
+  /// Plugin::RecordHandler and Plugin::RecordQueueDepth.
+  ///
+  /// Plugin instrumentation is enabled while this plugin is loaded. Every
+  /// second, handlers are listed by the share of the last second spent in
+  /// them, with their call rate and mean and maximum durations, followed by
+  /// queue depths.
+  ///
+  /// ## Configuration
+  ///
+  /// This plugin doesn't accept any custom configuration.
+  class PluginStats_EXPORTS_API PluginStats : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Constructor
+    public: PluginStats();
+
+    /// \brief Destructor
+    public: ~PluginStats() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
+
+    // Documentation inherited
+    protected: void OnActivate() override;
+
+    // Documentation inherited
+    protected: void OnDeactivate() override;
+
+    /// \brief Get the model with one row per handler and queue.
+    /// \return Pointer to the model.
+    public: QStandardItemModel *Model();
+
+    /// \brief Update the statistics of all plugins.
+    public slots: void Update();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<PluginStatsPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
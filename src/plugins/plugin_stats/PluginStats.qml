@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.2
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: pluginStats
+  objectName: "pluginStats"
+  Layout.minimumWidth: 350
+  Layout.minimumHeight: 250
+  color: "transparent"
+
+  ListView {
+    id: listView
+    anchors.fill: parent
+    anchors.margins: 10
+    clip: true
+    model: PluginStatsModel
+
+    section.property: "queue"
+    section.delegate: Label {
+      text: section === "true" ? "Queues" : "Handlers"
+      font.bold: true
+      topPadding: 5
+    }
+
+    delegate: Column {
+      width: listView.width
+
+      Label {
+        text: model.plugin + ": " + model.name
+        elide: Text.ElideRight
+        width: parent.width
+      }
+
+      Label {
+        text: model.details
+        font.pointSize: 8
+        x: 10
+      }
+    }
+
+    ScrollIndicator.vertical: ScrollIndicator {
+      active: true
+    }
+  }
+
+  Label {
+    anchors.centerIn: parent
+    visible: listView.count === 0
+    text: "No instrumented plugins"
+  }
+}
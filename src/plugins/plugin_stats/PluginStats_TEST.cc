@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include <ignition/common/Console.hh>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/Instrumentation.hh"
+#include "ignition/gui/Plugin.hh"
+#include "ignition/gui/MainWindow.hh"
+
+#include "PluginStats.hh"
+
+#define PLUGIN_ROLE 51
+#define NAME_ROLE 52
+#define DETAILS_ROLE 53
+#define QUEUE_ROLE 54
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./PluginStats_TEST")),
+};
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(PluginStatsTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Load))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  EXPECT_FALSE(instrumentationEnabled());
+  EXPECT_TRUE(app.LoadPlugin("PluginStats"));
+
+  // Loading the plugin enables instrumentation
+  EXPECT_TRUE(instrumentationEnabled());
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Get plugin
+  auto plugins = win->findChildren<plugins::PluginStats *>();
+  ASSERT_EQ(plugins.size(), 1);
+
+  auto plugin = plugins[0];
+  EXPECT_EQ(plugin->Title(), "Plugin stats");
+
+  // Nothing recorded yet
+  plugin->Update();
+  auto model = plugin->Model();
+  ASSERT_NE(nullptr, model);
+  EXPECT_EQ(0, model->rowCount());
+
+  // Record statistics on a plugin
+  plugin->RecordHandler("fast", std::chrono::microseconds(10));
+  plugin->RecordHandler("slow", std::chrono::milliseconds(10));
+  plugin->RecordQueueDepth("queue", 5);
+  plugin->Update();
+
+  // Busiest handlers first, then queues
+  ASSERT_EQ(3, model->rowCount());
+
+  auto item = model->item(0);
+  EXPECT_EQ("Plugin stats", item->data(PLUGIN_ROLE).toString());
+  EXPECT_EQ("slow", item->data(NAME_ROLE).toString());
+  EXPECT_FALSE(item->data(QUEUE_ROLE).toBool());
+
+  item = model->item(1);
+  EXPECT_EQ("fast", item->data(NAME_ROLE).toString());
+
+  item = model->item(2);
+  EXPECT_EQ("queue", item->data(NAME_ROLE).toString());
+  EXPECT_TRUE(item->data(QUEUE_ROLE).toBool());
+  EXPECT_EQ("5 pending, 5 max", item->data(DETAILS_ROLE).toString());
+}
@@ -15,7 +15,13 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
 #ifdef _MSC_VER
 #pragma warning(push, 0)
 #endif
@@ -49,8 +55,72 @@ namespace plugins
     /// \brief Frequency
     public: double frequency = 1.0;
 
-    /// \brief Timer to keep publishing
-    public: QTimer *timer;
+    /// \brief Total number of messages to publish, zero for no limit.
+    public: int count = 0;
+
+    /// \brief Number of messages published at each period.
+    public: int burst = 1;
+
+    /// \brief Publish messages until stopped or until the count is reached.
+    /// Runs on its own thread.
+    /// \param[in] _msg Message to publish, parsed once.
+    /// \param[in] _period Publishing period, zero to publish bursts back to
+    /// back.
+    /// \param[in] _count Number of messages, zero for no limit.
+    /// \param[in] _burst Number of messages per period.
+    /// \param[in] _run Run which the thread belongs to, passed back to the
+    /// plugin once the count is reached.
+    public: void PublishLoop(
+        std::unique_ptr<google::protobuf::Message> _msg,
+        std::chrono::nanoseconds _period, int _count, int _burst, int _run);
+
+    /// \brief Stop the publishing thread and wait for it.
+    public: void StopThread();
+
+    /// \brief Thread which publishes periodically.
+    public: std::thread thread;
+
+    /// \brief Used to stop the thread.
+    public: bool stop{false};
+
+    /// \brief Protects stop and the statistics.
+    public: std::mutex mutex;
+
+    /// \brief Wakes the thread up when it must stop.
+    public: std::condition_variable cv;
+
+    /// \brief Incremented each time publishing starts, so that the end of
+    /// a previous run isn't mistaken for the end of the current one.
+    public: int run{0};
+
+    /// \brief Plugin which owns this, notified once the count is reached.
+    public: Publisher *plugin{nullptr};
+
+    /// \brief Messages published since the last statistics update.
+    public: uint64_t published{0};
+
+    /// \brief Periods since the last statistics update.
+    public: uint64_t periods{0};
+
+    /// \brief Sum of the delays between the scheduled and actual
+    /// publishing times since the last statistics update, in nanoseconds.
+    public: double errorSum{0.0};
+
+    /// \brief Sum of the squared delays since the last statistics update,
+    /// in squared nanoseconds.
+    public: double errorSqSum{0.0};
+
+    /// \brief Time of the last statistics update.
+    public: std::chrono::steady_clock::time_point statsTime;
+
+    /// \brief Achieved rate, in messages per second.
+    public: double rate{0.0};
+
+    /// \brief Standard deviation of the delays, in microseconds.
+    public: double jitter{0.0};
+
+    /// \brief Timer to update statistics
+    public: QTimer *timer{nullptr};
 
     /// \brief Node for communication
     public: ignition::transport::Node node;
@@ -66,15 +136,94 @@ using namespace ignition;
 using namespace gui;
 using namespace plugins;
 
+/////////////////////////////////////////////////
+void PublisherPrivate::PublishLoop(
+    std::unique_ptr<google::protobuf::Message> _msg,
+    std::chrono::nanoseconds _period, int _count, int _burst, int _run)
+{
+  using namespace std::chrono;
+
+  // Sleeping isn't precise enough for high rates, so wake up a bit earlier
+  // and spin until the scheduled time
+  const auto margin = std::min(duration_cast<nanoseconds>(microseconds(200)),
+      _period / 4);
+
+  int total{0};
+  auto next = steady_clock::now();
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      if (this->cv.wait_until(lock, next - margin,
+          [this]{return this->stop;}))
+      {
+        return;
+      }
+    }
+
+    while (steady_clock::now() < next)
+      std::this_thread::yield();
+
+    auto now = steady_clock::now();
+
+    int n = _burst;
+    if (_count > 0)
+      n = std::min(n, _count - total);
+    for (int i = 0; i < n; ++i)
+      this->pub.Publish(*_msg);
+    total += n;
+
+    {
+      double error = duration<double, std::nano>(now - next).count();
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->published += n;
+      this->periods++;
+      this->errorSum += error;
+      this->errorSqSum += error * error;
+    }
+
+    // Notify right away, rather than on the next statistics update
+    if (_count > 0 && total >= _count)
+    {
+      QMetaObject::invokeMethod(this->plugin, "OnFinished",
+          Qt::QueuedConnection, Q_ARG(int, _run));
+      return;
+    }
+
+    // Keep a fixed schedule, but don't try to catch up if we fell more than
+    // one period behind
+    next += _period;
+    if (now - next > _period)
+      next = now;
+  }
+}
+
+/////////////////////////////////////////////////
+void PublisherPrivate::StopThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->cv.notify_all();
+
+  if (this->thread.joinable())
+    this->thread.join();
+
+  this->stop = false;
+}
+
 /////////////////////////////////////////////////
 Publisher::Publisher()
   : Plugin(), dataPtr(new PublisherPrivate)
 {
+  this->dataPtr->plugin = this;
 }
 
 /////////////////////////////////////////////////
 Publisher::~Publisher()
 {
+  this->dataPtr->StopThread();
 }
 
 /////////////////////////////////////////////////
@@ -100,21 +249,29 @@ void Publisher::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
     if (auto frequencyElem = _pluginElem->FirstChildElement("frequency"))
       frequencyElem->QueryDoubleText(&this->dataPtr->frequency);
+
+    if (auto countElem = _pluginElem->FirstChildElement("count"))
+      countElem->QueryIntText(&this->dataPtr->count);
+
+    if (auto burstElem = _pluginElem->FirstChildElement("burst"))
+      burstElem->QueryIntText(&this->dataPtr->burst);
   }
 
   this->dataPtr->timer = new QTimer(this);
+  this->connect(this->dataPtr->timer, &QTimer::timeout,
+      this, &Publisher::UpdateStats);
 }
 
 /////////////////////////////////////////////////
 void Publisher::OnPublish(const bool _checked)
 {
+  this->dataPtr->StopThread();
+  if (this->dataPtr->timer != nullptr)
+    this->dataPtr->timer->stop();
+  this->dataPtr->run++;
+
   if (!_checked)
   {
-    if (this->dataPtr->timer != nullptr)
-    {
-      this->dataPtr->timer->stop();
-      this->disconnect(this->dataPtr->timer, 0, 0, 0);
-    }
     this->dataPtr->pub = ignition::transport::Node::Publisher();
     return;
   }
@@ -123,7 +280,7 @@ void Publisher::OnPublish(const bool _checked)
   auto msgType = this->dataPtr->msgType.toStdString();
   auto msgData = this->dataPtr->msgData.toStdString();
 
-  // Check it's possible to create message
+  // Parse the message once, it's reused for every publication
   auto msg = ignition::msgs::Factory::New(msgType, msgData);
   if (!msg || (msg->DebugString() == "" && msgData != ""))
   {
@@ -144,21 +301,125 @@ void Publisher::OnPublish(const bool _checked)
     return;
   }
 
-  // Zero frequency, publish once
+  int burst = std::max(1, this->dataPtr->burst);
+  int count = std::max(0, this->dataPtr->count);
+
+  // Zero frequency, publish all messages back to back, which is the count
+  // if there's one, and a single burst otherwise. Large counts would block
+  // the GUI, so they're published on the thread too.
+  std::chrono::nanoseconds period{0};
   if (this->dataPtr->frequency < 0.00001)
   {
-    this->dataPtr->pub.Publish(*msg);
-    // TODO(anyone): notify error and uncheck switch
-    return;
+    if (count == 0)
+      count = burst;
+  }
+  else
+  {
+    period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(1.0 / this->dataPtr->frequency));
   }
 
-  this->dataPtr->timer->setInterval(1000/this->dataPtr->frequency);
-  this->connect(this->dataPtr->timer, &QTimer::timeout, [=]()
   {
-    auto newMsg = ignition::msgs::Factory::New(msgType, msgData);
-    this->dataPtr->pub.Publish(*newMsg);
-  });
-  this->dataPtr->timer->start();
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->published = 0;
+    this->dataPtr->periods = 0;
+    this->dataPtr->errorSum = 0.0;
+    this->dataPtr->errorSqSum = 0.0;
+    this->dataPtr->statsTime = std::chrono::steady_clock::now();
+  }
+
+  this->dataPtr->thread = std::thread(&PublisherPrivate::PublishLoop,
+      this->dataPtr.get(), std::move(msg), period, count, burst,
+      this->dataPtr->run);
+
+  if (this->dataPtr->timer != nullptr)
+    this->dataPtr->timer->start(1000);
+}
+
+/////////////////////////////////////////////////
+void Publisher::UpdateStats()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+    auto now = std::chrono::steady_clock::now();
+    double dt = std::chrono::duration<double>(
+        now - this->dataPtr->statsTime).count();
+    if (dt > 0.0)
+      this->dataPtr->rate = this->dataPtr->published / dt;
+
+    this->dataPtr->jitter = 0.0;
+    if (this->dataPtr->periods > 0)
+    {
+      double mean = this->dataPtr->errorSum / this->dataPtr->periods;
+      double variance = this->dataPtr->errorSqSum / this->dataPtr->periods -
+          mean * mean;
+      this->dataPtr->jitter = std::sqrt(std::max(0.0, variance)) / 1000.0;
+    }
+
+    this->dataPtr->published = 0;
+    this->dataPtr->periods = 0;
+    this->dataPtr->errorSum = 0.0;
+    this->dataPtr->errorSqSum = 0.0;
+    this->dataPtr->statsTime = now;
+  }
+  this->StatsChanged();
+}
+
+/////////////////////////////////////////////////
+void Publisher::OnFinished(const int _run)
+{
+  // Publishing was stopped or restarted since
+  if (_run != this->dataPtr->run)
+    return;
+
+  if (this->dataPtr->timer != nullptr)
+    this->dataPtr->timer->stop();
+  this->dataPtr->StopThread();
+
+  // Statistics of the last partial period
+  this->UpdateStats();
+  this->PublishFinished();
+}
+
+/////////////////////////////////////////////////
+double Publisher::Rate() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->rate;
+}
+
+/////////////////////////////////////////////////
+double Publisher::Jitter() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->jitter;
+}
+
+/////////////////////////////////////////////////
+int Publisher::Count() const
+{
+  return this->dataPtr->count;
+}
+
+/////////////////////////////////////////////////
+void Publisher::SetCount(const int _count)
+{
+  this->dataPtr->count = _count;
+  this->CountChanged();
+}
+
+/////////////////////////////////////////////////
+int Publisher::Burst() const
+{
+  return this->dataPtr->burst;
+}
+
+/////////////////////////////////////////////////
+void Publisher::SetBurst(const int _burst)
+{
+  this->dataPtr->burst = _burst;
+  this->BurstChanged();
 }
 
 /////////////////////////////////////////////////
@@ -42,8 +42,21 @@ namespace plugins
 
   /// \brief Widget which publishes a custom Ignition transport message.
   ///
+  /// The message is parsed once when publishing starts, and published
+  /// periodically from a dedicated thread, which allows rates of several kHz.
+  /// The achieved rate and the scheduling jitter are displayed.
+  ///
   /// ## Configuration
-  /// This plugin doesn't accept any custom configuration.
+  ///
+  /// * \<message_type\> : Message type, i.e. "ignition.msgs.StringMsg".
+  /// * \<message\> : Message contents in text format.
+  /// * \<topic\> : Topic to publish to.
+  /// * \<frequency\> : Publishing frequency in Hz, zero to publish once.
+  /// * \<count\> : Stop after publishing this many messages, defaults to
+  ///                zero, which doesn't stop. With zero frequency, this many
+  ///                messages are published at once instead of a burst.
+  /// * \<burst\> : Number of messages published at each period, defaults
+  ///                to 1.
   class Publisher_EXPORTS_API Publisher : public Plugin
   {
     Q_OBJECT
@@ -80,6 +93,36 @@ namespace plugins
       NOTIFY FrequencyChanged
     )
 
+    /// \brief Number of messages to publish
+    Q_PROPERTY(
+      int count
+      READ Count
+      WRITE SetCount
+      NOTIFY CountChanged
+    )
+
+    /// \brief Number of messages per period
+    Q_PROPERTY(
+      int burst
+      READ Burst
+      WRITE SetBurst
+      NOTIFY BurstChanged
+    )
+
+    /// \brief Achieved rate
+    Q_PROPERTY(
+      double rate
+      READ Rate
+      NOTIFY StatsChanged
+    )
+
+    /// \brief Scheduling jitter
+    Q_PROPERTY(
+      double jitter
+      READ Jitter
+      NOTIFY StatsChanged
+    )
+
     /// \brief Constructor
     public: Publisher();
 
@@ -143,6 +186,52 @@ namespace plugins
     /// \brief Notify that frequency has changed
     signals: void FrequencyChanged();
 
+    /// \brief Get the number of messages to publish before stopping
+    /// \return Number of messages, zero for no limit
+    public: Q_INVOKABLE int Count() const;
+
+    /// \brief Set the number of messages to publish before stopping
+    /// \param[in] _count Number of messages, zero for no limit
+    public: Q_INVOKABLE void SetCount(const int _count);
+
+    /// \brief Notify that count has changed
+    signals: void CountChanged();
+
+    /// \brief Get the number of messages published at each period
+    /// \return Number of messages
+    public: Q_INVOKABLE int Burst() const;
+
+    /// \brief Set the number of messages published at each period
+    /// \param[in] _burst Number of messages
+    public: Q_INVOKABLE void SetBurst(const int _burst);
+
+    /// \brief Notify that burst has changed
+    signals: void BurstChanged();
+
+    /// \brief Get the achieved publishing rate, updated every second
+    /// \return Messages per second
+    public: Q_INVOKABLE double Rate() const;
+
+    /// \brief Get the standard deviation of the delays between the
+    /// scheduled and actual publishing times, updated every second
+    /// \return Jitter in microseconds
+    public: Q_INVOKABLE double Jitter() const;
+
+    /// \brief Notify that rate and jitter have changed
+    signals: void StatsChanged();
+
+    /// \brief Notify that publishing stopped because the count was reached,
+    /// or because all messages were published with zero frequency. It's
+    /// emitted once events are processed after publishing ends.
+    signals: void PublishFinished();
+
+    /// \brief Update rate and jitter, called every second while publishing
+    private slots: void UpdateStats();
+
+    /// \brief Called from the publishing thread once the count is reached.
+    /// \param[in] _run Run which finished.
+    private slots: void OnFinished(const int _run);
+
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<PublisherPrivate> dataPtr;
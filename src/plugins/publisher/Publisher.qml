@@ -22,7 +22,7 @@ Rectangle {
   id: publisher
   color: "transparent"
   Layout.minimumWidth: 250
-  Layout.minimumHeight: 375
+  Layout.minimumHeight: 500
   anchors.fill: parent
 
   property int tooltipDelay: 500
@@ -78,14 +78,60 @@ Rectangle {
 
     SpinBox {
       id: frequencyField
-      value: 1.00
+      value: Publisher.frequency
+      to: 100000
+      editable: true
 // why can't this be parsed?
 //      decimals: 2
 //      minimumValue: 0.0
 //      maximumValue: 10000.0
     }
 
+    Label {
+      text: "Count"
+      ToolTip.visible: countMa.containsMouse
+      ToolTip.delay: tooltipDelay
+      ToolTip.timeout: tooltipTimeout
+      ToolTip.text: qsTr("Stop after publishing this many messages, zero to keep publishing")
+
+      MouseArea {
+        id: countMa
+        anchors.fill: parent
+        hoverEnabled: true
+      }
+    }
+
+    SpinBox {
+      id: countField
+      value: Publisher.count
+      to: 1000000
+      editable: true
+    }
+
+    Label {
+      text: "Burst"
+      ToolTip.visible: burstMa.containsMouse
+      ToolTip.delay: tooltipDelay
+      ToolTip.timeout: tooltipTimeout
+      ToolTip.text: qsTr("Messages published at each period")
+
+      MouseArea {
+        id: burstMa
+        anchors.fill: parent
+        hoverEnabled: true
+      }
+    }
+
+    SpinBox {
+      id: burstField
+      value: Publisher.burst
+      from: 1
+      to: 10000
+      editable: true
+    }
+
     Switch {
+      id: publishSwitch
       text: qsTr("Publish")
       onToggled: {
 
@@ -94,6 +140,8 @@ Rectangle {
         Publisher.topic = topicField.text
         Publisher.msgData = msgDataField.text
         Publisher.frequency = frequencyField.value
+        Publisher.count = countField.value
+        Publisher.burst = burstField.value
 
         Publisher.OnPublish(checked);
       }
@@ -102,5 +150,17 @@ Rectangle {
       ToolTip.timeout: tooltipTimeout
       ToolTip.text: checked ? qsTr("Stop publising") : qsTr("Start publishing")
     }
+
+    Label {
+      text: Publisher.rate.toFixed(1) + " Hz, jitter " +
+            Publisher.jitter.toFixed(1) + " \u00B5s"
+      visible: publishSwitch.checked
+      font.pointSize: 8
+    }
+
+    Connections {
+      target: Publisher
+      onPublishFinished: publishSwitch.checked = false
+    }
   }
 }
@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <atomic>
+
 #ifdef _MSC_VER
 #pragma warning(push, 0)
 #endif
@@ -208,6 +211,102 @@ TEST(PublisherTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Publish))
   plugins.clear();
 }
 
+//////////////////////////////////////////////////
+TEST(PublisherTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(CountAndBurst))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Load plugin
+  const char *pluginStr =
+    "<plugin filename=\"Publisher\">"
+      "<topic>/count</topic>"
+      "<frequency>200</frequency>"
+      "<count>20</count>"
+      "<burst>4</burst>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("Publisher",
+      pluginDoc.FirstChildElement("plugin")));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Get plugin
+  auto plugins = win->findChildren<plugins::Publisher *>();
+  ASSERT_EQ(plugins.size(), 1);
+
+  auto plugin = plugins[0];
+  EXPECT_EQ(plugin->Count(), 20);
+  EXPECT_EQ(plugin->Burst(), 4);
+
+  // Subscribe
+  std::atomic<int> received{0};
+  std::function<void(const msgs::StringMsg &)> cb =
+      [&](const msgs::StringMsg &)
+  {
+    received++;
+  };
+  transport::Node node;
+  node.Subscribe("/count", cb);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  bool finished{false};
+  plugin->connect(plugin, &plugins::Publisher::PublishFinished,
+      [&finished]()
+  {
+    finished = true;
+  });
+
+  // Publishes 5 bursts of 4 messages, then stops
+  auto start = std::chrono::steady_clock::now();
+  plugin->OnPublish(true);
+
+  int sleep = 0;
+  int maxSleep = 300;
+  while (!finished && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+    sleep++;
+  }
+
+  // Notified as soon as it's done, not on the next statistics update
+  EXPECT_TRUE(finished);
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+      std::chrono::milliseconds(900));
+  EXPECT_EQ(20, received.load());
+  EXPECT_GT(plugin->Rate(), 0.0);
+  EXPECT_GE(plugin->Jitter(), 0.0);
+
+  plugin->OnPublish(false);
+
+  // With zero frequency, the count is published back to back on the
+  // publishing thread, then the end is notified the same way
+  finished = false;
+  received = 0;
+  plugin->SetFrequency(0.0);
+  plugin->SetCount(7);
+  plugin->OnPublish(true);
+
+  sleep = 0;
+  while ((!finished || received < 7) && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+    sleep++;
+  }
+  EXPECT_TRUE(finished);
+  EXPECT_EQ(7, received.load());
+
+  plugin->OnPublish(false);
+}
+
 //////////////////////////////////////////////////
 TEST(PublisherTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(ParamsFromSDF))
 {
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Util.hh>
+#include <ignition/plugin/Register.hh>
+#include <ignition/transport/MessageInfo.hh>
+#include <ignition/transport/Node.hh>
+
+#include "ignition/gui/TransportLog.hh"
+
+#include "Recorder.hh"
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  class RecorderPrivate
+  {
+    /// \brief Subscribe to a topic, writing its messages to the log.
+    /// \param[in] _topic Topic name.
+    public: void Record(const std::string &_topic);
+
+    /// \brief Default log path, in the home directory.
+    /// \return Path.
+    public: std::string DefaultPath() const;
+
+    /// \brief Log file, declared before the node so that it outlives its
+    /// subscriptions
+    public: TransportLogWriter writer;
+
+    /// \brief Node for communication
+    public: transport::Node node;
+
+    /// \brief Topics from the config, empty to record all topics
+    public: std::vector<std::string> configTopics;
+
+    /// \brief Topics being recorded
+    public: std::unordered_set<std::string> recorded;
+
+    /// \brief Log file path, empty for the default
+    public: QString path;
+
+    /// \brief Whether recording
+    public: bool recording{false};
+
+    /// \brief Timer which updates stats and subscriptions while recording
+    public: QTimer *timer{nullptr};
+  };
+}
+}
+}
+
+using namespace ignition;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+void RecorderPrivate::Record(const std::string &_topic)
+{
+  if (this->recorded.count(_topic))
+    return;
+
+  auto cb = [this, _topic](const char *_data, const size_t _size,
+      const transport::MessageInfo &_info)
+  {
+    this->writer.Write(_topic, _info.Type(), _data, _size);
+  };
+
+  if (!this->node.SubscribeRaw(_topic, cb))
+  {
+    ignerr << "Failed to subscribe to [" << _topic << "]" << std::endl;
+    return;
+  }
+  this->recorded.insert(_topic);
+}
+
+/////////////////////////////////////////////////
+std::string RecorderPrivate::DefaultPath() const
+{
+  std::string home;
+  common::env(IGN_HOMEDIR, home);
+
+  return common::joinPaths(home, ".ignition", "gui", "recordings",
+      common::timeToIso(IGN_SYSTEM_TIME()) + ".tlog");
+}
+
+/////////////////////////////////////////////////
+Recorder::Recorder()
+  : Plugin(), dataPtr(new RecorderPrivate)
+{
+  this->dataPtr->timer = new QTimer(this);
+  this->connect(this->dataPtr->timer, &QTimer::timeout,
+      this, &Recorder::Update);
+}
+
+/////////////////////////////////////////////////
+Recorder::~Recorder()
+{
+  this->OnRecord(false);
+}
+
+/////////////////////////////////////////////////
+void Recorder::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Recorder";
+
+  if (!_pluginElem)
+    return;
+
+  for (auto topicElem = _pluginElem->FirstChildElement("topic");
+       topicElem != nullptr && topicElem->GetText() != nullptr;
+       topicElem = topicElem->NextSiblingElement("topic"))
+  {
+    this->dataPtr->configTopics.push_back(topicElem->GetText());
+  }
+
+  if (auto pathElem = _pluginElem->FirstChildElement("path"))
+  {
+    if (pathElem->GetText())
+      this->SetPath(QString::fromStdString(pathElem->GetText()));
+  }
+
+  bool record{false};
+  if (auto recordElem = _pluginElem->FirstChildElement("record"))
+    recordElem->QueryBoolText(&record);
+
+  if (record)
+    this->OnRecord(true);
+}
+
+/////////////////////////////////////////////////
+void Recorder::OnRecord(const bool _record)
+{
+  if (_record == this->dataPtr->recording)
+    return;
+
+  if (!_record)
+  {
+    this->dataPtr->timer->stop();
+    for (const auto &topic : this->dataPtr->recorded)
+      this->dataPtr->node.Unsubscribe(topic);
+    this->dataPtr->recorded.clear();
+
+    ignmsg << "Recorded [" << this->dataPtr->writer.Count()
+           << "] messages" << std::endl;
+    this->dataPtr->writer.Close();
+
+    this->dataPtr->recording = false;
+    this->RecordingChanged();
+    return;
+  }
+
+  auto path = this->dataPtr->path.toStdString();
+  if (path.empty())
+  {
+    path = this->dataPtr->DefaultPath();
+    common::createDirectories(common::parentPath(path));
+  }
+
+  if (!this->dataPtr->writer.Open(path))
+  {
+    this->RecordingChanged();
+    return;
+  }
+
+  ignmsg << "Recording to [" << path << "]" << std::endl;
+
+  this->dataPtr->recording = true;
+  this->Update();
+  this->dataPtr->timer->start(1000);
+
+  this->RecordingChanged();
+}
+
+/////////////////////////////////////////////////
+void Recorder::Update()
+{
+  if (!this->dataPtr->recording)
+    return;
+
+  if (!this->dataPtr->configTopics.empty())
+  {
+    for (const auto &topic : this->dataPtr->configTopics)
+      this->dataPtr->Record(topic);
+  }
+  else
+  {
+    std::vector<std::string> topics;
+    this->dataPtr->node.TopicList(topics);
+    for (const auto &topic : topics)
+      this->dataPtr->Record(topic);
+  }
+
+  this->StatsChanged();
+}
+
+/////////////////////////////////////////////////
+QString Recorder::Path() const
+{
+  return this->dataPtr->path;
+}
+
+/////////////////////////////////////////////////
+void Recorder::SetPath(const QString &_path)
+{
+  this->dataPtr->path = _path;
+  this->PathChanged();
+}
+
+/////////////////////////////////////////////////
+bool Recorder::Recording() const
+{
+  return this->dataPtr->recording;
+}
+
+/////////////////////////////////////////////////
+int Recorder::MessageCount() const
+{
+  return static_cast<int>(this->dataPtr->writer.Count());
+}
+
+/////////////////////////////////////////////////
+int Recorder::TopicCount() const
+{
+  return static_cast<int>(this->dataPtr->recorded.size());
+}
+
+// Register this plugin
+IGNITION_ADD_PLUGIN(ignition::gui::plugins::Recorder,
+                    ignition::gui::Plugin)
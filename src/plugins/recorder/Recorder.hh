@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_PLUGINS_RECORDER_HH_
+#define IGNITION_GUI_PLUGINS_RECORDER_HH_
+
+#include <memory>
+
+#include "ignition/gui/Plugin.hh"
+
+#ifndef _WIN32
+#  define Recorder_EXPORTS_API
+#else
+#  if (defined(Recorder_EXPORTS))
+#    define Recorder_EXPORTS_API __declspec(dllexport)
+#  else
+#    define Recorder_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  class RecorderPrivate;
+
+  /// \brief Record transport messages into a log file, so the exact stream
+  /// which a GUI received can be replayed later with
+  /// `ign gui -c <config> --replay <log>`.
+  ///
+  /// Messages are recorded with raw subscriptions, so they're never
+  /// deserialized, and are written with the time at which they were
+  /// received. See TransportLogWriter for the file format.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<topic\> : Topic to record, can be repeated. If no topics are
+  ///               given, all advertised topics are recorded, including the
+  ///               ones which are advertised while recording.
+  /// * \<path\> : Path of the log file. Defaults to a file named after the
+  ///              current time in `~/.ignition/gui/recordings`.
+  /// * \<record\> : True to start recording as soon as the plugin is
+  ///                loaded, defaults to false.
+  class Recorder_EXPORTS_API Recorder : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Log file path
+    Q_PROPERTY(
+      QString path
+      READ Path
+      WRITE SetPath
+      NOTIFY PathChanged
+    )
+
+    /// \brief Whether recording
+    Q_PROPERTY(
+      bool recording
+      READ Recording
+      NOTIFY RecordingChanged
+    )
+
+    /// \brief Number of recorded messages
+    Q_PROPERTY(
+      int messageCount
+      READ MessageCount
+      NOTIFY StatsChanged
+    )
+
+    /// \brief Number of recorded topics
+    Q_PROPERTY(
+      int topicCount
+      READ TopicCount
+      NOTIFY StatsChanged
+    )
+
+    /// \brief Constructor
+    public: Recorder();
+
+    /// \brief Destructor
+    public: ~Recorder() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
+
+    /// \brief Start or stop recording.
+    /// \param[in] _record True to start recording.
+    public slots: void OnRecord(const bool _record);
+
+    /// \brief Get the log file path.
+    /// \return Path, empty to use the default.
+    public: Q_INVOKABLE QString Path() const;
+
+    /// \brief Set the log file path, used the next time recording starts.
+    /// \param[in] _path Path, empty to use the default.
+    public: Q_INVOKABLE void SetPath(const QString &_path);
+
+    /// \brief Notify that the path has changed
+    signals: void PathChanged();
+
+    /// \brief Get whether recording.
+    /// \return True if recording.
+    public: Q_INVOKABLE bool Recording() const;
+
+    /// \brief Notify that recording started or stopped
+    signals: void RecordingChanged();
+
+    /// \brief Get the number of messages recorded since recording started.
+    /// \return Number of messages.
+    public: Q_INVOKABLE int MessageCount() const;
+
+    /// \brief Get the number of topics being recorded.
+    /// \return Number of topics.
+    public: Q_INVOKABLE int TopicCount() const;
+
+    /// \brief Notify that the message or topic counts have changed
+    signals: void StatsChanged();
+
+    /// \brief Subscribe to new topics and update the counts, called every
+    /// second while recording.
+    private slots: void Update();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<RecorderPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.2
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: recorder
+  color: "transparent"
+  Layout.minimumWidth: 250
+  Layout.minimumHeight: 150
+  anchors.fill: parent
+
+  Column {
+    anchors.fill: parent
+    anchors.margins: 10
+
+    Label {
+      text: "Log file"
+    }
+
+    TextField {
+      id: pathField
+      width: parent.width
+      text: Recorder.path
+      placeholderText: qsTr("Default: ~/.ignition/gui/recordings")
+      selectByMouse: true
+      enabled: !Recorder.recording
+    }
+
+    Switch {
+      id: recordSwitch
+      text: qsTr("Record")
+      checked: Recorder.recording
+      onToggled: {
+        Recorder.path = pathField.text
+        Recorder.OnRecord(checked)
+      }
+    }
+
+    Label {
+      text: Recorder.messageCount + " messages from " +
+            Recorder.topicCount + " topics"
+      font.pointSize: 8
+    }
+  }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <ignition/msgs/stringmsg.pb.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+#include <ignition/common/Console.hh>
+#include <ignition/transport/Node.hh>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/Plugin.hh"
+#include "ignition/gui/MainWindow.hh"
+#include "ignition/gui/TransportLog.hh"
+
+#include "Recorder.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./Recorder_TEST")),
+};
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(RecorderTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Load))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  EXPECT_TRUE(app.LoadPlugin("Recorder"));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Get plugin
+  auto plugins = win->findChildren<Plugin *>();
+  EXPECT_EQ(plugins.size(), 1);
+
+  auto plugin = plugins[0];
+  EXPECT_EQ(plugin->Title(), "Recorder");
+
+  // Cleanup
+  plugins.clear();
+}
+
+/////////////////////////////////////////////////
+TEST(RecorderTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Record))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  std::string path = "/tmp/ign-gui-recorder-test.tlog";
+
+  std::string pluginStr =
+    "<plugin filename=\"Recorder\">"
+      "<topic>/recorder_topic</topic>"
+      "<path>" + path + "</path>"
+      "<record>true</record>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr.c_str()));
+  EXPECT_TRUE(app.LoadPlugin("Recorder",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  auto plugins = win->findChildren<plugins::Recorder *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  // Recording started from config
+  EXPECT_TRUE(plugin->Recording());
+  EXPECT_EQ(1, plugin->TopicCount());
+
+  // Publish
+  transport::Node node;
+  auto pub = node.Advertise<msgs::StringMsg>("/recorder_topic");
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  msgs::StringMsg msg;
+  for (int i = 0; i < 10; ++i)
+  {
+    msg.set_data("hello " + std::to_string(i));
+    pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  int sleep = 0;
+  while (plugin->MessageCount() < 10 && sleep++ < 30)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(10, plugin->MessageCount());
+
+  plugin->OnRecord(false);
+  EXPECT_FALSE(plugin->Recording());
+
+  // Check the log
+  TransportLogReader reader;
+  ASSERT_TRUE(reader.Open(path));
+
+  TransportLogRecord record;
+  std::chrono::nanoseconds lastTime{0};
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(reader.Next(record));
+    EXPECT_EQ("/recorder_topic", record.topic);
+    EXPECT_EQ("ignition.msgs.StringMsg", record.type);
+    EXPECT_GE(record.time, lastTime);
+    lastTime = record.time;
+
+    msgs::StringMsg recorded;
+    ASSERT_TRUE(recorded.ParseFromString(record.data));
+    EXPECT_EQ("hello " + std::to_string(i), recorded.data());
+  }
+  EXPECT_FALSE(reader.Next(record));
+}
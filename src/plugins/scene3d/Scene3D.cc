@@ -59,6 +59,7 @@
 #include "ignition/gui/Conversions.hh"
 #include "ignition/gui/GuiEvents.hh"
 #include "ignition/gui/MainWindow.hh"
+#include "ignition/gui/RenderHooks.hh"
 
 namespace ignition
 {
@@ -242,6 +243,10 @@ namespace plugins
 
     /// \brief View control focus target
     public: math::Vector3d target;
+
+    /// \brief Main window, which receives scene events. It's looked up once
+    /// instead of on every event.
+    public: MainWindow *mainWindow{nullptr};
   };
 
   /// \brief Private data class for RenderWindowItem
@@ -903,11 +908,12 @@ void IgnRenderer::Render()
   // update and render to texture
   this->dataPtr->camera->Update();
 
-  if (ignition::gui::App())
+  // Plugins which registered hooks, then plugins which filter events
+  runRenderHooks(RenderPhase::kRender);
+  if (nullptr != this->dataPtr->mainWindow)
   {
-    ignition::gui::App()->sendEvent(
-        ignition::gui::App()->findChild<ignition::gui::MainWindow *>(),
-        new gui::events::Render());
+    gui::events::Render event;
+    App()->sendEvent(this->dataPtr->mainWindow, &event);
   }
 }
 
@@ -1039,7 +1045,7 @@ void IgnRenderer::BroadcastHoverPos()
   auto pos = this->ScreenToScene(this->dataPtr->mouseHoverPos);
 
   events::HoverToScene hoverToSceneEvent(pos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &hoverToSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &hoverToSceneEvent);
 }
 
 /////////////////////////////////////////////////
@@ -1060,8 +1066,8 @@ void IgnRenderer::BroadcastLeftClick()
   events::LeftClickToScene leftClickToSceneEvent(pos);
   events::LeftClickOnScene leftClickOnSceneEvent(this->dataPtr->mouseEvent);
 
-  App()->sendEvent(App()->findChild<MainWindow *>(), &leftClickToSceneEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &leftClickOnSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &leftClickToSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &leftClickOnSceneEvent);
 }
 
 /////////////////////////////////////////////////
@@ -1082,8 +1088,8 @@ void IgnRenderer::BroadcastRightClick()
   events::RightClickToScene rightClickToSceneEvent(pos);
   events::RightClickOnScene rightClickOnSceneEvent(this->dataPtr->mouseEvent);
 
-  App()->sendEvent(App()->findChild<MainWindow *>(), &rightClickToSceneEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &rightClickOnSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &rightClickToSceneEvent);
+  App()->sendEvent(this->dataPtr->mainWindow, &rightClickOnSceneEvent);
 }
 
 /////////////////////////////////////////////////
@@ -1092,7 +1098,7 @@ void IgnRenderer::BroadcastKeyRelease()
   if (this->dataPtr->keyEvent.Type() == common::KeyEvent::RELEASE)
   {
     events::KeyReleaseOnScene keyRelease(this->dataPtr->keyEvent);
-    App()->sendEvent(App()->findChild<MainWindow *>(), &keyRelease);
+    App()->sendEvent(this->dataPtr->mainWindow, &keyRelease);
     this->dataPtr->keyEvent.SetType(common::KeyEvent::NO_EVENT);
   }
 }
@@ -1103,7 +1109,7 @@ void IgnRenderer::BroadcastKeyPress()
   if (this->dataPtr->keyEvent.Type() == common::KeyEvent::PRESS)
   {
     events::KeyPressOnScene keyPress(this->dataPtr->keyEvent);
-    App()->sendEvent(App()->findChild<MainWindow *>(), &keyPress);
+    App()->sendEvent(this->dataPtr->mainWindow, &keyPress);
     this->dataPtr->keyEvent.SetType(common::KeyEvent::NO_EVENT);
   }
 }
@@ -1114,11 +1120,13 @@ void IgnRenderer::Initialize()
   if (this->initialized)
     return;
 
+  this->dataPtr->mainWindow =
+      ignition::gui::App()->findChild<ignition::gui::MainWindow *>();
+
   std::map<std::string, std::string> params;
   params["useCurrentGLContext"] = "1";
   params["winID"] = std::to_string(
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->
-      QuickWindow()->winId());
+    this->dataPtr->mainWindow->QuickWindow()->winId());
 
   auto engine = rendering::engine(this->engineName, params);
   if (!engine)
@@ -118,19 +118,12 @@ void Screenshot::LoadConfig(const tinyxml2::XMLElement *)
   ignmsg << "Screenshot service on ["
          << this->dataPtr->screenshotService << "]" << std::endl;
 
-  App()->findChild<MainWindow *>()->installEventFilter(this);
-}
-
-/////////////////////////////////////////////////
-bool Screenshot::eventFilter(QObject *_obj, QEvent *_event)
-{
-  if (_event->type() == events::Render::kType && this->dataPtr->dirty)
-  {
-    this->SaveScreenshot();
-  }
-
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+  this->AddRenderHook(RenderPhase::kRender, "Screenshot::OnRender",
+      [this]()
+      {
+        if (this->dataPtr->dirty)
+          this->SaveScreenshot();
+      });
 }
 
 /////////////////////////////////////////////////
@@ -77,11 +77,6 @@ namespace plugins
     /// \brief Callback when screenshot is requested from the GUI.
     public slots: void OnScreenshot();
 
-    /// \brief Callback for all installed event filders.
-    /// \param[in] _obj Object that received the event
-    /// \param[in] _event Event
-    private: bool eventFilter(QObject *_obj, QEvent *_event) override;
-
     /// \brief Callback for saving a screenshot (from the user camera) request
     /// \param[in] _msg Request message of the directory path to save
     /// screenshots
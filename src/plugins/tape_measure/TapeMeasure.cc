@@ -108,10 +108,27 @@ void TapeMeasure::LoadConfig(const tinyxml2::XMLElement *)
   if (this->title.empty())
     this->title = "Tape measure";
 
-  ignition::gui::App()->findChild<ignition::gui::MainWindow *>
-      ()->installEventFilter(this);
+  // Key presses and releases
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>
       ()->QuickWindow()->installEventFilter(this);
+
+  this->SubscribeEvent<ignition::gui::events::HoverToScene>(
+      [this](const ignition::gui::events::HoverToScene &_event)
+      {
+        this->OnHover(_event.Point());
+      });
+  this->SubscribeEvent<ignition::gui::events::LeftClickToScene>(
+      [this](const ignition::gui::events::LeftClickToScene &_event)
+      {
+        this->OnLeftClick(_event.Point());
+      });
+  // Cancel the current action if a right click is detected
+  this->SubscribeEvent<ignition::gui::events::RightClickToScene>(
+      [this](const ignition::gui::events::RightClickToScene &)
+      {
+        if (this->dataPtr->measure)
+          this->Reset();
+      });
 }
 
 /////////////////////////////////////////////////
@@ -229,75 +246,69 @@ void TapeMeasure::DrawLine(int _id, ignition::math::Vector3d &_startPoint,
 }
 
 /////////////////////////////////////////////////
-bool TapeMeasure::eventFilter(QObject *_obj, QEvent *_event)
+void TapeMeasure::OnHover(const ignition::math::Vector3d &_point)
 {
-  if (_event->type() == ignition::gui::events::HoverToScene::kType)
+  if (!this->dataPtr->measure)
+    return;
+
+  ignition::math::Vector3d point = _point;
+  this->DrawPoint(this->dataPtr->currentId, point,
+    this->dataPtr->hoverColor);
+
+  // If the user is currently choosing the end point, draw the connecting
+  // line and update the new distance.
+  if (this->dataPtr->currentId == this->dataPtr->kEndPointId)
   {
-    auto hoverToSceneEvent =
-        reinterpret_cast<ignition::gui::events::HoverToScene *>(_event);
+    this->DrawLine(this->dataPtr->kLineId, this->dataPtr->startPoint,
+      point, this->dataPtr->hoverColor);
+    this->dataPtr->distance = this->dataPtr->startPoint.Distance(point);
+    this->newDistance();
+  }
+}
 
-    // This event is called in Scene3d's RenderThread, so it's safe to make
-    // rendering calls here
-    if (this->dataPtr->measure && hoverToSceneEvent)
-    {
-      ignition::math::Vector3d point = hoverToSceneEvent->Point();
-      this->DrawPoint(this->dataPtr->currentId, point,
-        this->dataPtr->hoverColor);
+/////////////////////////////////////////////////
+void TapeMeasure::OnLeftClick(const ignition::math::Vector3d &_point)
+{
+  if (!this->dataPtr->measure)
+    return;
 
-      // If the user is currently choosing the end point, draw the connecting
-      // line and update the new distance.
-      if (this->dataPtr->currentId == this->dataPtr->kEndPointId)
-      {
-        this->DrawLine(this->dataPtr->kLineId, this->dataPtr->startPoint,
-          point, this->dataPtr->hoverColor);
-        this->dataPtr->distance = this->dataPtr->startPoint.Distance(point);
-        this->newDistance();
-      }
-    }
+  ignition::math::Vector3d point = _point;
+  this->DrawPoint(this->dataPtr->currentId, point,
+    this->dataPtr->drawColor);
+  // If the user is placing the start point, update its position
+  if (this->dataPtr->currentId == this->dataPtr->kStartPointId)
+  {
+    this->dataPtr->startPoint = point;
   }
-  else if (_event->type() == ignition::gui::events::LeftClickToScene::kType)
+  // If the user is placing the end point, update the end position,
+  // end the measurement state, and update the draw line and distance
+  else
   {
-    auto leftClickToSceneEvent =
-        reinterpret_cast<ignition::gui::events::LeftClickToScene *>(_event);
-
-    // This event is called in Scene3d's RenderThread, so it's safe to make
-    // rendering calls here
-    if (this->dataPtr->measure && leftClickToSceneEvent)
-    {
-      ignition::math::Vector3d point = leftClickToSceneEvent->Point();
-      this->DrawPoint(this->dataPtr->currentId, point,
-        this->dataPtr->drawColor);
-      // If the user is placing the start point, update its position
-      if (this->dataPtr->currentId == this->dataPtr->kStartPointId)
-      {
-        this->dataPtr->startPoint = point;
-      }
-      // If the user is placing the end point, update the end position,
-      // end the measurement state, and update the draw line and distance
-      else
-      {
-        this->dataPtr->endPoint = point;
-        this->dataPtr->measure = false;
-        this->DrawLine(this->dataPtr->kLineId, this->dataPtr->startPoint,
-          this->dataPtr->endPoint, this->dataPtr->drawColor);
-        this->dataPtr->distance =
-          this->dataPtr->startPoint.Distance(this->dataPtr->endPoint);
-        this->newDistance();
-        QGuiApplication::restoreOverrideCursor();
-
-        // Notify Scene3D that we are done using the right click, so it can
-        // re-enable the settings menu
-        ignition::gui::events::DropdownMenuEnabled
-          dropdownMenuEnabledEvent(true);
-
-        ignition::gui::App()->sendEvent(
-            ignition::gui::App()->findChild<ignition::gui::MainWindow *>(),
-            &dropdownMenuEnabledEvent);
-      }
-      this->dataPtr->currentId = this->dataPtr->kEndPointId;
-    }
+    this->dataPtr->endPoint = point;
+    this->dataPtr->measure = false;
+    this->DrawLine(this->dataPtr->kLineId, this->dataPtr->startPoint,
+      this->dataPtr->endPoint, this->dataPtr->drawColor);
+    this->dataPtr->distance =
+      this->dataPtr->startPoint.Distance(this->dataPtr->endPoint);
+    this->newDistance();
+    QGuiApplication::restoreOverrideCursor();
+
+    // Notify Scene3D that we are done using the right click, so it can
+    // re-enable the settings menu
+    ignition::gui::events::DropdownMenuEnabled
+      dropdownMenuEnabledEvent(true);
+
+    ignition::gui::App()->sendEvent(
+        ignition::gui::App()->findChild<ignition::gui::MainWindow *>(),
+        &dropdownMenuEnabledEvent);
   }
-  else if (_event->type() == QEvent::KeyPress)
+  this->dataPtr->currentId = this->dataPtr->kEndPointId;
+}
+
+/////////////////////////////////////////////////
+bool TapeMeasure::eventFilter(QObject *_obj, QEvent *_event)
+{
+  if (_event->type() == QEvent::KeyPress)
   {
     QKeyEvent *keyEvent = static_cast<QKeyEvent*>(_event);
     if (keyEvent && keyEvent->key() == Qt::Key_M)
@@ -315,14 +326,6 @@ bool TapeMeasure::eventFilter(QObject *_obj, QEvent *_event)
       this->Reset();
     }
   }
-  // Cancel the current action if a right click is detected
-  else if (_event->type() == ignition::gui::events::RightClickToScene::kType)
-  {
-    if (this->dataPtr->measure)
-    {
-      this->Reset();
-    }
-  }
 
   return QObject::eventFilter(_obj, _event);
 }
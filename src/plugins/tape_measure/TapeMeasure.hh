@@ -92,6 +92,16 @@ namespace gui
     // Documentation inherited
     protected: bool eventFilter(QObject *_obj, QEvent *_event) override;
 
+    /// \brief Draw the hovered point while measuring. Called in the render
+    /// thread, so it's safe to make rendering calls here.
+    /// \param[in] _point Hovered point on the scene.
+    private: void OnHover(const ignition::math::Vector3d &_point);
+
+    /// \brief Place the start or end point while measuring. Called in the
+    /// render thread, so it's safe to make rendering calls here.
+    /// \param[in] _point Clicked point on the scene.
+    private: void OnLeftClick(const ignition::math::Vector3d &_point);
+
     /// \brief Signal fired when a new tape measure distance is set.
     signals: void newDistance();
 
@@ -15,13 +15,19 @@
  *
 */
 
+#include <chrono>
+#include <deque>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <ignition/common/Console.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/transport/Node.hh>
 
 #include "ignition/gui/Application.hh"
+#include "ignition/gui/RawMessage.hh"
 #include "TopicEcho.hh"
+#include "TopicEchoModel.hh"
 
 namespace ignition
 {
@@ -34,8 +40,8 @@ namespace plugins
     /// \brief Topic
     public: QString topic{"/echo"};
 
-    /// \brief A list of text data.
-    public: QStringListModel msgList;
+    /// \brief Displayed messages.
+    public: TopicEchoModel msgList;
 
     /// \brief Size of the text buffer. The size is the number of
     /// messages.
@@ -44,6 +50,34 @@ namespace plugins
     /// \brief Flag used to pause message parsing.
     public: bool paused{false};
 
+    /// \brief True while echoing, even if unsubscribed because the plugin
+    /// is inactive.
+    public: bool echoing{false};
+
+    /// \brief Messages received since the list was last updated, bounded by
+    /// the buffer size.
+    public: std::deque<RawMessagePtr> pending;
+
+    /// \brief Total number of messages received.
+    public: uint64_t receivedCount{0};
+
+    /// \brief Number of messages received which were never displayed,
+    /// because newer messages pushed them out of the buffer before the list
+    /// was updated.
+    public: uint64_t droppedCount{0};
+
+    /// \brief Received count at the last rate update.
+    public: uint64_t lastReceivedCount{0};
+
+    /// \brief Time of the last rate update.
+    public: std::chrono::steady_clock::time_point lastRateTime;
+
+    /// \brief Incoming message rate in Hz.
+    public: double rate{0.0};
+
+    /// \brief Timer which updates the list at display rate.
+    public: QTimer *displayTimer{nullptr};
+
     /// \brief Mutex to protect message buffer.
     public: std::mutex mutex;
 
@@ -65,6 +99,12 @@ TopicEcho::TopicEcho()
   // Connect model
   App()->Engine()->rootContext()->setContextProperty("TopicEchoMsgList",
       &this->dataPtr->msgList);
+
+  // Messages are added to the list in batches, at most at display rate
+  this->dataPtr->lastRateTime = std::chrono::steady_clock::now();
+  this->dataPtr->displayTimer = new QTimer(this);
+  this->connect(this->dataPtr->displayTimer, &QTimer::timeout,
+      this, &TopicEcho::UpdateList);
 }
 
 /////////////////////////////////////////////////
@@ -78,8 +118,8 @@ void TopicEcho::LoadConfig(const tinyxml2::XMLElement * /*_pluginElem*/)
   if (this->title.empty())
     this->title = "Topic echo";
 
-  this->connect(this, SIGNAL(AddMsg(QString)), this, SLOT(OnAddMsg(QString)),
-          Qt::QueuedConnection);
+  // Only start once loaded, which lazy plugins defer until they're shown
+  this->dataPtr->displayTimer->start(33);
 }
 
 /////////////////////////////////////////////////
@@ -88,8 +128,8 @@ void TopicEcho::Stop()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Erase all previous messages
-  this->dataPtr->msgList.removeRows(0,
-      this->dataPtr->msgList.rowCount());
+  this->dataPtr->msgList.Clear();
+  this->dataPtr->pending.clear();
 
   // Unsubscribe
   for (auto const &sub : this->dataPtr->node.SubscribedTopics())
@@ -101,47 +141,102 @@ void TopicEcho::OnEcho(const bool _checked)
 {
   this->Stop();
 
-  if (!_checked)
+  this->dataPtr->echoing = _checked;
+  if (!_checked || !this->Active())
     return;
 
+  this->Subscribe();
+}
+
+/////////////////////////////////////////////////
+void TopicEcho::OnActivate()
+{
+  {
+    // The rate is measured from now on, not over the inactive period
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->lastReceivedCount = this->dataPtr->receivedCount;
+    this->dataPtr->lastRateTime = std::chrono::steady_clock::now();
+  }
+
+  this->dataPtr->displayTimer->start(33);
+  if (this->dataPtr->echoing)
+    this->Subscribe();
+}
+
+/////////////////////////////////////////////////
+void TopicEcho::OnDeactivate()
+{
+  // Keep the echoed messages, but stop receiving new ones
+  this->dataPtr->displayTimer->stop();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto const &sub : this->dataPtr->node.SubscribedTopics())
+    this->dataPtr->node.Unsubscribe(sub);
+}
+
+/////////////////////////////////////////////////
+void TopicEcho::Subscribe()
+{
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Subscribe to new topic
   auto topic = this->dataPtr->topic.toStdString();
-  if (!this->dataPtr->node.Subscribe(topic, &TopicEcho::OnMessage, this))
+  if (!subscribeRaw(this->dataPtr->node, topic,
+      [this](const RawMessagePtr &_msg) {this->OnMessage(_msg);}))
   {
     ignerr << "Invalid topic [" << topic << "]" << std::endl;
   }
 }
 
 /////////////////////////////////////////////////
-void TopicEcho::OnMessage(const google::protobuf::Message &_msg)
+void TopicEcho::OnMessage(const RawMessagePtr &_msg)
 {
   if (this->dataPtr->paused)
     return;
 
+  // The message is only parsed if a view shows it
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  this->AddMsg(QString::fromStdString(_msg.DebugString()));
+  this->dataPtr->receivedCount++;
+  this->dataPtr->pending.push_back(_msg);
+  while (this->dataPtr->pending.size() > this->dataPtr->buffer)
+  {
+    this->dataPtr->pending.pop_front();
+    this->dataPtr->droppedCount++;
+  }
 }
 
 /////////////////////////////////////////////////
-void TopicEcho::OnAddMsg(QString _msg)
+void TopicEcho::UpdateList()
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  // Append msg to list
-  if (this->dataPtr->msgList.insertRow(this->dataPtr->msgList.rowCount()))
+  std::deque<RawMessagePtr> msgs;
+  size_t buffer;
+  bool statsChanged{false};
   {
-    auto index = this->dataPtr->msgList.index(
-        this->dataPtr->msgList.rowCount() - 1, 0);
-    this->dataPtr->msgList.setData(index, _msg);
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    msgs.swap(this->dataPtr->pending);
+    buffer = this->dataPtr->buffer;
+
+    // Update rate once per second
+    auto now = std::chrono::steady_clock::now();
+    double dt = std::chrono::duration<double>(
+        now - this->dataPtr->lastRateTime).count();
+    if (dt >= 1.0)
+    {
+      this->dataPtr->rate = (this->dataPtr->receivedCount -
+          this->dataPtr->lastReceivedCount) / dt;
+      this->dataPtr->lastReceivedCount = this->dataPtr->receivedCount;
+      this->dataPtr->lastRateTime = now;
+      statsChanged = true;
+    }
   }
 
-  // Remove items if the list is too long.
-  auto diff = this->dataPtr->msgList.rowCount() -
-      this->dataPtr->buffer;
-  this->dataPtr->msgList.removeRows(0, diff);
+  if (statsChanged)
+    this->StatsChanged();
+
+  // Append all new messages at once, this also trims the list if the buffer
+  // was made smaller
+  this->dataPtr->msgList.Append(msgs, buffer);
 }
 
 /////////////////////////////////////////////////
@@ -160,9 +255,30 @@ void TopicEcho::SetTopic(const QString &_topic)
 /////////////////////////////////////////////////
 void TopicEcho::OnBuffer(const unsigned int _buffer)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->buffer = _buffer;
 }
 
+/////////////////////////////////////////////////
+double TopicEcho::Rate() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->rate;
+}
+
+/////////////////////////////////////////////////
+int TopicEcho::DroppedCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<int>(this->dataPtr->droppedCount);
+}
+
+/////////////////////////////////////////////////
+TopicEchoModel *TopicEcho::Model() const
+{
+  return &this->dataPtr->msgList;
+}
+
 /////////////////////////////////////////////////
 bool TopicEcho::Paused() const
 {
@@ -18,17 +18,11 @@
 #ifndef IGNITION_GUI_PLUGINS_TOPICECHO_HH_
 #define IGNITION_GUI_PLUGINS_TOPICECHO_HH_
 
-#ifdef _MSC_VER
-#pragma warning(push, 0)
-#endif
-#include <google/protobuf/message.h>
-#ifdef _MSC_VER
-#pragma warning(pop)
-#endif
-
 #include <memory>
 
 #include "ignition/gui/Plugin.hh"
+#include "ignition/gui/RawMessage.hh"
+#include "TopicEchoModel.hh"
 
 namespace ignition
 {
@@ -40,9 +34,15 @@ namespace plugins
 
   /// \brief Echo messages coming through an Ignition transport topic.
   ///
+  /// Incoming messages are kept in a buffer and added to the list in batches
+  /// at display rate. Messages which are pushed out of the buffer before
+  /// being displayed are dropped. Messages are received serialized, and are
+  /// only parsed and converted to text when they're visible. A limited number
+  /// of those strings is cached.
+  ///
   /// ## Configuration
   /// This plugin doesn't accept any custom configuration.
-  class TopicEcho : public Plugin
+  class TopicEcho_EXPORTS_API TopicEcho : public Plugin
   {
     Q_OBJECT
 
@@ -62,6 +62,20 @@ namespace plugins
       NOTIFY PausedChanged
     )
 
+    /// \brief Incoming message rate in Hz
+    Q_PROPERTY(
+      double rate
+      READ Rate
+      NOTIFY StatsChanged
+    )
+
+    /// \brief Number of messages which were never displayed
+    Q_PROPERTY(
+      int droppedCount
+      READ DroppedCount
+      NOTIFY StatsChanged
+    )
+
     /// \brief Constructor
     public: TopicEcho();
 
@@ -71,6 +85,12 @@ namespace plugins
     // Documentation inherited
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem);
 
+    // Documentation inherited
+    protected: void OnActivate() override;
+
+    // Documentation inherited
+    protected: void OnDeactivate() override;
+
     /// \brief Get the topic as a string, for example
     /// '/echo'
     /// \return Topic
@@ -97,23 +117,38 @@ namespace plugins
     /// \brief Notify that paused has changed
     signals: void PausedChanged();
 
-    /// \brief Signal to add a message to the GUI list.
-    /// \param[in] _msg Text message to add.
-    signals: void AddMsg(QString _msg);
+    /// \brief Get the incoming message rate.
+    /// \return Rate in Hz, updated once per second.
+    public: Q_INVOKABLE double Rate() const;
 
-    /// \brief Receives incoming text messages.
-    /// \param[in] _msg New text message.
-    private: void OnMessage(const google::protobuf::Message &_msg);
+    /// \brief Get the number of messages which were received but never
+    /// displayed, because newer messages pushed them out of the buffer first.
+    /// \return Number of dropped messages.
+    public: Q_INVOKABLE int DroppedCount() const;
+
+    /// \brief Notify that the rate or dropped count have changed
+    signals: void StatsChanged();
+
+    /// \brief Get the list of displayed messages.
+    /// \return Pointer to the model.
+    public: TopicEchoModel *Model() const;
+
+    /// \brief Receives incoming serialized messages.
+    /// \param[in] _msg New message.
+    private: void OnMessage(const RawMessagePtr &_msg);
 
     /// \brief Clear list and unsubscribe.
     private: void Stop();
 
+    /// \brief Subscribe to the current topic.
+    private: void Subscribe();
+
     /// \brief Callback when echo button is pressed
     public slots: void OnEcho(const bool _checked);
 
-    /// \brief Callback from the ::AddMsg signal.
-    /// \param[in] _msg Message to add to the list.
-    private slots: void OnAddMsg(QString _msg);
+    /// \brief Add messages received since the last call to the list, in a
+    /// single batch. Called periodically on the main thread.
+    private slots: void UpdateList();
 
     /// \internal
     /// \brief Pointer to private data.
@@ -83,9 +83,16 @@ Rectangle {
       text: "Messages"
     }
 
+    Label {
+      id: statsLabel
+      font.pointSize: 8
+      text: TopicEcho.rate.toFixed(1) + " Hz, " + TopicEcho.droppedCount +
+            " not displayed"
+    }
+
     Rectangle {
       width: topicEcho.parent !== null ? topicEcho.parent.width - 20 : 50
-      height: topicEcho.parent !== null ? topicEcho.parent.height - 200 : 50
+      height: topicEcho.parent !== null ? topicEcho.parent.height - 220 : 50
       color: "transparent"
 
       ListView {
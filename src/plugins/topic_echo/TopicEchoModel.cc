@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <string>
+
+#include "TopicEchoModel.hh"
+
+using namespace ignition;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+int TopicEchoModel::rowCount(const QModelIndex &_parent) const
+{
+  if (_parent.isValid())
+    return 0;
+  return static_cast<int>(this->msgs.size());
+}
+
+/////////////////////////////////////////////////
+QVariant TopicEchoModel::data(const QModelIndex &_index, int _role) const
+{
+  if (_role != Qt::DisplayRole || !_index.isValid() ||
+      _index.row() >= this->rowCount())
+  {
+    return QVariant();
+  }
+
+  const auto &entry = this->msgs[_index.row()];
+
+  auto it = this->cacheIndex.find(entry.id);
+  if (it != this->cacheIndex.end())
+  {
+    // Mark as most recently used
+    this->cache.splice(this->cache.begin(), this->cache, it->second);
+    return it->second->second;
+  }
+
+  auto msg = entry.msg->Message();
+  auto text = msg ? QString::fromStdString(msg->DebugString()) :
+      QString::fromStdString("Unable to parse message of type [" +
+      entry.msg->Type() + "]");
+  this->cache.emplace_front(entry.id, text);
+  this->cacheIndex[entry.id] = this->cache.begin();
+  if (this->cache.size() > kCacheSize)
+  {
+    this->cacheIndex.erase(this->cache.back().first);
+    this->cache.pop_back();
+  }
+  return text;
+}
+
+/////////////////////////////////////////////////
+void TopicEchoModel::Append(const std::deque<RawMessagePtr> &_msgs,
+    size_t _max)
+{
+  // Only the newest messages would survive
+  size_t count = std::min(_msgs.size(), _max);
+  if (count > 0)
+  {
+    int first = this->rowCount();
+    this->beginInsertRows(QModelIndex(), first,
+        first + static_cast<int>(count) - 1);
+    for (size_t i = _msgs.size() - count; i < _msgs.size(); ++i)
+      this->msgs.push_back({_msgs[i], this->nextId++});
+    this->endInsertRows();
+  }
+
+  if (this->msgs.size() <= _max)
+    return;
+
+  auto diff = this->msgs.size() - _max;
+  this->beginRemoveRows(QModelIndex(), 0, static_cast<int>(diff) - 1);
+  for (size_t i = 0; i < diff; ++i)
+  {
+    auto it = this->cacheIndex.find(this->msgs.front().id);
+    if (it != this->cacheIndex.end())
+    {
+      this->cache.erase(it->second);
+      this->cacheIndex.erase(it);
+    }
+    this->msgs.pop_front();
+  }
+  this->endRemoveRows();
+}
+
+/////////////////////////////////////////////////
+void TopicEchoModel::Clear()
+{
+  this->beginResetModel();
+  this->msgs.clear();
+  this->cache.clear();
+  this->cacheIndex.clear();
+  this->endResetModel();
+}
+
+/////////////////////////////////////////////////
+size_t TopicEchoModel::CacheCount() const
+{
+  return this->cache.size();
+}
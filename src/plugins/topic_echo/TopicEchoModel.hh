@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_PLUGINS_TOPICECHOMODEL_HH_
+#define IGNITION_GUI_PLUGINS_TOPICECHOMODEL_HH_
+
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+#include "ignition/gui/qt.h"
+#include "ignition/gui/RawMessage.hh"
+
+#ifndef _WIN32
+#  define TopicEcho_EXPORTS_API
+#else
+#  if (defined(TopicEcho_EXPORTS))
+#    define TopicEcho_EXPORTS_API __declspec(dllexport)
+#  else
+#    define TopicEcho_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief List of echoed messages. Messages are kept serialized, and are
+  /// only parsed and converted to text when a view asks for a row. A bounded
+  /// number of those strings is cached, so memory is proportional to the
+  /// number of messages rather than to their text.
+  class TopicEcho_EXPORTS_API TopicEchoModel : public QAbstractListModel
+  {
+    /// \brief Maximum number of cached strings.
+    public: static constexpr size_t kCacheSize{64};
+
+    // Documentation inherited
+    public: int rowCount(const QModelIndex &_parent = QModelIndex()) const
+        override;
+
+    // Documentation inherited
+    public: QVariant data(const QModelIndex &_index, int _role) const
+        override;
+
+    /// \brief Append messages and remove the oldest ones so there are at
+    /// most _max rows, notifying views once for each.
+    /// \param[in] _msgs Messages to append, oldest first.
+    /// \param[in] _max Maximum number of rows.
+    public: void Append(const std::deque<RawMessagePtr> &_msgs, size_t _max);
+
+    /// \brief Remove all messages.
+    public: void Clear();
+
+    /// \brief Get the number of cached strings.
+    /// \return Number of strings, at most kCacheSize.
+    public: size_t CacheCount() const;
+
+    /// \brief A message and a unique ID, used as the cache key.
+    private: struct Entry
+    {
+      /// \brief Message.
+      RawMessagePtr msg;
+
+      /// \brief Unique ID.
+      uint64_t id;
+    };
+
+    /// \brief Displayed messages, oldest first.
+    private: std::deque<Entry> msgs;
+
+    /// \brief ID of the next appended message.
+    private: uint64_t nextId{0};
+
+    /// \brief Formatted messages, most recently used first.
+    private: mutable std::list<std::pair<uint64_t, QString>> cache;
+
+    /// \brief Cache entries by message ID.
+    private: mutable std::unordered_map<uint64_t,
+        std::list<std::pair<uint64_t, QString>>::iterator> cacheIndex;
+  };
+}
+}
+}
+
+#endif
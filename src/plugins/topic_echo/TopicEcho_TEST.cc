@@ -17,74 +17,208 @@
 
 #include <gtest/gtest.h>
 
-#include <ignition/msgs.hh>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <ignition/common/Console.hh>
+#include <ignition/msgs/stringmsg.pb.h>
 #include <ignition/transport/Node.hh>
+#include <ignition/utilities/ExtraTestMacros.hh>
 
-#include "ignition/gui/Iface.hh"
-#include "ignition/gui/Plugin.hh"
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
 #include "ignition/gui/MainWindow.hh"
+#include "ignition/gui/Plugin.hh"
+#include "TopicEcho.hh"
+#include "TopicEchoModel.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./TopicEcho_TEST")),
+};
 
 using namespace ignition;
 using namespace gui;
+using namespace plugins;
 
 /////////////////////////////////////////////////
-TEST(TopicEchoTest, Load)
+/// \brief Create a serialized string message.
+/// \param[in] _data Message data.
+/// \return Serialized message.
+RawMessagePtr stringMsg(const std::string &_data)
 {
-  EXPECT_TRUE(initApp());
-
-  EXPECT_TRUE(loadPlugin("TopicEcho"));
+  msgs::StringMsg msg;
+  msg.set_data(_data);
+  auto data = msg.SerializeAsString();
+  return std::make_shared<RawMessage>(data.data(), data.size(),
+      "ignition.msgs.StringMsg");
+}
 
-  EXPECT_TRUE(stop());
+/////////////////////////////////////////////////
+/// \brief Get the text of a row.
+/// \param[in] _model Model.
+/// \param[in] _row Row.
+/// \return Text of the row.
+std::string text(const QAbstractItemModel *_model, int _row)
+{
+  return _model->data(_model->index(_row, 0), Qt::DisplayRole).toString()
+      .toStdString();
 }
 
 /////////////////////////////////////////////////
-TEST(TopicEchoTest, Echo)
+/// \brief Process events until a condition is met or it times out.
+/// \param[in] _done Condition.
+/// \param[in] _maxSleep Maximum number of 10 ms sleeps.
+/// \return True if the condition was met.
+bool waitFor(const std::function<bool()> &_done, int _maxSleep = 100)
 {
-  setVerbosity(4);
-  EXPECT_TRUE(initApp());
+  for (int sleep = 0; !_done() && sleep < _maxSleep; ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+  }
+  return _done();
+}
 
-  // Load plugin
-  EXPECT_TRUE(loadPlugin("TopicEcho"));
+/////////////////////////////////////////////////
+TEST(TopicEchoTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(ModelAppend))
+{
+  TopicEchoModel model;
+  EXPECT_EQ(0, model.rowCount());
+
+  int inserts{0};
+  int removes{0};
+  QObject::connect(&model, &QAbstractItemModel::rowsInserted,
+      [&inserts]() {inserts++;});
+  QObject::connect(&model, &QAbstractItemModel::rowsRemoved,
+      [&removes]() {removes++;});
+
+  // Appended in order
+  model.Append({stringMsg("0"), stringMsg("1"), stringMsg("2")}, 10);
+  ASSERT_EQ(3, model.rowCount());
+  EXPECT_EQ("data: \"0\"\n", text(&model, 0));
+  EXPECT_EQ("data: \"2\"\n", text(&model, 2));
+  EXPECT_EQ(1, inserts);
+  EXPECT_EQ(0, removes);
+
+  // Oldest rows are removed, with a single notification
+  model.Append({stringMsg("3"), stringMsg("4")}, 4);
+  ASSERT_EQ(4, model.rowCount());
+  EXPECT_EQ("data: \"1\"\n", text(&model, 0));
+  EXPECT_EQ("data: \"4\"\n", text(&model, 3));
+  EXPECT_EQ(2, inserts);
+  EXPECT_EQ(1, removes);
+
+  // Only the newest of a batch larger than the maximum are inserted
+  int inserted{0};
+  QObject::connect(&model, &QAbstractItemModel::rowsInserted,
+      [&inserted](const QModelIndex &, int _first, int _last)
+      {
+        inserted = _last - _first + 1;
+      });
+  std::deque<RawMessagePtr> batch;
+  for (int i = 5; i < 15; ++i)
+    batch.push_back(stringMsg(std::to_string(i)));
+  model.Append(batch, 3);
+  ASSERT_EQ(3, model.rowCount());
+  EXPECT_EQ(3, inserted);
+  EXPECT_EQ("data: \"12\"\n", text(&model, 0));
+  EXPECT_EQ("data: \"14\"\n", text(&model, 2));
+
+  // Empty batch only trims
+  model.Append({}, 1);
+  ASSERT_EQ(1, model.rowCount());
+  EXPECT_EQ("data: \"14\"\n", text(&model, 0));
+
+  // Invalid requests
+  EXPECT_FALSE(model.data(model.index(5, 0), Qt::DisplayRole).isValid());
+  EXPECT_FALSE(model.data(model.index(0, 0), Qt::DecorationRole).isValid());
+
+  // Messages which can't be parsed
+  auto data = std::string("banana");
+  model.Append({std::make_shared<RawMessage>(data.data(), data.size(),
+      "banana.msg")}, 10);
+  ASSERT_EQ(2, model.rowCount());
+  EXPECT_EQ("Unable to parse message of type [banana.msg]",
+      text(&model, 1));
+
+  model.Clear();
+  EXPECT_EQ(0, model.rowCount());
+  EXPECT_EQ(0u, model.CacheCount());
+}
 
-  // Create main window
-  EXPECT_TRUE(createMainWindow());
-  auto win = mainWindow();
-  EXPECT_TRUE(win != nullptr);
+/////////////////////////////////////////////////
+TEST(TopicEchoTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(ModelCache))
+{
+  TopicEchoModel model;
+
+  int count = static_cast<int>(TopicEchoModel::kCacheSize) + 10;
+  std::deque<RawMessagePtr> msgs;
+  for (int i = 0; i < count; ++i)
+    msgs.push_back(stringMsg(std::to_string(i)));
+  model.Append(msgs, 1000);
+  ASSERT_EQ(count, model.rowCount());
+
+  // Nothing is formatted until it's requested
+  EXPECT_EQ(0u, model.CacheCount());
+
+  // The cache is bounded
+  for (int i = 0; i < count; ++i)
+    EXPECT_EQ("data: \"" + std::to_string(i) + "\"\n", text(&model, i));
+  EXPECT_EQ(TopicEchoModel::kCacheSize, model.CacheCount());
+
+  // Rows evicted from the cache are formatted again
+  EXPECT_EQ("data: \"0\"\n", text(&model, 0));
+  EXPECT_EQ("data: \"9\"\n", text(&model, 9));
+  EXPECT_EQ(TopicEchoModel::kCacheSize, model.CacheCount());
+
+  // Removed rows leave the cache
+  model.Append({}, 5);
+  ASSERT_EQ(5, model.rowCount());
+  EXPECT_EQ(5u, model.CacheCount());
+  EXPECT_EQ("data: \"" + std::to_string(count - 1) + "\"\n",
+      text(&model, 4));
+}
 
-  // Get plugin
-  auto plugins = win->findChildren<Plugin *>();
-  EXPECT_EQ(plugins.size(), 1);
-  auto plugin = plugins[0];
-  EXPECT_EQ(plugin->Title(), "Topic echo");
+/////////////////////////////////////////////////
+// See https://github.com/ignitionrobotics/ign-gui/issues/75
+TEST(TopicEchoTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Echo))
+{
+  common::Console::SetVerbosity(4);
 
-  // Widgets
-  auto echoButton = plugin->findChild<QPushButton *>("echoButton");
-  EXPECT_TRUE(echoButton != nullptr);
-  EXPECT_EQ(echoButton->text(), "Echo");
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
 
-  auto topicEdit = plugin->findChild<QLineEdit *>("topicEdit");
-  EXPECT_TRUE(topicEdit != nullptr);
-  EXPECT_EQ(topicEdit->text(), "/echo");
+  EXPECT_TRUE(app.LoadPlugin("TopicEcho"));
 
-  auto msgList = plugin->findChild<QListWidget *>("msgList");
-  EXPECT_TRUE(msgList != nullptr);
-  EXPECT_EQ(msgList->count(), 0);
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
 
-  auto bufferSpin = plugin->findChild<QSpinBox *>("bufferSpin");
-  EXPECT_TRUE(bufferSpin != nullptr);
-  EXPECT_EQ(bufferSpin->value(), 10);
+  // Get plugin
+  auto plugins = win->findChildren<TopicEcho *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+  EXPECT_EQ(plugin->Title(), "Topic echo");
+  EXPECT_EQ(plugin->Topic(), "/echo");
+  EXPECT_FALSE(plugin->Paused());
 
-  auto pauseCheck = plugin->findChild<QCheckBox *>("pauseCheck");
-  EXPECT_TRUE(pauseCheck != nullptr);
-  EXPECT_FALSE(pauseCheck->isChecked());
+  auto model = plugin->Model();
+  ASSERT_NE(nullptr, model);
+  EXPECT_EQ(0, model->rowCount());
 
   // Start echoing
-  echoButton->click();
-  EXPECT_EQ(echoButton->text(), "Stop echoing");
+  plugin->OnEcho(true);
 
   // Publish string
   transport::Node node;
   auto pub = node.Advertise<msgs::StringMsg>("/echo");
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
 
   {
     msgs::StringMsg msg;
@@ -92,59 +226,31 @@ TEST(TopicEchoTest, Echo)
     pub.Publish(msg);
   }
 
-  int sleep = 0;
-  int maxSleep = 30;
-  while (msgList->count() == 0 && sleep < maxSleep)
-  {
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    QCoreApplication::processEvents();
-    sleep++;
-  }
-
   // Check message was echoed
-  ASSERT_EQ(msgList->count(), 1);
-  EXPECT_EQ(msgList->item(0)->text(), QString("data: \"example string\"\n"))
-      << msgList->item(0)->text().toStdString();
+  EXPECT_TRUE(waitFor([&model]() {return model->rowCount() > 0;}));
+  ASSERT_EQ(1, model->rowCount());
+  EXPECT_EQ("data: \"example string\"\n", text(model, 0));
 
   // Publish more than buffer size (messages numbered 0 to 14)
-  for (auto i = 0; i < bufferSpin->value() + 5; ++i)
+  for (auto i = 0; i < 15; ++i)
   {
     msgs::StringMsg msg;
     msg.set_data("many messages: " + std::to_string(i));
     pub.Publish(msg);
   }
 
-  // Wait until all 15 messages are received
-  // To avoid flakiness due to messages coming out of order, we check for both
-  // 13 and 14. There's a chance a lower number comes afterwards, but that's
-  // just bad luck.
-  sleep = 0;
-  while (msgList->findItems(QString::number(13), Qt::MatchContains).count() == 0
-      && msgList->findItems(QString::number(14), Qt::MatchContains).count() == 0
-      && sleep < maxSleep)
+  // Wait until the last message is listed
+  EXPECT_TRUE(waitFor([&model]()
   {
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    QCoreApplication::processEvents();
-    sleep++;
-  }
-  EXPECT_LT(sleep, maxSleep);
+    return model->rowCount() > 0 &&
+        text(model, model->rowCount() - 1).find("14") != std::string::npos;
+  }));
 
   // Check we have only 10 messages listed
-  ASSERT_EQ(msgList->count(), 10);
-
-  // We can't guarantee the order of messages
-  // We expect that out of the 10 messages last, at least 6 belong to the [5-14]
-  // range
-  unsigned int count = 0;
-  for (auto i = 5; i < 15; ++i)
-  {
-    if (msgList->findItems(QString::number(i), Qt::MatchContains).count() > 0)
-      count++;
-  }
-  EXPECT_GE(count, 6u);
+  EXPECT_EQ(10, model->rowCount());
 
   // Increase buffer
-  bufferSpin->setValue(20);
+  plugin->OnBuffer(20);
 
   // Publish another message and now it fits
   {
@@ -153,23 +259,13 @@ TEST(TopicEchoTest, Echo)
     pub.Publish(msg);
   }
 
-  sleep = 0;
-  while (msgList->count() < 11 && sleep < maxSleep)
-  {
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    QCoreApplication::processEvents();
-    sleep++;
-  }
-
-  // We have 11 messages
-  ASSERT_EQ(msgList->count(), 11);
-
-  // The last one is guaranteed to be the new message
-  EXPECT_EQ(msgList->item(10)->text(), QString("data: \"new message\"\n"))
-      << msgList->item(10)->text().toStdString();
+  EXPECT_TRUE(waitFor([&model]() {return model->rowCount() >= 11;}));
+  ASSERT_EQ(11, model->rowCount());
+  EXPECT_EQ("data: \"new message\"\n", text(model, 10));
 
   // Pause
-  pauseCheck->click();
+  plugin->SetPaused(true);
+  EXPECT_TRUE(plugin->Paused());
 
   // Publish another message and it is not received
   {
@@ -178,62 +274,99 @@ TEST(TopicEchoTest, Echo)
     pub.Publish(msg);
   }
 
-  sleep = 0;
-  while (msgList->count() < 11 && sleep < maxSleep)
-  {
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    QCoreApplication::processEvents();
-    sleep++;
-  }
+  EXPECT_FALSE(waitFor([&model]() {return model->rowCount() > 11;}));
+  ASSERT_EQ(11, model->rowCount());
+  EXPECT_EQ("data: \"new message\"\n", text(model, 10));
 
-  ASSERT_EQ(msgList->count(), 11);
-  EXPECT_EQ(msgList->item(10)->text(), QString("data: \"new message\"\n"))
-      << msgList->item(10)->text().toStdString();
-
-  // Decrease buffer
-  bufferSpin->setValue(5);
-
-  // Check we have less messages
-  ASSERT_EQ(msgList->count(), 5);
+  // Decrease buffer, the list is trimmed on its next update
+  plugin->OnBuffer(5);
+  EXPECT_TRUE(waitFor([&model]() {return model->rowCount() == 5;}));
 
   // The last message is still the new one
-  EXPECT_EQ(msgList->item(4)->text(), QString("data: \"new message\"\n"))
-      << msgList->item(4)->text().toStdString();
+  EXPECT_EQ("data: \"new message\"\n", text(model, 4));
 
   // Stop echoing
-  echoButton->click();
-  EXPECT_EQ(echoButton->text(), "Echo");
-  ASSERT_EQ(msgList->count(), 0);
+  plugin->OnEcho(false);
+  EXPECT_EQ(0, model->rowCount());
 
-  sleep = 0;
-  while (msgList->count() == 0 && sleep < maxSleep)
+  plugin->SetPaused(false);
   {
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    QCoreApplication::processEvents();
-    sleep++;
+    msgs::StringMsg msg;
+    msg.set_data("not echoed");
+    pub.Publish(msg);
   }
+  EXPECT_FALSE(waitFor([&model]() {return model->rowCount() > 0;}));
+}
 
-  ASSERT_EQ(msgList->count(), 0);
+/////////////////////////////////////////////////
+// See https://github.com/ignitionrobotics/ign-gui/issues/75
+TEST(TopicEchoTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Batch))
+{
+  common::Console::SetVerbosity(4);
 
-  // Start echoing again
-  echoButton->click();
-  EXPECT_EQ(echoButton->text(), "Stop echoing");
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
 
-  // Stop echoing by editing topic
-  topicEdit->setText("/another_topic");
-  EXPECT_EQ(echoButton->text(), "Echo");
-  ASSERT_EQ(msgList->count(), 0);
+  EXPECT_TRUE(app.LoadPlugin("TopicEcho"));
 
-  sleep = 0;
-  while (msgList->count() == 0 && sleep < maxSleep)
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto plugins = win->findChildren<TopicEcho *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+  auto model = plugin->Model();
+
+  int statsChanges{0};
+  plugin->connect(plugin, &TopicEcho::StatsChanged,
+      [&statsChanges]() {statsChanges++;});
+
+  plugin->OnBuffer(5);
+  plugin->OnEcho(true);
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::StringMsg>("/echo");
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  for (auto i = 0; i < 8; ++i)
   {
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    QCoreApplication::processEvents();
-    sleep++;
+    msgs::StringMsg msg;
+    msg.set_data(std::to_string(i));
+    pub.Publish(msg);
   }
 
-  ASSERT_EQ(msgList->count(), 0);
-
-  EXPECT_TRUE(stop());
+  // Without the event loop, received messages wait in the bounded buffer,
+  // which drops the oldest ones
+  for (int sleep = 0; plugin->DroppedCount() < 3 && sleep < 100; ++sleep)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(3, plugin->DroppedCount());
+  EXPECT_EQ(0, model->rowCount());
+
+  // They're listed together on the next update
+  int inserts{0};
+  model->connect(model, &QAbstractItemModel::rowsInserted,
+      [&inserts]() {inserts++;});
+  EXPECT_TRUE(waitFor([&model]() {return model->rowCount() > 0;}));
+  EXPECT_EQ(5, model->rowCount());
+  EXPECT_EQ(1, inserts);
+  EXPECT_EQ(3, plugin->DroppedCount());
+
+  // The rate is updated once per second
+  EXPECT_TRUE(waitFor([&statsChanges]() {return statsChanges > 0;}, 300));
+  EXPECT_GT(plugin->Rate(), 0.0);
+  EXPECT_LE(plugin->Rate(), 8.0);
+
+  // And drops to zero without messages
+  EXPECT_TRUE(waitFor([&statsChanges]() {return statsChanges > 1;}, 300));
+  EXPECT_DOUBLE_EQ(0.0, plugin->Rate());
+
+  // Paused messages aren't counted
+  plugin->SetPaused(true);
+  for (auto i = 0; i < 8; ++i)
+  {
+    msgs::StringMsg msg;
+    msg.set_data(std::to_string(i));
+    pub.Publish(msg);
+  }
+  EXPECT_FALSE(waitFor([&model]() {return model->rowCount() > 5;}));
+  EXPECT_EQ(3, plugin->DroppedCount());
 }
-
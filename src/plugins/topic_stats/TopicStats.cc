@@ -0,0 +1,391 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/plugin/Register.hh>
+#include <ignition/transport/MessageInfo.hh>
+#include <ignition/transport/Node.hh>
+
+#include "ignition/gui/Application.hh"
+
+#include "../topic_viewer/TopicList.hh"
+#include "TopicStats.hh"
+#include "WindowStats.hh"
+
+#define NAME_ROLE 51
+#define TYPE_ROLE 52
+#define MONITORED_ROLE 53
+#define RATE_ROLE 54
+#define BANDWIDTH_ROLE 55
+#define SIZE_ROLE 56
+#define JITTER_ROLE 57
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Model with one row per topic
+  class TopicStatsModel : public QStandardItemModel
+  {
+    /// \brief roles and names of the model
+    public: QHash<int, QByteArray> roleNames() const override
+    {
+      QHash<int, QByteArray> roles;
+      roles[NAME_ROLE] = "name";
+      roles[TYPE_ROLE] = "type";
+      roles[MONITORED_ROLE] = "monitored";
+      roles[RATE_ROLE] = "rate";
+      roles[BANDWIDTH_ROLE] = "bandwidth";
+      roles[SIZE_ROLE] = "size";
+      roles[JITTER_ROLE] = "jitter";
+      return roles;
+    }
+  };
+
+  /// \brief Statistics of a monitored topic, updated from transport threads
+  struct MonitoredTopic
+  {
+    /// \brief Protects stats
+    std::mutex mutex;
+
+    /// \brief Sliding window statistics
+    WindowStats stats;
+  };
+
+  class TopicStatsPrivate
+  {
+    /// \brief Subscribe to a topic and start computing its statistics.
+    /// \param[in] _topic Topic name.
+    /// \return True if subscribed.
+    public: bool Monitor(const std::string &_topic);
+
+    /// \brief Unsubscribe from a topic.
+    /// \param[in] _topic Topic name.
+    public: void Unmonitor(const std::string &_topic);
+
+    /// \brief Add and remove topics which changed since the last update.
+    public: void UpdateTopics();
+
+    /// \brief Remove the item of a topic, if there's one.
+    /// \param[in] _topic Topic name.
+    public: void RemoveItem(const std::string &_topic);
+
+    /// \brief Get the item of a topic, adding it if needed.
+    /// \param[in] _topic Topic name.
+    /// \param[in] _type Message type.
+    /// \return The item.
+    public: QStandardItem *Item(const std::string &_topic,
+                                const std::string &_type);
+
+    /// \brief Node for communication
+    public: transport::Node node;
+
+    /// \brief Model with all topics
+    public: TopicStatsModel *model{nullptr};
+
+    /// \brief Item of each topic, by name
+    public: std::unordered_map<std::string, QStandardItem *> items;
+
+    /// \brief Monitored topics, by name. Shared with the subscription
+    /// callbacks, which may still be running after unsubscribing.
+    public: std::unordered_map<std::string,
+        std::shared_ptr<MonitoredTopic>> monitored;
+
+    /// \brief Topics and message types at the last update.
+    public: TopicList topicList;
+
+    /// \brief Length of the sliding window
+    public: std::chrono::steady_clock::duration window{
+        std::chrono::seconds(1)};
+
+    /// \brief Timer to update the topics and statistics
+    public: QTimer *timer{nullptr};
+  };
+}
+}
+}
+
+using namespace ignition;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Format a number of bytes with a binary unit prefix.
+/// \param[in] _bytes Number of bytes.
+/// \return Formatted string, such as "1.50 KB".
+static std::string FormatBytes(double _bytes)
+{
+  const char *units[] = {"B", "KB", "MB", "GB"};
+  int unit = 0;
+  while (_bytes >= 1024.0 && unit < 3)
+  {
+    _bytes /= 1024.0;
+    ++unit;
+  }
+
+  std::ostringstream stream;
+  stream << std::fixed << std::setprecision(unit == 0 ? 0 : 2) << _bytes
+         << " " << units[unit];
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+bool TopicStatsPrivate::Monitor(const std::string &_topic)
+{
+  if (this->monitored.count(_topic))
+    return true;
+
+  auto data = std::make_shared<MonitoredTopic>();
+  data->stats = WindowStats(this->window);
+
+  // Only the size and arrival time are needed, the payload is never parsed
+  auto cb = [data](const char *, const size_t _size,
+      const transport::MessageInfo &)
+  {
+    auto now = WindowStats::Clock::now();
+    std::lock_guard<std::mutex> lock(data->mutex);
+    data->stats.Add(now, _size);
+  };
+
+  if (!this->node.SubscribeRaw(_topic, cb))
+  {
+    ignerr << "Failed to subscribe to topic [" << _topic << "]" << std::endl;
+    return false;
+  }
+
+  this->monitored[_topic] = std::move(data);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TopicStatsPrivate::Unmonitor(const std::string &_topic)
+{
+  auto it = this->monitored.find(_topic);
+  if (it == this->monitored.end())
+    return;
+
+  // A callback may still be running, it keeps its own reference to the data
+  this->node.Unsubscribe(_topic);
+  this->monitored.erase(it);
+}
+
+/////////////////////////////////////////////////
+QStandardItem *TopicStatsPrivate::Item(const std::string &_topic,
+    const std::string &_type)
+{
+  auto it = this->items.find(_topic);
+  if (it != this->items.end())
+    return it->second;
+
+  auto item = new QStandardItem(QString::fromStdString(_topic));
+  item->setData(QString::fromStdString(_topic), NAME_ROLE);
+  item->setData(QString::fromStdString(_type), TYPE_ROLE);
+  item->setData(this->monitored.count(_topic) > 0, MONITORED_ROLE);
+  this->model->invisibleRootItem()->appendRow(item);
+  this->items[_topic] = item;
+  return item;
+}
+
+/////////////////////////////////////////////////
+void TopicStatsPrivate::RemoveItem(const std::string &_topic)
+{
+  auto it = this->items.find(_topic);
+  if (it == this->items.end())
+    return;
+
+  this->model->invisibleRootItem()->removeRow(it->second->row());
+  this->items.erase(it);
+}
+
+/////////////////////////////////////////////////
+void TopicStatsPrivate::UpdateTopics()
+{
+  this->topicList.Update(this->node,
+      [this](const std::string &_topic, const std::string &_type)
+      {
+        auto it = this->items.find(_topic);
+        if (it != this->items.end())
+          it->second->setData(QString::fromStdString(_type), TYPE_ROLE);
+        else
+          this->Item(_topic, _type);
+      },
+      [this](const std::string &_topic)
+      {
+        // Monitored topics are kept, they may come back
+        if (!this->monitored.count(_topic))
+          this->RemoveItem(_topic);
+      });
+}
+
+/////////////////////////////////////////////////
+TopicStats::TopicStats()
+  : Plugin(), dataPtr(new TopicStatsPrivate)
+{
+  this->dataPtr->model = new TopicStatsModel();
+  this->dataPtr->model->setParent(this);
+
+  App()->Engine()->rootContext()->setContextProperty("TopicStatsModel",
+      this->dataPtr->model);
+
+  this->dataPtr->timer = new QTimer(this);
+  this->connect(this->dataPtr->timer, &QTimer::timeout,
+      this, &TopicStats::Update);
+}
+
+/////////////////////////////////////////////////
+TopicStats::~TopicStats()
+{
+  for (const auto &topic : this->dataPtr->node.SubscribedTopics())
+    this->dataPtr->node.Unsubscribe(topic);
+}
+
+/////////////////////////////////////////////////
+void TopicStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Topic stats";
+
+  // Only start once loaded, which lazy plugins defer until they're shown
+  this->dataPtr->timer->start(500);
+
+  if (_pluginElem)
+  {
+    double window{1.0};
+    if (auto windowElem = _pluginElem->FirstChildElement("window"))
+      windowElem->QueryDoubleText(&window);
+    if (window > 0.0)
+    {
+      this->dataPtr->window = std::chrono::duration_cast<
+          std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(window));
+    }
+
+    for (auto topicElem = _pluginElem->FirstChildElement("topic");
+         topicElem != nullptr;
+         topicElem = topicElem->NextSiblingElement("topic"))
+    {
+      if (nullptr == topicElem->GetText())
+        continue;
+      this->OnMonitor(QString(topicElem->GetText()), true);
+    }
+  }
+
+  this->Update();
+}
+
+/////////////////////////////////////////////////
+void TopicStats::OnActivate()
+{
+  this->Update();
+  this->dataPtr->timer->start(500);
+}
+
+/////////////////////////////////////////////////
+void TopicStats::OnDeactivate()
+{
+  // Statistics keep being computed, they're only displayed while active
+  this->dataPtr->timer->stop();
+}
+
+/////////////////////////////////////////////////
+QStandardItemModel *TopicStats::Model()
+{
+  return this->dataPtr->model;
+}
+
+/////////////////////////////////////////////////
+void TopicStats::OnMonitor(const QString &_topic, const bool _monitor)
+{
+  auto topic = _topic.toStdString();
+
+  if (_monitor)
+  {
+    if (!this->dataPtr->Monitor(topic))
+      return;
+  }
+  else
+  {
+    this->dataPtr->Unmonitor(topic);
+
+    // Topics which are gone were only kept while monitored
+    if (!this->dataPtr->topicList.Types().count(topic))
+    {
+      this->dataPtr->RemoveItem(topic);
+      return;
+    }
+  }
+
+  auto item = this->dataPtr->Item(topic, "");
+  item->setData(_monitor, MONITORED_ROLE);
+  if (!_monitor)
+  {
+    item->setData(QVariant(), RATE_ROLE);
+    item->setData(QVariant(), BANDWIDTH_ROLE);
+    item->setData(QVariant(), SIZE_ROLE);
+    item->setData(QVariant(), JITTER_ROLE);
+  }
+}
+
+/////////////////////////////////////////////////
+void TopicStats::Update()
+{
+  this->dataPtr->UpdateTopics();
+
+  auto now = WindowStats::Clock::now();
+  for (const auto &monitored : this->dataPtr->monitored)
+  {
+    WindowStatsResult stats;
+    {
+      std::lock_guard<std::mutex> lock(monitored.second->mutex);
+      stats = monitored.second->stats.Stats(now);
+    }
+
+    auto item = this->dataPtr->Item(monitored.first, "");
+
+    std::ostringstream rate;
+    rate << std::fixed << std::setprecision(1) << stats.rate << " Hz";
+    item->setData(QString::fromStdString(rate.str()), RATE_ROLE);
+
+    item->setData(QString::fromStdString(
+        FormatBytes(stats.bandwidth) + "/s"), BANDWIDTH_ROLE);
+
+    item->setData(QString::fromStdString(
+        FormatBytes(static_cast<double>(stats.minSize)) + " / " +
+        FormatBytes(stats.meanSize) + " / " +
+        FormatBytes(static_cast<double>(stats.maxSize))), SIZE_ROLE);
+
+    std::ostringstream jitter;
+    jitter << std::fixed << std::setprecision(3)
+           << stats.jitter * 1000.0 << " ms";
+    item->setData(QString::fromStdString(jitter.str()), JITTER_ROLE);
+  }
+}
+
+// Register this plugin
+IGNITION_ADD_PLUGIN(ignition::gui::plugins::TopicStats,
+                    ignition::gui::Plugin)
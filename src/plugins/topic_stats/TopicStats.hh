@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_PLUGINS_TOPICSTATS_HH_
+#define IGNITION_GUI_PLUGINS_TOPICSTATS_HH_
+
+#include <memory>
+
+#include "ignition/gui/Plugin.hh"
+
+#ifndef _WIN32
+#  define TopicStats_EXPORTS_API
+#else
+#  if (defined(TopicStats_EXPORTS))
+#    define TopicStats_EXPORTS_API __declspec(dllexport)
+#  else
+#    define TopicStats_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  class TopicStatsPrivate;
+
+  /// \brief Monitor the rate, bandwidth, message sizes and inter-arrival
+  /// jitter of transport topics, similar to `ign topic -f`.
+  ///
+  /// All topics are listed, and the ones which are checked are subscribed
+  /// to with raw callbacks, so messages are never deserialized and many
+  /// high-rate topics can be watched at once. Statistics are computed over a
+  /// sliding window using constant memory per topic.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<topic\> : Topic to monitor from the start, can be repeated.
+  /// * \<window\> : Length of the sliding window in seconds, defaults to 1.
+  class TopicStats_EXPORTS_API TopicStats : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Constructor
+    public: TopicStats();
+
+    /// \brief Destructor
+    public: ~TopicStats() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
+
+    // Documentation inherited
+    protected: void OnActivate() override;
+
+    // Documentation inherited
+    protected: void OnDeactivate() override;
+
+    /// \brief Get the model with one row per topic
+    /// \return Pointer to the model
+    public: QStandardItemModel *Model();
+
+    /// \brief Start or stop monitoring a topic.
+    /// \param[in] _topic Topic name.
+    /// \param[in] _monitor True to monitor.
+    public slots: void OnMonitor(const QString &_topic, const bool _monitor);
+
+    /// \brief Update the topic list and the statistics of monitored topics.
+    public slots: void Update();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<TopicStatsPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.2
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: topicStats
+  objectName: "topicStats"
+  Layout.minimumWidth: 350
+  Layout.minimumHeight: 300
+  color: "transparent"
+
+  ListView {
+    id: listView
+    anchors.fill: parent
+    anchors.margins: 10
+    clip: true
+    model: TopicStatsModel
+
+    delegate: Column {
+      width: listView.width
+
+      CheckBox {
+        text: model.name
+        checked: model.monitored
+        onToggled: {
+          TopicStats.OnMonitor(model.name, checked)
+        }
+        ToolTip.visible: hovered && model.type !== ""
+        ToolTip.delay: 500
+        ToolTip.text: model.type
+      }
+
+      GridLayout {
+        visible: model.monitored
+        columns: 2
+        columnSpacing: 10
+        x: 30
+
+        Label { text: "Rate"; font.pointSize: 8 }
+        Label { text: model.rate !== undefined ? model.rate : ""; font.pointSize: 8 }
+
+        Label { text: "Bandwidth"; font.pointSize: 8 }
+        Label { text: model.bandwidth !== undefined ? model.bandwidth : ""; font.pointSize: 8 }
+
+        Label { text: "Size (min / mean / max)"; font.pointSize: 8 }
+        Label { text: model.size !== undefined ? model.size : ""; font.pointSize: 8 }
+
+        Label { text: "Jitter"; font.pointSize: 8 }
+        Label { text: model.jitter !== undefined ? model.jitter : ""; font.pointSize: 8 }
+      }
+    }
+
+    ScrollIndicator.vertical: ScrollIndicator {
+      active: true
+    }
+  }
+}
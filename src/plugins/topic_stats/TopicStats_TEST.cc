@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <ignition/msgs/stringmsg.pb.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+#include <ignition/common/Console.hh>
+#include <ignition/transport/Node.hh>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/Plugin.hh"
+#include "ignition/gui/MainWindow.hh"
+
+#include "TopicStats.hh"
+
+#define NAME_ROLE 51
+#define MONITORED_ROLE 53
+#define RATE_ROLE 54
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./TopicStats_TEST")),
+};
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(TopicStatsTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Load))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  EXPECT_TRUE(app.LoadPlugin("TopicStats"));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Get plugin
+  auto plugins = win->findChildren<Plugin *>();
+  EXPECT_EQ(plugins.size(), 1);
+
+  auto plugin = plugins[0];
+  EXPECT_EQ(plugin->Title(), "Topic stats");
+
+  // Cleanup
+  plugins.clear();
+}
+
+/////////////////////////////////////////////////
+TEST(TopicStatsTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Monitor))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const char *pluginStr =
+    "<plugin filename=\"TopicStats\">"
+      "<topic>/stats_topic</topic>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("TopicStats",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  auto plugins = win->findChildren<plugins::TopicStats *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  // Topic from config is monitored
+  auto model = plugin->Model();
+  ASSERT_NE(nullptr, model);
+  auto items = model->findItems("/stats_topic");
+  ASSERT_EQ(1, items.size());
+  EXPECT_TRUE(items[0]->data(MONITORED_ROLE).toBool());
+
+  // Publish
+  transport::Node node;
+  auto pub = node.Advertise<msgs::StringMsg>("/stats_topic");
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  msgs::StringMsg msg;
+  msg.set_data("hello");
+  for (int i = 0; i < 50; ++i)
+  {
+    pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  QCoreApplication::processEvents();
+  plugin->Update();
+
+  auto rate = items[0]->data(RATE_ROLE).toString();
+  EXPECT_FALSE(rate.isEmpty());
+  EXPECT_NE("0.0 Hz", rate);
+
+  // Stop monitoring
+  plugin->OnMonitor("/stats_topic", false);
+  EXPECT_FALSE(items[0]->data(MONITORED_ROLE).toBool());
+  EXPECT_TRUE(items[0]->data(RATE_ROLE).toString().isEmpty());
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "WindowStats.hh"
+
+using namespace ignition;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+WindowStats::WindowStats(Clock::duration _window, unsigned int _buckets)
+{
+  _buckets = std::max(1u, _buckets);
+  this->bucketLength = std::max(Clock::duration(1), _window / _buckets);
+  this->buckets.resize(_buckets);
+}
+
+/////////////////////////////////////////////////
+int64_t WindowStats::BucketIndex(Clock::time_point _time) const
+{
+  return _time.time_since_epoch() / this->bucketLength;
+}
+
+/////////////////////////////////////////////////
+void WindowStats::Add(Clock::time_point _time, size_t _size)
+{
+  auto index = this->BucketIndex(_time);
+  auto &bucket = this->buckets[index % this->buckets.size()];
+
+  // Reuse a bucket which has left the window
+  if (bucket.index != index)
+  {
+    bucket = Bucket();
+    bucket.index = index;
+    bucket.minSize = _size;
+    bucket.maxSize = _size;
+  }
+
+  bucket.count++;
+  bucket.bytes += _size;
+  bucket.minSize = std::min(bucket.minSize, _size);
+  bucket.maxSize = std::max(bucket.maxSize, _size);
+
+  if (this->started)
+  {
+    double interval =
+        std::chrono::duration<double>(_time - this->lastTime).count();
+    bucket.intervals++;
+    bucket.intervalSum += interval;
+    bucket.intervalSqSum += interval * interval;
+  }
+  else
+  {
+    this->firstTime = _time;
+    this->started = true;
+  }
+  this->lastTime = _time;
+}
+
+/////////////////////////////////////////////////
+WindowStatsResult WindowStats::Stats(Clock::time_point _now) const
+{
+  WindowStatsResult result;
+  if (!this->started)
+    return result;
+
+  auto last = this->BucketIndex(_now);
+  auto first = last - static_cast<int64_t>(this->buckets.size()) + 1;
+
+  uint64_t bytes{0};
+  uint64_t intervals{0};
+  double intervalSum{0.0};
+  double intervalSqSum{0.0};
+  result.minSize = std::numeric_limits<size_t>::max();
+  for (const auto &bucket : this->buckets)
+  {
+    if (bucket.index < first || bucket.index > last || bucket.count == 0)
+      continue;
+
+    result.count += bucket.count;
+    bytes += bucket.bytes;
+    result.minSize = std::min(result.minSize, bucket.minSize);
+    result.maxSize = std::max(result.maxSize, bucket.maxSize);
+    intervals += bucket.intervals;
+    intervalSum += bucket.intervalSum;
+    intervalSqSum += bucket.intervalSqSum;
+  }
+
+  if (result.count == 0)
+  {
+    result.minSize = 0;
+    return result;
+  }
+
+  result.meanSize = static_cast<double>(bytes) / result.count;
+
+  if (intervals > 0)
+  {
+    result.meanInterval = intervalSum / intervals;
+    double variance = intervalSqSum / intervals -
+        result.meanInterval * result.meanInterval;
+    result.jitter = std::sqrt(std::max(0.0, variance));
+  }
+
+  // The window spans the complete buckets plus the elapsed part of the
+  // current one. Until the first message leaves the window, estimate the
+  // rate from the intervals instead.
+  auto windowStart = Clock::time_point(first * this->bucketLength);
+  if (windowStart >= this->firstTime)
+  {
+    auto span = std::chrono::duration<double>(_now - windowStart).count();
+    result.rate = result.count / span;
+  }
+  else if (result.meanInterval > 0.0)
+  {
+    result.rate = 1.0 / result.meanInterval;
+  }
+  result.bandwidth = result.rate * result.meanSize;
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+void WindowStats::Reset()
+{
+  for (auto &bucket : this->buckets)
+    bucket = Bucket();
+  this->started = false;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_PLUGINS_WINDOWSTATS_HH_
+#define IGNITION_GUI_PLUGINS_WINDOWSTATS_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Statistics of the messages received during a time window.
+  struct WindowStatsResult
+  {
+    /// \brief Number of messages.
+    uint64_t count{0};
+
+    /// \brief Message rate in Hz.
+    double rate{0.0};
+
+    /// \brief Bandwidth in bytes per second.
+    double bandwidth{0.0};
+
+    /// \brief Smallest message size in bytes.
+    size_t minSize{0};
+
+    /// \brief Average message size in bytes.
+    double meanSize{0.0};
+
+    /// \brief Largest message size in bytes.
+    size_t maxSize{0};
+
+    /// \brief Average time between messages in seconds.
+    double meanInterval{0.0};
+
+    /// \brief Standard deviation of the time between messages in seconds.
+    double jitter{0.0};
+  };
+
+  /// \brief Sliding window estimator of the rate, bandwidth, message sizes
+  /// and inter-arrival jitter of a stream of messages.
+  ///
+  /// The window is split into a fixed number of buckets which are reused as
+  /// time passes, so memory is constant regardless of the message rate and
+  /// adding a message is constant time. This class isn't thread safe.
+  class WindowStats
+  {
+    /// \brief Clock used for message times.
+    public: using Clock = std::chrono::steady_clock;
+
+    /// \brief Constructor
+    /// \param[in] _window Length of the window.
+    /// \param[in] _buckets Number of buckets the window is split into. More
+    /// buckets make the window slide more smoothly.
+    public: explicit WindowStats(
+        Clock::duration _window = std::chrono::seconds(1),
+        unsigned int _buckets = 10);
+
+    /// \brief Add a message.
+    /// \param[in] _time Time the message was received. Times must not
+    /// decrease.
+    /// \param[in] _size Message size in bytes.
+    public: void Add(Clock::time_point _time, size_t _size);
+
+    /// \brief Get statistics for the window ending at a given time.
+    /// \param[in] _now End of the window.
+    /// \return Statistics of the messages inside the window.
+    public: WindowStatsResult Stats(Clock::time_point _now) const;
+
+    /// \brief Remove all messages.
+    public: void Reset();
+
+    /// \brief Messages received during one bucket.
+    private: struct Bucket
+    {
+      /// \brief Absolute bucket number, -1 if unused.
+      int64_t index{-1};
+
+      /// \brief Number of messages.
+      uint64_t count{0};
+
+      /// \brief Total size in bytes.
+      uint64_t bytes{0};
+
+      /// \brief Smallest message size.
+      size_t minSize{0};
+
+      /// \brief Largest message size.
+      size_t maxSize{0};
+
+      /// \brief Number of intervals between messages.
+      uint64_t intervals{0};
+
+      /// \brief Sum of the intervals in seconds.
+      double intervalSum{0.0};
+
+      /// \brief Sum of the squared intervals.
+      double intervalSqSum{0.0};
+    };
+
+    /// \brief Get the absolute bucket number of a time.
+    /// \param[in] _time Time.
+    /// \return Bucket number.
+    private: int64_t BucketIndex(Clock::time_point _time) const;
+
+    /// \brief Length of each bucket.
+    private: Clock::duration bucketLength;
+
+    /// \brief Buckets, used as a ring.
+    private: std::vector<Bucket> buckets;
+
+    /// \brief Time of the first message.
+    private: Clock::time_point firstTime;
+
+    /// \brief Time of the last message.
+    private: Clock::time_point lastTime;
+
+    /// \brief True once a message was added.
+    private: bool started{false};
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "WindowStats.hh"
+
+using namespace ignition;
+using namespace gui;
+using namespace plugins;
+
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(WindowStatsTest, Empty)
+{
+  WindowStats stats;
+  auto result = stats.Stats(WindowStats::Clock::now());
+  EXPECT_EQ(0u, result.count);
+  EXPECT_DOUBLE_EQ(0.0, result.rate);
+  EXPECT_DOUBLE_EQ(0.0, result.bandwidth);
+  EXPECT_EQ(0u, result.minSize);
+  EXPECT_EQ(0u, result.maxSize);
+}
+
+/////////////////////////////////////////////////
+TEST(WindowStatsTest, SteadyRate)
+{
+  WindowStats stats(1s, 10);
+  auto start = WindowStats::Clock::now();
+
+  // 1 kHz for 3 seconds, alternating sizes
+  for (int i = 0; i < 3000; ++i)
+    stats.Add(start + std::chrono::milliseconds(i), i % 2 == 0 ? 100 : 200);
+
+  auto result = stats.Stats(start + 3s);
+  EXPECT_NEAR(1000.0, result.rate, 20.0);
+  EXPECT_NEAR(150000.0, result.bandwidth, 3000.0);
+  EXPECT_EQ(100u, result.minSize);
+  EXPECT_EQ(200u, result.maxSize);
+  EXPECT_NEAR(150.0, result.meanSize, 1.0);
+  EXPECT_NEAR(0.001, result.meanInterval, 1e-6);
+  EXPECT_NEAR(0.0, result.jitter, 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST(WindowStatsTest, Jitter)
+{
+  WindowStats stats(1s, 10);
+  auto start = WindowStats::Clock::now();
+
+  // Intervals alternate between 5 ms and 15 ms
+  auto time = start;
+  for (int i = 0; i < 200; ++i)
+  {
+    time += i % 2 == 0 ? 5ms : 15ms;
+    stats.Add(time, 10);
+  }
+
+  auto result = stats.Stats(time);
+  EXPECT_NEAR(100.0, result.rate, 5.0);
+  EXPECT_NEAR(0.010, result.meanInterval, 1e-4);
+  EXPECT_NEAR(0.005, result.jitter, 1e-4);
+}
+
+/////////////////////////////////////////////////
+TEST(WindowStatsTest, Startup)
+{
+  WindowStats stats(1s, 10);
+  auto start = WindowStats::Clock::now();
+
+  // Before the window is full, the rate comes from the intervals
+  stats.Add(start, 10);
+  stats.Add(start + 100ms, 10);
+  auto result = stats.Stats(start + 150ms);
+  EXPECT_EQ(2u, result.count);
+  EXPECT_NEAR(10.0, result.rate, 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST(WindowStatsTest, Slide)
+{
+  WindowStats stats(1s, 10);
+  auto start = WindowStats::Clock::now();
+
+  for (int i = 0; i < 100; ++i)
+    stats.Add(start + std::chrono::milliseconds(i * 10), 10);
+
+  // Messages leave the window
+  auto result = stats.Stats(start + 5s);
+  EXPECT_EQ(0u, result.count);
+  EXPECT_DOUBLE_EQ(0.0, result.rate);
+
+  // Buckets are reused
+  stats.Add(start + 5s, 20);
+  result = stats.Stats(start + 5s);
+  EXPECT_EQ(1u, result.count);
+  EXPECT_EQ(20u, result.minSize);
+
+  stats.Reset();
+  result = stats.Stats(start + 5s);
+  EXPECT_EQ(0u, result.count);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <unordered_set>
+#include <vector>
+
+#include <ignition/transport/Publisher.hh>
+
+#include "TopicList.hh"
+
+using namespace ignition;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+void TopicList::Update(transport::Node &_node, const AddedCallback &_added,
+    const RemovedCallback &_removed)
+{
+  std::vector<std::string> topics;
+  _node.TopicList(topics);
+
+  // Topics which are gone
+  std::unordered_set<std::string> topicSet(topics.begin(), topics.end());
+  for (auto it = this->types.begin(); it != this->types.end();)
+  {
+    if (topicSet.count(it->first))
+    {
+      ++it;
+      continue;
+    }
+
+    _removed(it->first);
+    it = this->types.erase(it);
+  }
+
+  // New topics, and now and then topics re-advertised with another type
+  bool checkTypes = ++this->updateCount % kTypeCheckPeriod == 0;
+  for (const auto &topic : topics)
+  {
+    auto it = this->types.find(topic);
+    if (it != this->types.end() && !checkTypes)
+      continue;
+
+    std::vector<transport::MessagePublisher> publishers;
+    _node.TopicInfo(topic, publishers);
+    if (publishers.empty())
+      continue;
+
+    const auto &type = publishers[0].MsgTypeName();
+    if (it != this->types.end())
+    {
+      if (it->second == type)
+        continue;
+
+      _removed(topic);
+      it->second = type;
+    }
+    else
+    {
+      this->types[topic] = type;
+    }
+
+    _added(topic, type);
+  }
+}
+
+/////////////////////////////////////////////////
+const std::unordered_map<std::string, std::string> &TopicList::Types() const
+{
+  return this->types;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_PLUGINS_TOPICLIST_HH_
+#define IGNITION_GUI_PLUGINS_TOPICLIST_HH_
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include <ignition/transport/Node.hh>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Topics known to a transport node and their message types,
+  /// reporting only what changed since the last update. Used by the
+  /// TopicViewer and TopicStats plugins to keep their models in sync with
+  /// the network without rebuilding them.
+  class TopicList
+  {
+    /// \brief Called with a topic and its message type.
+    public: using AddedCallback = std::function<void(const std::string &,
+        const std::string &)>;
+
+    /// \brief Called with a topic name.
+    public: using RemovedCallback = std::function<void(const std::string &)>;
+
+    /// \brief Number of updates between checks of the message types of
+    /// known topics.
+    public: static constexpr unsigned int kTypeCheckPeriod{10};
+
+    /// \brief Update the list from the node's discovery information, which
+    /// is a local copy and doesn't query the network. Message types are
+    /// looked up for new topics only, and topics without publishers yet are
+    /// picked up by later updates. Every kTypeCheckPeriod updates, the types
+    /// of all known topics are checked too.
+    /// \param[in] _node Node to query.
+    /// \param[in] _added Called for each new topic. It's also called for
+    /// topics re-advertised with a different message type, after _removed,
+    /// once their type is checked.
+    /// \param[in] _removed Called for each topic which is gone, or whose
+    /// message type changed.
+    public: void Update(transport::Node &_node, const AddedCallback &_added,
+        const RemovedCallback &_removed);
+
+    /// \brief Message type of each known topic.
+    /// \return Types by topic name.
+    public: const std::unordered_map<std::string, std::string> &Types() const;
+
+    /// \brief Message type of each known topic.
+    private: std::unordered_map<std::string, std::string> types;
+
+    /// \brief Number of updates so far.
+    private: unsigned int updateCount{0};
+  };
+}
+}
+}
+
+#endif
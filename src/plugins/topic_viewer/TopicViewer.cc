@@ -20,8 +20,10 @@
 #include <QString>
 
 #include <deque>
+#include <functional>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <ignition/gui/Application.hh>
@@ -32,6 +34,7 @@
 
 #include <ignition/common/Console.hh>
 #include <ignition/plugin/Register.hh>
+#include "TopicList.hh"
 #include "TopicViewer.hh"
 
 #define NAME_KEY "name"
@@ -45,6 +48,7 @@
 #define TOPIC_ROLE 53
 #define PATH_ROLE 54
 #define PLOT_ROLE 55
+#define MSG_TYPE_ROLE 56
 
 namespace ignition
 {
@@ -68,8 +72,55 @@ namespace plugins
       roles[PLOT_ROLE] = PLOT_KEY;
       return roles;
     }
+
+    /// \brief Msg items have children even before they're fetched
+    public: bool hasChildren(const QModelIndex &_parent = QModelIndex()) const
+        override
+    {
+      return this->canFetchMore(_parent) ||
+          QStandardItemModel::hasChildren(_parent);
+    }
+
+    /// \brief Msg items whose fields haven't been added yet keep their msg
+    /// type in MSG_TYPE_ROLE
+    public: bool canFetchMore(const QModelIndex &_parent) const override
+    {
+      return _parent.isValid() &&
+          !_parent.data(MSG_TYPE_ROLE).toString().isEmpty();
+    }
+
+    /// \brief Add the fields of a msg item, called by views when the item
+    /// is expanded
+    public: void fetchMore(const QModelIndex &_parent) override
+    {
+      auto item = this->itemFromIndex(_parent);
+      if (item && this->fetchFields)
+        this->fetchFields(item);
+    }
+
+    /// \brief Function which adds the fields of a msg item
+    public: std::function<void(QStandardItem *)> fetchFields;
   };
 
+  /// \brief A field of a msg
+  struct SchemaField
+  {
+    /// \brief Field name
+    std::string name;
+
+    /// \brief Field type name
+    std::string type;
+
+    /// \brief Descriptor of msg fields, null for other fields
+    const google::protobuf::Descriptor *msg{nullptr};
+
+    /// \brief True if the field can be plotted
+    bool plottable{false};
+  };
+
+  /// \brief Fields of a msg type which are displayed
+  using Schema = std::vector<SchemaField>;
+
   class TopicViewerPrivate
   {
     /// \brief Node for Commincation
@@ -81,8 +132,16 @@ namespace plugins
     /// \brief Timer to update the model and keep track of its changes
     public: QTimer *timer;
 
-    /// \brief topic: msgType map to keep track of the model current topics
-    public: std::map<std::string, std::string> currentTopics;
+    /// \brief Top level item of each topic in the model, for constant time
+    /// lookup by topic name.
+    public: std::unordered_map<std::string, QStandardItem *> topicItems;
+
+    /// \brief Topics and msg types at the last update.
+    public: TopicList topicList;
+
+    /// \brief Remove a topic from the model.
+    /// \param[in] _topic topic name
+    public: void RemoveTopic(const std::string &_topic);
 
     /// \brief Create the fields model
     public: void CreateModel();
@@ -93,13 +152,25 @@ namespace plugins
     public: void AddTopic(const std::string &_topic,
                          const std::string &_msg);
 
-    /// \brief add a field/msg child to that parent item
-    /// \param[in] _parentItem a parent for the added field/msg
-    /// \param[in] _msgName the displayed name of the field/msg
-    /// \param[in] _msgType field/msg type
-    public: void AddField(QStandardItem *_parentItem,
-                       const std::string &_msgName,
-                       const std::string &_msgType);
+    /// \brief add the field/msg children of a msg item, the first time it's
+    /// expanded
+    /// \param[in] _msgItem the msg item, its MSG_TYPE_ROLE is cleared
+    public: void FetchFields(QStandardItem *_msgItem);
+
+    /// \brief get the schema of a msg type, creating it the first time the
+    /// type is seen
+    /// \param[in] _msgType msg type
+    /// \return the schema, empty if the type isn't known
+    public: const Schema &FindSchema(const std::string &_msgType);
+
+    /// \brief schemas by msg type, shared by all topics and fields of that
+    /// type
+    public: std::unordered_map<std::string, Schema> schemas;
+
+    /// \brief descriptors of nested msg types by name, so that their
+    /// schema can be created without instantiating a msg
+    public: std::unordered_map<std::string,
+        const google::protobuf::Descriptor *> descriptors;
 
     /// \brief factory method for creating an item
     /// \param[in] _name the display name
@@ -162,13 +233,13 @@ TopicViewer::TopicViewer() : Plugin(), dataPtr(new TopicViewerPrivate)
   this->dataPtr->plotableTypes.push_back(FieldDescriptor::Type::TYPE_BOOL);
 
   this->dataPtr->CreateModel();
+  this->UpdateModel();
 
   ignition::gui::App()->Engine()->rootContext()->setContextProperty(
                 "TopicsModel", this->dataPtr->model);
 
   this->dataPtr->timer = new QTimer();
   connect(this->dataPtr->timer, SIGNAL(timeout()), this, SLOT(UpdateModel()));
-  this->dataPtr->timer->start(1000);
 }
 
 //////////////////////////////////////////////////
@@ -181,6 +252,23 @@ void TopicViewer::LoadConfig(const tinyxml2::XMLElement *)
 {
   if (this->title.empty())
     this->title = "Topic Viewer";
+
+  // Only start once loaded, which lazy plugins defer until they're shown
+  this->dataPtr->timer->start(1000);
+}
+
+//////////////////////////////////////////////////
+void TopicViewer::OnActivate()
+{
+  this->UpdateModel();
+  this->dataPtr->timer->start(1000);
+}
+
+//////////////////////////////////////////////////
+void TopicViewer::OnDeactivate()
+{
+  // The topic list is only refreshed while shown
+  this->dataPtr->timer->stop();
 }
 
 //////////////////////////////////////////////////
@@ -193,17 +281,10 @@ QStandardItemModel *TopicViewer::Model()
 void TopicViewerPrivate::CreateModel()
 {
   this->model = new TopicsModel();
-
-  std::vector<std::string> topics;
-  this->node.TopicList(topics);
-
-  for (unsigned int i = 0; i < topics.size(); ++i)
+  this->model->fetchFields = [this](QStandardItem *_item)
   {
-    std::vector<ignition::transport::MessagePublisher> infoMsgs;
-    this->node.TopicInfo(topics[i], infoMsgs);
-    std::string msgType = infoMsgs[0].MsgTypeName();
-    this->AddTopic(topics[i], msgType);
-  }
+    this->FetchFields(_item);
+  };
 }
 
 //////////////////////////////////////////////////
@@ -211,48 +292,105 @@ void TopicViewerPrivate::AddTopic(const std::string &_topic,
                            const std::string &_msg)
 {
   QStandardItem *topicItem = this->FactoryItem(_topic, _msg);
-  topicItem->setWhatsThis("Topic");
+
+  // the fields are added when the topic is expanded
+  topicItem->setData(QVariant(QString::fromStdString(_msg)), MSG_TYPE_ROLE);
+
   QStandardItem *parent = this->model->invisibleRootItem();
   parent->appendRow(topicItem);
 
-  this->AddField(topicItem , _msg, _msg);
-
   // store the topics to keep track of them
-  this->currentTopics[_topic] = _msg;
+  this->topicItems[_topic] = topicItem;
+}
+
+//////////////////////////////////////////////////
+void TopicViewerPrivate::RemoveTopic(const std::string &_topic)
+{
+  auto it = this->topicItems.find(_topic);
+  if (it == this->topicItems.end())
+    return;
+
+  this->model->invisibleRootItem()->removeRow(it->second->row());
+  this->topicItems.erase(it);
 }
 
 //////////////////////////////////////////////////
-void TopicViewerPrivate::AddField(QStandardItem *_parentItem,
-                           const std::string &_msgName,
-                           const std::string &_msgType)
+void TopicViewerPrivate::FetchFields(QStandardItem *_msgItem)
 {
-  QStandardItem *msgItem;
+  std::string msgType =
+      _msgItem->data(MSG_TYPE_ROLE).toString().toStdString();
 
-  // check if it is a topic, to skip the extra level of the topic Msg
-  if (_parentItem->whatsThis() == "Topic")
+  // only fetch once
+  _msgItem->setData(QVariant(), MSG_TYPE_ROLE);
+
+  const auto &schema = this->FindSchema(msgType);
+
+  QList<QStandardItem *> items;
+  for (const auto &field : schema)
   {
-    msgItem = _parentItem;
-    // make it different, so next iteration will make a new msg item
-    msgItem->setWhatsThis("Msg");
+    auto item = this->FactoryItem(field.name, field.type);
+
+    if (field.msg)
+    {
+      item->setData(QVariant(QString::fromStdString(field.msg->full_name())),
+          MSG_TYPE_ROLE);
+      this->descriptors[field.msg->full_name()] = field.msg;
+    }
+    // to make the plottable items draggable
+    else if (field.plottable)
+    {
+      item->setData(QVariant(true), PLOT_ROLE);
+    }
+
+    items.append(item);
   }
-  else
+
+  if (items.empty())
+    return;
+
+  _msgItem->appendRows(items);
+
+  for (auto item : items)
   {
-    msgItem = this->FactoryItem(_msgName, _msgType);
-    _parentItem->appendRow(msgItem);
+    if (item->data(MSG_TYPE_ROLE).toString().isEmpty())
+    {
+      this->SetItemPath(item);
+      this->SetItemTopic(item);
+    }
   }
+}
 
-  auto msg = ignition::msgs::Factory::New(_msgType);
-  if (!msg)
+//////////////////////////////////////////////////
+const Schema &TopicViewerPrivate::FindSchema(const std::string &_msgType)
+{
+  auto it = this->schemas.find(_msgType);
+  if (it != this->schemas.end())
+    return it->second;
+
+  // unknown types get an empty schema, so they're only reported once
+  auto &schema = this->schemas[_msgType];
+
+  const google::protobuf::Descriptor *msgDescriptor{nullptr};
+  auto descIt = this->descriptors.find(_msgType);
+  if (descIt != this->descriptors.end())
+  {
+    msgDescriptor = descIt->second;
+  }
+  else
   {
+    auto msg = ignition::msgs::Factory::New(_msgType);
+    if (!msg)
+    {
       ignwarn << "Null Msg: " << _msgType << std::endl;
-      return;
+      return schema;
+    }
+    msgDescriptor = msg->GetDescriptor();
   }
 
-  auto msgDescriptor = msg->GetDescriptor();
   if (!msgDescriptor)
   {
     ignwarn << "Null Descriptor of Msg: " << _msgType << std::endl;
-    return;
+    return schema;
   }
 
   for (int i = 0 ; i < msgDescriptor->field_count(); ++i)
@@ -262,25 +400,25 @@ void TopicViewerPrivate::AddField(QStandardItem *_parentItem,
     if (msgField->is_repeated())
       continue;
 
-    auto messageType = msgField->message_type();
+    SchemaField field;
+    field.name = msgField->name();
 
+    auto messageType = msgField->message_type();
     if (messageType)
-      this->AddField(msgItem, msgField->name(), messageType->name());
-
+    {
+      field.type = messageType->name();
+      field.msg = messageType;
+    }
     else
     {
-      auto msgFieldItem = this->FactoryItem(msgField->name(),
-                                            msgField->type_name());
-      msgItem->appendRow(msgFieldItem);
-
-      this->SetItemPath(msgFieldItem);
-      this->SetItemTopic(msgFieldItem);
-
-      // to make the plottable items draggable
-      if (this->IsPlotable(msgField->type()))
-        msgFieldItem->setData(QVariant(true), PLOT_ROLE);
+      field.type = msgField->type_name();
+      field.plottable = this->IsPlotable(msgField->type());
     }
+
+    schema.push_back(field);
   }
+
+  return schema;
 }
 
 //////////////////////////////////////////////////
@@ -372,58 +510,19 @@ bool TopicViewerPrivate::IsPlotable(
 /////////////////////////////////////////////////
 void TopicViewer::UpdateModel()
 {
-  // get the current topics in the network
-  std::vector<std::string> topics;
-  this->dataPtr->node.TopicList(topics);
-
-  // initialize the topics with the old topics & remove every matched topic
-  // when you finish advertised topics the remaining topics will be removed
-  std::map<std::string, std::string> topicsToRemove =
-          this->dataPtr->currentTopics;
-
-  for (unsigned int i = 0; i < topics.size(); ++i)
-  {
-    // get the msg type
-    std::vector<ignition::transport::MessagePublisher> infoMsgs;
-    this->dataPtr->node.TopicInfo(topics[i], infoMsgs);
-    std::string msgType = infoMsgs[0].MsgTypeName();
-
-    // skip the matched topics
-    if (this->dataPtr->currentTopics.count(topics[i]) &&
-            this->dataPtr->currentTopics[topics[i]] == msgType)
-    {
-      topicsToRemove.erase(topics[i]);
-      continue;
-    }
-
-    // new topic
-    this->dataPtr->AddTopic(topics[i], msgType);
-  }
-
-  // remove the topics that don't exist in the network
-  for (auto topic : topicsToRemove)
-  {
-    auto root = this->dataPtr->model->invisibleRootItem();
-
-    // search for the topic in the model
-    for (int i = 0; i < root->rowCount(); ++i)
-    {
-      auto child = root->child(i);
-
-      if (child->data(NAME_ROLE).toString().toStdString() == topic.first &&
-              child->data(TYPE_ROLE).toString().toStdString() == topic.second)
+  // only topics which are new, gone or whose msg type changed touch the
+  // model
+  this->dataPtr->topicList.Update(this->dataPtr->node,
+      [this](const std::string &_topic, const std::string &_msgType)
       {
-        // remove from model
-        root->removeRow(i);
-        // remove from topics as it is a dangling topic
-        this->dataPtr->currentTopics.erase(topic.first);
-        break;
-      }
-    }
-  }
+        this->dataPtr->AddTopic(_topic, _msgType);
+      },
+      [this](const std::string &_topic)
+      {
+        this->dataPtr->RemoveTopic(_topic);
+      });
 }
 
-
 // Register this plugin
 IGNITION_ADD_PLUGIN(ignition::gui::plugins::TopicViewer,
                     ignition::gui::Plugin)
@@ -52,11 +52,19 @@ namespace plugins
     /// \brief Documentaation inherited
     public: void LoadConfig(const tinyxml2::XMLElement *) override;
 
+    // Documentation inherited
+    protected: void OnActivate() override;
+
+    // Documentation inherited
+    protected: void OnDeactivate() override;
+
     /// \brief Get the model of msgs & fields
     /// \return Pointer to the model of msgs & fields
     public: QStandardItemModel *Model();
 
-    /// \brief update the model according to the changes of the topics
+    /// \brief update the model according to the changes of the topics.
+    /// Only topics which were added or removed since the last update are
+    /// processed.
     public slots: void UpdateModel();
 
     /// \brief Pointer to private data.
@@ -16,6 +16,9 @@
 */
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include <ignition/common/Console.hh>
 #include <ignition/transport/Node.hh>
 #include <ignition/utilities/ExtraTestMacros.hh>
@@ -24,6 +27,7 @@
 #include "ignition/gui/Application.hh"
 #include "ignition/gui/Plugin.hh"
 #include "ignition/gui/MainWindow.hh"
+#include "TopicList.hh"
 #include "TopicViewer.hh"
 
 #define NAME_ROLE 51
@@ -146,10 +150,19 @@ TEST(TopicViewerTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Model))
             foundCollision = true;
 
             EXPECT_EQ(child->data(TYPE_ROLE), "ignition.msgs.Collision");
+
+            // fields are only added when expanded
+            EXPECT_EQ(child->rowCount(), 0);
+            EXPECT_TRUE(model->hasChildren(child->index()));
+            ASSERT_TRUE(model->canFetchMore(child->index()));
+            model->fetchMore(child->index());
+            EXPECT_FALSE(model->canFetchMore(child->index()));
             EXPECT_EQ(child->rowCount(), 8);
 
             auto pose = child->child(5);
+            model->fetchMore(pose->index());
             auto position = pose->child(3);
+            model->fetchMore(position->index());
             auto x = position->child(1);
 
             EXPECT_EQ(x->data(NAME_ROLE), "x");
@@ -163,6 +176,7 @@ TEST(TopicViewerTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Model))
             foundInt = true;
 
             EXPECT_EQ(child->data(TYPE_ROLE), "ignition.msgs.Int32");
+            model->fetchMore(child->index());
             EXPECT_EQ(child->rowCount(), 2);
 
             auto data = child->child(1);
@@ -199,3 +213,68 @@ TEST(TopicViewerTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Model))
 
     EXPECT_EQ(root->rowCount(), 2);
 }
+
+/////////////////////////////////////////////////
+TEST(TopicViewerTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(TypeChange))
+{
+  setenv("IGN_PARTITION", "ign-gui-topic-viewer-test", 1);
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+  EXPECT_TRUE(app.LoadPlugin("TopicViewer"));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto plugins = win->findChildren<plugins::TopicViewer *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  // Rows of the topic, and their types
+  auto rows = [&plugin]()
+  {
+    std::vector<std::string> types;
+    auto root = plugin->Model()->invisibleRootItem();
+    for (int i = 0; i < root->rowCount(); ++i)
+    {
+      auto child = root->child(i);
+      if (child->data(NAME_ROLE) == "/type_topic")
+        types.push_back(child->data(TYPE_ROLE).toString().toStdString());
+    }
+    return types;
+  };
+
+  {
+    transport::Node node;
+    auto pub = node.Advertise<msgs::Int32>("/type_topic");
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    plugin->UpdateModel();
+    EXPECT_EQ(std::vector<std::string>({"ignition.msgs.Int32"}), rows());
+  }
+
+  // Re-advertised with another type before the next update, so the topic
+  // list itself doesn't change. Types of known topics are checked
+  // periodically.
+  transport::Node node;
+  auto pub = node.Advertise<msgs::StringMsg>("/type_topic");
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  for (unsigned int i = 0; i < plugins::TopicList::kTypeCheckPeriod; ++i)
+    plugin->UpdateModel();
+  EXPECT_EQ(std::vector<std::string>({"ignition.msgs.StringMsg"}), rows());
+
+  // The new type's fields are shown
+  auto root = plugin->Model()->invisibleRootItem();
+  for (int i = 0; i < root->rowCount(); ++i)
+  {
+    auto child = root->child(i);
+    if (child->data(NAME_ROLE) != "/type_topic")
+      continue;
+
+    plugin->Model()->fetchMore(child->index());
+    ASSERT_EQ(child->rowCount(), 2);
+    EXPECT_EQ(child->child(1)->data(NAME_ROLE), "data");
+    EXPECT_EQ(child->child(1)->data(TYPE_ROLE), "string");
+  }
+}
@@ -165,6 +165,9 @@ class ignition::gui::plugins::TransportSceneManagerPrivate
   /// \brief Transport node for making service request and subscribing to
   /// pose topic
   public: ignition::transport::Node node;
+
+  /// \brief Plugin which owns this, used to record handler statistics
+  public: Plugin *plugin{nullptr};
 };
 
 using namespace ignition;
@@ -175,6 +178,7 @@ using namespace plugins;
 TransportSceneManager::TransportSceneManager()
   : Plugin(), dataPtr(new TransportSceneManagerPrivate)
 {
+  this->dataPtr->plugin = this;
 }
 
 /////////////////////////////////////////////////
@@ -216,7 +220,8 @@ void TransportSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     }
   }
 
-  App()->findChild<MainWindow *>()->installEventFilter(this);
+  this->AddRenderHook(RenderPhase::kRender, "TransportSceneManager::OnRender",
+      [this]() {this->dataPtr->OnRender();});
 }
 
 /////////////////////////////////////////////////
@@ -263,18 +268,6 @@ void TransportSceneManagerPrivate::InitializeTransport()
   ignmsg << "Transport initialized." << std::endl;
 }
 
-/////////////////////////////////////////////////
-bool TransportSceneManager::eventFilter(QObject *_obj, QEvent *_event)
-{
-  if (_event->type() == events::Render::kType)
-  {
-    this->dataPtr->OnRender();
-  }
-
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
-}
-
 /////////////////////////////////////////////////
 void TransportSceneManagerPrivate::Request()
 {
@@ -301,6 +294,7 @@ void TransportSceneManagerPrivate::Request()
 /////////////////////////////////////////////////
 void TransportSceneManagerPrivate::OnPoseVMsg(const msgs::Pose_V &_msg)
 {
+  IGN_GUI_PROFILE_HANDLER(this->plugin, "TransportSceneManager::OnPoseVMsg");
   std::lock_guard<std::mutex> lock(this->msgMutex);
   for (int i = 0; i < _msg.pose_size(); ++i)
   {
@@ -320,6 +314,8 @@ void TransportSceneManagerPrivate::OnPoseVMsg(const msgs::Pose_V &_msg)
 /////////////////////////////////////////////////
 void TransportSceneManagerPrivate::OnDeletionMsg(const msgs::UInt32_V &_msg)
 {
+  IGN_GUI_PROFILE_HANDLER(this->plugin,
+      "TransportSceneManager::OnDeletionMsg");
   std::lock_guard<std::mutex> lock(this->msgMutex);
   std::copy(_msg.data().begin(), _msg.data().end(),
             std::back_inserter(this->toDeleteEntities));
@@ -338,6 +334,10 @@ void TransportSceneManagerPrivate::OnRender()
   }
 
   std::lock_guard<std::mutex> lock(this->msgMutex);
+  this->plugin->RecordQueueDepth("Scene messages", this->sceneMsgs.size());
+  this->plugin->RecordQueueDepth("Entities to delete",
+      this->toDeleteEntities.size());
+  this->plugin->RecordQueueDepth("Poses", this->poses.size());
 
   for (const auto &msg : this->sceneMsgs)
   {
@@ -398,6 +398,7 @@ void TransportSceneManagerPrivate::OnRender()
 /////////////////////////////////////////////////
 void TransportSceneManagerPrivate::OnSceneMsg(const msgs::Scene &_msg)
 {
+  IGN_GUI_PROFILE_HANDLER(this->plugin, "TransportSceneManager::OnSceneMsg");
   std::lock_guard<std::mutex> lock(this->msgMutex);
   this->sceneMsgs.push_back(_msg);
 }
@@ -42,6 +42,9 @@ namespace plugins
     /// \brief Communication node
     public: ignition::transport::Node node;
 
+    /// \brief Statistics topic, kept to resubscribe when activated.
+    public: std::string topic;
+
     /// \brief Holds real time factor
     public: QString realTimeFactor;
 
@@ -143,6 +146,7 @@ void WorldStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
   }
 
   ignmsg << "Listening to stats on [" << topic << "]" << std::endl;
+  this->dataPtr->topic = topic;
 
   // Sim time
   if (auto simTimeElem = _pluginElem->FirstChildElement("sim_time"))
@@ -187,6 +191,28 @@ void WorldStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
   }
 }
 
+/////////////////////////////////////////////////
+void WorldStats::OnActivate()
+{
+  if (this->dataPtr->topic.empty())
+    return;
+
+  if (!this->dataPtr->node.Subscribe(this->dataPtr->topic,
+      &WorldStats::OnWorldStatsMsg, this))
+  {
+    ignerr << "Failed to subscribe to [" << this->dataPtr->topic << "]"
+           << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+void WorldStats::OnDeactivate()
+{
+  // Stats are only received while displayed
+  for (const auto &sub : this->dataPtr->node.SubscribedTopics())
+    this->dataPtr->node.Unsubscribe(sub);
+}
+
 /////////////////////////////////////////////////
 void WorldStats::ProcessMsg()
 {
@@ -110,6 +110,12 @@ namespace plugins
     // Documentation inherited
     public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem);
 
+    // Documentation inherited
+    protected: void OnActivate() override;
+
+    // Documentation inherited
+    protected: void OnDeactivate() override;
+
     /// \brief Callback in main thread when diagnostics come in
     public slots: void ProcessMsg();
 
@@ -25,7 +25,9 @@
 #endif
 
 #include <gtest/gtest.h>
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Filesystem.hh>
@@ -217,6 +219,95 @@ TEST_F(MarkerManagerTestFixture,
     FAIL();
   }
 
+  // Packed markers
+  auto packedPub = node.Advertise<ignition::msgs::PointCloudPacked>(
+      "/marker/packed");
+
+  ignition::msgs::PointCloudPacked packedMsg;
+  auto addHeader = [&](const std::string &_key, const std::string &_value)
+  {
+    auto data = packedMsg.mutable_header()->add_data();
+    data->set_key(_key);
+    data->add_value(_value);
+  };
+  addHeader("ns", "packed");
+  addHeader("id", "1");
+  addHeader("size", "5");
+  const std::vector<std::string> fieldNames{"x", "y", "z", "r", "g", "b", "a"};
+  for (unsigned int i = 0; i < fieldNames.size(); ++i)
+  {
+    auto field = packedMsg.add_field();
+    field->set_name(fieldNames[i]);
+    field->set_offset(i * sizeof(float));
+    field->set_datatype(ignition::msgs::PointCloudPacked::Field::FLOAT32);
+    field->set_count(1);
+  }
+  packedMsg.set_point_step(fieldNames.size() * sizeof(float));
+
+  const unsigned int pointCount = 1000;
+  std::vector<float> points;
+  for (unsigned int i = 0; i < pointCount; ++i)
+  {
+    points.insert(points.end(),
+        {static_cast<float>(i), 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f});
+  }
+  packedMsg.set_width(pointCount);
+  packedMsg.set_height(1);
+  packedMsg.set_row_step(packedMsg.point_step() * pointCount);
+  packedMsg.set_data(std::string(reinterpret_cast<char *>(points.data()),
+      points.size() * sizeof(float)));
+
+  EXPECT_TRUE(packedPub.Publish(packedMsg));
+  waitAndSendStatsMsgs(timePoint, 1, 200);
+  EXPECT_EQ(1u, scene->VisualCount());
+
+  ignition::msgs::PointCloudPacked deleteMsg = packedMsg;
+  deleteMsg.clear_data();
+  auto deleteData = deleteMsg.mutable_header()->add_data();
+  deleteData->set_key("action");
+  deleteData->add_value("delete_all");
+  EXPECT_TRUE(packedPub.Publish(deleteMsg));
+  waitAndSendStatsMsgs(timePoint, 0, 200);
+  EXPECT_EQ(0u, scene->VisualCount());
+
+  // Sizes whose product with the point step wraps around to 0 are rejected
+  ignition::msgs::PointCloudPacked hugeMsg = packedMsg;
+  hugeMsg.set_width(1u << 31);
+  hugeMsg.set_height(1u << 31);
+  hugeMsg.clear_data();
+  EXPECT_TRUE(packedPub.Publish(hugeMsg));
+  waitAndSendStatsMsgs(timePoint, 1, 10);
+  EXPECT_EQ(0u, scene->VisualCount());
+
+  // Points on shared memory
+  const std::string shmKey = "ign-gui-marker-manager-test";
+  QSharedMemory shm(QString::fromStdString(shmKey));
+  ASSERT_TRUE(shm.create(static_cast<int>(points.size() * sizeof(float))));
+  shm.lock();
+  std::memcpy(shm.data(), points.data(), points.size() * sizeof(float));
+  shm.unlock();
+
+  ignition::msgs::PointCloudPacked shmMsg = packedMsg;
+  shmMsg.clear_data();
+  auto shmData = shmMsg.mutable_header()->add_data();
+  shmData->set_key("shm_key");
+  shmData->add_value(shmKey);
+  EXPECT_TRUE(packedPub.Publish(shmMsg));
+  waitAndSendStatsMsgs(timePoint, 1, 200);
+  EXPECT_EQ(1u, scene->VisualCount());
+
+  // Shared memory smaller than the points is rejected. The header's second
+  // entry is the id, a new one would add a visual.
+  shmMsg.mutable_header()->mutable_data(1)->set_value(0, "2");
+  shmMsg.set_width(pointCount + 1);
+  EXPECT_TRUE(packedPub.Publish(shmMsg));
+  waitAndSendStatsMsgs(timePoint, 2, 10);
+  EXPECT_EQ(1u, scene->VisualCount());
+
+  EXPECT_TRUE(packedPub.Publish(deleteMsg));
+  waitAndSendStatsMsgs(timePoint, 0, 200);
+  EXPECT_EQ(0u, scene->VisualCount());
+
   // Cleanup
   plugins.clear();
 }
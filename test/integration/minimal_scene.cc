@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <QtTest/QtTest>
 #include <ignition/common/Console.hh>
 #include <ignition/math/Color.hh>
@@ -32,6 +33,7 @@
 #include "ignition/gui/GuiEvents.hh"
 #include "ignition/gui/Plugin.hh"
 #include "ignition/gui/MainWindow.hh"
+#include "ignition/gui/RenderHooks.hh"
 
 int g_argc = 1;
 char **g_argv = new char *[g_argc];
@@ -116,6 +118,14 @@ TEST(MinimalSceneTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Config))
     }
   };
 
+  // Hooks are called from the render thread
+  std::atomic<bool> calledPreRenderHook{false};
+  std::atomic<bool> calledRenderHook{false};
+  auto preRenderHook = addRenderHook(RenderPhase::kPreRender,
+      "test::PreRender", [&]() {calledPreRenderHook = true;});
+  auto renderHook = addRenderHook(RenderPhase::kRender, "test::Render",
+      [&]() {calledRenderHook = true;});
+
   // Check scene
   auto engine = rendering::engine("ogre");
   ASSERT_NE(nullptr, engine);
@@ -131,6 +141,11 @@ TEST(MinimalSceneTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Config))
   EXPECT_TRUE(receivedPreRenderEvent);
   EXPECT_TRUE(receivedRenderEvent);
 
+  EXPECT_TRUE(removeRenderHook(preRenderHook));
+  EXPECT_TRUE(removeRenderHook(renderHook));
+  EXPECT_TRUE(calledPreRenderHook);
+  EXPECT_TRUE(calledRenderHook);
+
   EXPECT_EQ(1u, engine->SceneCount());
   auto scene = engine->SceneByName("banana");
   ASSERT_NE(nullptr, scene);
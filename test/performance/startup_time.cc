@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/MainWindow.hh"
+#include "ignition/gui/Plugin.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./startup_time")),
+};
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Write a config with a couple of instances of each plugin which
+/// doesn't need a 3D scene.
+/// \param[in] _path Path to write to.
+/// \param[in] _title Title given to all plugins.
+/// \return Number of plugins in the config.
+int WriteSyntheticConfig(const std::string &_path, const std::string &_title)
+{
+  const std::vector<std::string> filenames{
+    "ImageDisplay",
+    "KeyPublisher",
+    "PluginStats",
+    "Publisher",
+    "Recorder",
+    "Teleop",
+    "TopicEcho",
+    "TopicStats",
+    "TopicViewer",
+    "TransportPlotting",
+    "WorldControl",
+    "WorldStats",
+  };
+  const int copies{2};
+
+  std::ofstream config(_path);
+  config << "<?xml version=\"1.0\"?>\n";
+  for (int i = 0; i < copies; ++i)
+  {
+    for (const auto &filename : filenames)
+    {
+      config << "<plugin filename=\"" << filename << "\">"
+             << "<ignition-gui><title>" << _title << "</title></ignition-gui>"
+             << "</plugin>\n";
+    }
+  }
+
+  return static_cast<int>(filenames.size()) * copies;
+}
+
+/////////////////////////////////////////////////
+TEST(StartupTime, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadConfig))
+{
+  common::Console::SetVerbosity(1);
+
+  // Headless, so it runs without a display or GPU
+  Application app(g_argc, g_argv, WindowType::kHeadless);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const std::string configPath{"/tmp/startup_time.config"};
+  auto pluginCount = WriteSyntheticConfig(configPath, "First");
+  const std::string otherConfigPath{"/tmp/startup_time_other.config"};
+  WriteSyntheticConfig(otherConfigPath, "Second");
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // The first load finds and loads all libraries, which happens concurrently
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(app.LoadConfig(configPath));
+  auto cold = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(pluginCount, win->findChildren<Plugin *>().size());
+
+  // All plugins are kept when loading the same config again
+  start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(app.LoadConfig(configPath));
+  auto reload = std::chrono::steady_clock::now() - start;
+
+  // All plugins are replaced when switching to a config where they're
+  // configured differently. Libraries and QML components stay loaded, so this
+  // only instantiates plugins.
+  start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(app.LoadConfig(otherConfigPath));
+  auto change = std::chrono::steady_clock::now() - start;
+
+  // Frames with all plugins loaded
+  const int frames{30};
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < frames; ++i)
+    EXPECT_TRUE(app.RenderFrame());
+  auto frame = (std::chrono::steady_clock::now() - start) / frames;
+
+  using Ms = std::chrono::duration<double, std::milli>;
+  std::cout << "Loaded " << pluginCount << " plugins" << std::endl
+            << "  cold start:     " << Ms(cold).count() << " ms" << std::endl
+            << "  same config:    " << Ms(reload).count() << " ms" << std::endl
+            << "  changed config: " << Ms(change).count() << " ms"
+            << std::endl
+            << "  frame:          " << Ms(frame).count() << " ms"
+            << std::endl;
+}